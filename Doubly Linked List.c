@@ -1,443 +1,377 @@
-#include <stdio.h>
-#include <stdlib.h>
-
-/**
- * @file Double Linked List.c
- */
-
-/**
- --> Creating the Node of a doubly linked list
- *
- * @struct node
- * @description
- * This structure represents a single node in a doubly linked list.
- * Each node stores:
- * - `data`: An integer value that holds the data for the node.
- * - `prev`: A pointer to the previous node in the linked list.
- * - `next`: A pointer to the next node in the linked list.
- */
-struct node {
-    int data;
-    struct node* prev;
-    struct node* next;
-};
-
-/**
- --> Traversing a Doubly Linked List
- *
- * @function count_of_nodes
- * @description
- * This function counts the number of nodes in a doubly linked list.
- * It starts from the head node and traverses the list, incrementing
- * a counter for each node. If the list is empty (head is NULL),
- * it prints a message indicating that the list is empty. After
- * traversing the list, the function prints the total number of nodes.
- *
- * @param head: A pointer to the head node of the linked list.
- */
-void count_of_nodes(struct node* head) {
-    int count = 0;
-    struct node* temp = head;
-
-    while (temp != NULL) {
-        count++;
-        temp = temp->next;
-    }
-
-    printf("Number of nodes: %d\n", count);
-}
-
-/**
- * @function print_data
- * @description
- * This function prints the data stored in each node of a doubly linked list.
- * It starts from the head node and traverses the list, printing the `data`
- * field of each node. If the list is empty (head is NULL), it prints a
- * message indicating that the list is empty. The function then moves to
- * the next node by following the `next` pointer until it reaches the end of the list.
- *
- * @param head: A pointer to the head node of the linked list.
- */
-void print_data(struct node* head) {
-    if (head == NULL) {
-        printf("The list is empty.\n");
-        return;
-    }
-    struct node* temp = head;
-     printf("List data: \n");
-    while (temp != NULL) {
-        printf("%d ", temp->data);
-        temp = temp->next;
-    }
-    printf("\n");
-}
-
-/**
- --> Insertion at the Beginning of the List
- *
- * @function add_beg
- * @description
- * This function inserts a new node at the beginning of a doubly linked list.
- * The new node is created dynamically with the specified data, and it is
- * linked as the first node in the list by updating the `next` pointer of
- * the new node and the `prev` pointer of the original head node.
- *
- * @param head: A double pointer to the head node of the linked list.
- * @param data: The integer value to be stored in the new node.
- */
-void add_beg(struct node** head, int data) {
-    struct node* new_node = (struct node*)malloc(sizeof(struct node));
-
-    new_node->data = data;
-    new_node->prev = NULL;
-    new_node->next = *head;
-
-    if (*head != NULL) {
-        (*head)->prev = new_node;
-    }
-
-    *head = new_node;
-}
-
-/**
- --> Insertion at the End of the List
- *
- * @function add_at_end
- * @description
- * This function inserts a new node at the end of a doubly linked list.
- * It traverses the list to the last node and updates the `next` pointer
- * of the last node and the `prev` pointer of the new node to insert it
- * at the end.
- *
- * @param head: A double pointer to the head node of the linked list.
- * @param data: The integer value to be stored in the new node.
- */
-void add_at_end(struct node** head, int data) {
-    struct node* new_node = (struct node*)malloc(sizeof(struct node));
-    struct node* temp = *head;
-
-    new_node->data = data;
-    new_node->next = NULL;
-
-    if (*head == NULL) {
-        new_node->prev = NULL;
-        *head = new_node;
-        return;
-    }
-
-    while (temp->next != NULL) {
-        temp = temp->next;
-    }
-
-    temp->next = new_node;
-    new_node->prev = temp;
-}
-
-/**
- --> Insertion at Any Position of the List
- *
- * @function insert_at_position
- * @description
- * This function inserts a new node at a specific position in a doubly linked list.
- * It traverses the list to find the correct position, then adjusts the `next` and
- * `prev` pointers of the relevant nodes to insert the new node.
- *
- * @param head: A double pointer to the head node of the linked list.
- * @param data: The integer value to be stored in the new node.
- * @param position: The position at which to insert the new node (1-based index).
- */
-void insert_at_position(struct node** head, int data, int position) {
-    struct node* new_node = (struct node*)malloc(sizeof(struct node));
-    struct node* temp = *head;
-
-    new_node->data = data;
-
-    if (position == 1) {
-        new_node->prev = NULL;
-        new_node->next = *head;
-        if (*head != NULL) {
-            (*head)->prev = new_node;
-        }
-        *head = new_node;
-        return;
-    }
-
-    for (int i = 1; i < position - 1 && temp != NULL; i++) {
-        temp = temp->next;
-    }
-
-    if (temp == NULL) {
-        printf("Invalid position\n");
-        free(new_node);
-        return;
-    }
-
-    new_node->next = temp->next;
-    new_node->prev = temp;
-
-    if (temp->next != NULL) {
-        temp->next->prev = new_node;
-    }
-
-    temp->next = new_node;
-}
-
-void delete_by_value(struct node** head, int value) {
-    if (*head == NULL) {
-        printf("List is empty\n");
-        return;
-    }
-
-    struct node* temp = *head;
-
-    // Check if the head node itself holds the value
-    if (temp->data == value) {
-        *head = temp->next;
-        if (*head != NULL) {
-            (*head)->prev = NULL;
-        }
-        free(temp);
-        return;
-    }
-
-    // Traverse the list to find the node with the value
-    while (temp != NULL && temp->data != value) {
-        temp = temp->next;
-    }
-
-    // If value was not found
-    if (temp == NULL) {
-        printf("Value not found in the list\n");
-        return;
-    }
-
-    // Adjust pointers to delete the node
-    if (temp->next != NULL) {
-        temp->next->prev = temp->prev;
-    }
-    if (temp->prev != NULL) {
-        temp->prev->next = temp->next;
-    }
-    free(temp);
-}
-
-
-/**
- --> Deletion at the Beginning of the List
- *
- * @function delete_beg
- * @description
- * This function deletes the first node of a doubly linked list.
- * It updates the `next` pointer of the head node and the `prev` pointer
- * of the second node (if it exists) to remove the first node.
- *
- * @param head: A double pointer to the head node of the linked list.
- */
-void delete_beg(struct node** head) {
-    if (*head == NULL) {
-        printf("List is empty\n");
-        return;
-    }
-
-    struct node* temp = *head;
-    *head = (*head)->next;
-
-    if (*head != NULL) {
-        (*head)->prev = NULL;
-    }
-
-    free(temp);
-}
-
-/**
- --> Deletion at the End of the List
- *
- * @function delete_end
- * @description
- * This function deletes the last node of a doubly linked list.
- * It traverses to the last node and updates the `next` pointer of
- * the second-to-last node to remove the last node.
- *
- * @param head: A double pointer to the head node of the linked list.
- */
-void delete_end(struct node** head) {
-    if (*head == NULL) {
-        printf("List is empty\n");
-        return;
-    }
-
-    struct node* temp = *head;
-
-    if (temp->next == NULL) {
-        *head = NULL;
-        free(temp);
-        return;
-    }
-
-    while (temp->next != NULL) {
-        temp = temp->next;
-    }
-
-    temp->prev->next = NULL;
-    free(temp);
-}
-
-/**
- --> Deletion at a Specific Position
- *
- * @function delete_at_position
- * @description
- * This function deletes a node at a specific position in a doubly linked list.
- * It adjusts the `next` and `prev` pointers of the neighboring nodes to remove
- * the specified node.
- *
- * @param head: A double pointer to the head node of the linked list.
- * @param position: The position of the node to delete (1-based index).
- */
-void delete_at_position(struct node** head, int position) {
-    if (*head == NULL) {
-        printf("List is empty\n");
-        return;
-    }
-
-    struct node* temp = *head;
-
-    if (position == 1) {
-        *head = temp->next;
-        if (*head != NULL) {
-            (*head)->prev = NULL;
-        }
-        free(temp);
-        return;
-    }
-
-    for (int i = 1; i < position && temp != NULL; i++) {
-        temp = temp->next;
-    }
-
-    if (temp == NULL) {
-        printf("Invalid position\n");
-        return;
-    }
-
-    if (temp->next != NULL) {
-        temp->next->prev = temp->prev;
-    }
-
-    temp->prev->next = temp->next;
-    free(temp);
-}
-void clear_list(struct node** head) {
-    struct node* temp = *head;
-    while (temp != NULL) {
-        struct node* next_node = temp->next;
-        free(temp);
-        temp = next_node;
-    }
-    *head = NULL;
-}
-void print_reverse(struct node* head) {
-    if (head == NULL) {
-        printf("The list is empty.\n");
-        return;
-    }
-
-    // Traverse to the last node
-    struct node* temp = head;
-    while (temp->next != NULL) {
-        temp = temp->next;
-    }
-
-    // Print the list in reverse order
-    printf("List in reverse: \n");
-    while (temp != NULL) {
-        printf("%d ", temp->data);
-        temp = temp->prev;
-    }
-    printf("\n");
-}
-
-/**
- --> Main Function
- */
-int main() {
-    struct node* head = NULL;
-    int choice, data, position;
-
-    while (1) {
-        printf("\n************ Menu ************\n");
-        printf("* 1. Add at beginning\n");
-        printf("* 2. Add at end\n");
-        printf("* 3. Add at specific position\n");
-        printf("* 4. Delete from beginning\n");
-        printf("* 5. Delete from end\n");
-        printf("* 6. Delete from specific position\n");
-        printf("* 7. Count nodes\n");
-        printf("* 8. Print list\n");
-        printf("* 9. Delete by value\n");
-        printf("* 10. Clear the list\n");
-        printf("* 11. Print in reverse\n");
-        printf("* 12. Exit\n");
-        printf("*******************************\n");
-        printf("\nEnter your choice: ");
-        scanf("%d", &choice);
-
-        switch (choice) {
-            case 1:
-                printf("Enter data to add at beginning: ");
-                scanf("%d", &data);
-                add_beg(&head, data);
-                break;
-            case 2:
-                printf("Enter data to add at end: ");
-                scanf("%d", &data);
-                add_at_end(&head, data);
-                break;
-            case 3:
-                printf("Enter data to add: ");
-                scanf("%d", &data);
-                printf("Enter position: ");
-                scanf("%d", &position);
-                insert_at_position(&head, data, position);
-                break;
-            case 4:
-                delete_beg(&head);
-                break;
-            case 5:
-                delete_end(&head);
-                break;
-            case 6:
-                printf("Enter position to delete: ");
-                scanf("%d", &position);
-                delete_at_position(&head, position);
-                break;
-            case 7:
-                count_of_nodes(head);
-                break;
-            case 8:
-                print_data(head);
-                break;
-            
-            case 9:
-                printf("Enter value to delete: ");
-                scanf("%d", &data);
-                delete_by_value(&head, data);
-                break;
-            case 10:
-                clear_list(&head);
-                printf("List cleared.\n");
-                break;
-            case 11:
-                print_reverse(head);
-                break;
-                case 12:
-                exit(0);
-
-            default:
-                printf("Invalid choice!\n");
-        }
-    }
-
-    return 0;
-}
-
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ds_dlist.h"
+#include "batch_io.h"
+
+/**
+ * @file Double Linked List.c
+ */
+
+/**
+ --> Printing Helpers
+ *
+ * @function print_value
+ * @description
+ * Callback for `dlist_traverse` and `dlist_traverse_reverse`, prints one value.
+ * The list functions never print, every message of the program comes from here.
+ *
+ * @param val: The value of the current node.
+ * @param ctx: Unused.
+ */
+static void print_value(int val, void* ctx) {
+    (void)ctx;
+    printf("%d ", val);
+}
+
+/**
+ * @function print_list
+ * @description
+ * This function prints the list from head to tail (or tail to head when
+ * `reverse` is set) under `title`, or a message when the list is empty.
+ *
+ * @param list: The list.
+ * @param title: The line printed before the values.
+ * @param reverse: Non-zero to print from tail to head.
+ */
+static void print_list(const struct dlist* list, const char* title, int reverse) {
+    if (dlist_count_of_nodes(list) == 0) {
+        printf("The list is empty.\n");
+        return;
+    }
+    printf("%s\n", title);
+    if (reverse) {
+        dlist_traverse_reverse(list, print_value, NULL);
+    } else {
+        dlist_traverse(list, print_value, NULL);
+    }
+    printf("\n");
+}
+
+/**
+ * @function print_status
+ * @description
+ * This function turns the status returned by a list operation into a message.
+ * Successful operations print nothing, as before.
+ *
+ * @param status: The ds_status returned by the operation.
+ */
+static void print_status(int status) {
+    switch (status) {
+        case DS_OK:
+            break;
+        case DS_EMPTY:
+            printf("List is empty\n");
+            break;
+        case DS_NOT_FOUND:
+            printf("Value not found in the list\n");
+            break;
+        case DS_BAD_POSITION:
+            printf("Invalid position\n");
+            break;
+        default:
+            printf("Memory allocation failed\n");
+    }
+}
+
+/**
+ * @function read_values
+ * @description
+ * This function reads `count` values into a new array, from the operation
+ * log in batch mode or from the keyboard otherwise.
+ *
+ * @param in: The operation log, NULL to read with scanf.
+ * @param count: The number of values to read.
+ * @return The values (to be freed by the caller, also for a count of 0), NULL on a
+ *         negative count or bad input.
+ */
+static int* read_values(struct batch_in* in, int count) {
+    int* values;
+    int i;
+    if (count < 0 || (values = (int*)malloc((size_t)(count ? count : 1) * sizeof(int))) == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < count; i++) {
+        if (in != NULL ? batch_next_int(in, &values[i]) != 1 : scanf("%d", &values[i]) != 1) {
+            free(values);
+            return NULL;
+        }
+    }
+    return values;
+}
+
+/**
+ --> Batch Mode
+ *
+ * @function run_batch
+ * @description
+ * This function executes a whole operation log without prompts. Each
+ * operation is the menu option number followed by the values the menu would
+ * ask for; the log is read in large blocks and all results go through one
+ * fully buffered stdout: option 7 prints the count, 8 and 11 the values,
+ * 15 the value at a position or "not found", 17 (followed by how many values,
+ * then the values) the number of nodes deleted. Option 14 (or the end of the
+ * log) stops the run; Exit keeps the number it had when logs were introduced
+ * and later options come after it, so existing logs keep meaning the same thing.
+ *
+ * @param log: The file holding the operation log, NULL or "-" for stdin.
+ * @return 0 on success, 1 if the log could not be opened or is malformed, 2 if
+ *         an operation ran out of memory.
+ */
+int run_batch(const char* log) {
+    struct batch_in in;
+    struct dlist list;
+    int choice, data, position, status = 0;
+    int* values;
+    long n = 0;
+    char path[256];
+
+    if (batch_open(&in, log) != 0) {
+        fprintf(stderr, "Cannot open %s\n", log);
+        return 1;
+    }
+    dlist_init(&list);
+    dlist_use_finger(&list, 1);
+    while (status == 0 && batch_next_int(&in, &choice) == 1 && choice != 14) {
+        n++;
+        switch (choice) {
+            case 1:
+            case 2:
+            case 9:
+                if (batch_next_int(&in, &data) != 1) {
+                    status = 1;
+                } else if (choice == 1) {
+                    dlist_add_beg(&list, data);
+                } else if (choice == 2) {
+                    dlist_add_at_end(&list, data);
+                } else {
+                    dlist_delete_by_value(&list, data);
+                }
+                break;
+            case 3:
+                if (batch_next_int(&in, &data) != 1 || batch_next_int(&in, &position) != 1) {
+                    status = 1;
+                } else {
+                    dlist_insert_at_position(&list, data, position);
+                }
+                break;
+            case 4:
+                dlist_delete_beg(&list);
+                break;
+            case 5:
+                dlist_delete_end(&list);
+                break;
+            case 6:
+                if (batch_next_int(&in, &position) != 1) {
+                    status = 1;
+                } else {
+                    dlist_delete_at_position(&list, position);
+                }
+                break;
+            case 7:
+                batch_put_int(dlist_count_of_nodes(&list));
+                break;
+            case 8:
+            case 11:
+                if (choice == 8) {
+                    dlist_traverse(&list, print_value, NULL);
+                } else {
+                    dlist_traverse_reverse(&list, print_value, NULL);
+                }
+                putchar('\n');
+                break;
+            case 10:
+                dlist_clear_list(&list);
+                break;
+            case 16:
+                dlist_reverse(&list);
+                break;
+            case 17:
+                if (batch_next_int(&in, &data) != 1 || (values = read_values(&in, data)) == NULL) {
+                    status = 1;
+                } else {
+                    position = dlist_remove_all(&list, values, data);
+                    free(values);
+                    if (position == DS_NO_MEMORY) {
+                        status = 2;
+                    } else {
+                        batch_put_int(position);
+                    }
+                }
+                break;
+            case 15:
+                if (batch_next_int(&in, &position) != 1) {
+                    status = 1;
+                } else if (dlist_get_at(&list, position, &data) == DS_OK) {
+                    batch_put_int(data);
+                } else {
+                    fputs("not found\n", stdout);
+                }
+                break;
+            case 12:
+            case 13:
+                if (batch_next_word(&in, path, sizeof(path)) != 1) {
+                    status = 1;
+                } else if ((choice == 12 ? dlist_save(&list, path) : dlist_load(&list, path)) != 0) {
+                    fprintf(stderr, "File error: %s\n", path);
+                }
+                break;
+            default:
+                status = 1;
+        }
+    }
+    if (status == 1) {
+        fprintf(stderr, "Invalid operation %ld\n", n);
+    } else if (status == 2) {
+        fprintf(stderr, "Out of memory in operation %ld\n", n);
+    }
+    dlist_clear_list(&list);
+    batch_close(&in);
+    DS_EXPORT(dlist_stats);
+    return status;
+}
+
+/**
+ --> Main Function
+ */
+int main(int argc, char* argv[]) {
+    struct dlist list;
+    int choice, data, position, status;
+    int* values;
+    char path[256];
+
+    dlist_init(&list);
+    dlist_use_finger(&list, 1);
+
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0) {
+        return run_batch(argc > 2 ? argv[2] : NULL);
+    }
+
+    while (1) {
+        printf("\n************ Menu ************\n");
+        printf("* 1. Add at beginning\n");
+        printf("* 2. Add at end\n");
+        printf("* 3. Add at specific position\n");
+        printf("* 4. Delete from beginning\n");
+        printf("* 5. Delete from end\n");
+        printf("* 6. Delete from specific position\n");
+        printf("* 7. Count nodes\n");
+        printf("* 8. Print list\n");
+        printf("* 9. Delete by value\n");
+        printf("* 10. Clear the list\n");
+        printf("* 11. Print in reverse\n");
+        printf("* 12. Save to file\n");
+        printf("* 13. Load from file\n");
+        printf("* 14. Exit\n");
+        printf("* 15. Get value at position\n");
+        printf("* 16. Reverse the list\n");
+        printf("* 17. Delete every occurrence of several values\n");
+        printf("*******************************\n");
+        printf("\nEnter your choice: ");
+        scanf("%d", &choice);
+
+        switch (choice) {
+            case 1:
+                printf("Enter data to add at beginning: ");
+                scanf("%d", &data);
+                print_status(dlist_add_beg(&list, data));
+                break;
+            case 2:
+                printf("Enter data to add at end: ");
+                scanf("%d", &data);
+                print_status(dlist_add_at_end(&list, data));
+                break;
+            case 3:
+                printf("Enter data to add: ");
+                scanf("%d", &data);
+                printf("Enter position: ");
+                scanf("%d", &position);
+                print_status(dlist_insert_at_position(&list, data, position));
+                break;
+            case 4:
+                print_status(dlist_delete_beg(&list));
+                break;
+            case 5:
+                print_status(dlist_delete_end(&list));
+                break;
+            case 6:
+                printf("Enter position to delete: ");
+                scanf("%d", &position);
+                print_status(dlist_delete_at_position(&list, position));
+                break;
+            case 7:
+                printf("Number of nodes: %d\n", dlist_count_of_nodes(&list));
+                break;
+            case 8:
+                print_list(&list, "List data: ", 0);
+                break;
+            
+            case 9:
+                printf("Enter value to delete: ");
+                scanf("%d", &data);
+                print_status(dlist_delete_by_value(&list, data));
+                break;
+            case 10:
+                dlist_clear_list(&list);
+                printf("List cleared.\n");
+                break;
+            case 11:
+                print_list(&list, "List in reverse: ", 1);
+                break;
+            case 12:
+                printf("Enter the file name: ");
+                scanf("%255s", path);
+                if (dlist_save(&list, path) == 0)
+                    printf("List saved to %s\n", path);
+                else
+                    printf("Could not save the list\n");
+                break;
+            case 13:
+                printf("Enter the file name: ");
+                scanf("%255s", path);
+                if (dlist_load(&list, path) == 0)
+                    printf("List loaded from %s\n", path);
+                else
+                    printf("Could not load the list\n");
+                break;
+            case 15:
+                printf("Enter position: ");
+                scanf("%d", &position);
+                status = dlist_get_at(&list, position, &data);
+                if (status == DS_OK)
+                    printf("Value at position %d: %d\n", position, data);
+                else
+                    print_status(status);
+                break;
+            case 16:
+                dlist_reverse(&list);
+                printf("List reversed.\n");
+                break;
+            case 17:
+                printf("How many values? ");
+                scanf("%d", &data);
+                printf("Enter the values: ");
+                values = read_values(NULL, data);
+                if (values == NULL) {
+                    printf("Invalid values\n");
+                    break;
+                }
+                status = dlist_remove_all(&list, values, data);
+                free(values);
+                if (status < 0)
+                    print_status(status);
+                else
+                    printf("%d nodes deleted.\n", status);
+                break;
+            case 14:
+                DS_EXPORT(dlist_stats);
+                exit(0);
+
+            default:
+                printf("Invalid choice!\n");
+        }
+    }
+
+    return 0;
+}
+
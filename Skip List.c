@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ds_skiplist.h"
+#include "batch_io.h"
+
+/**
+ * @file Skip List.c
+ */
+
+/**
+ --> Printing Helpers
+ *
+ * @function print_value
+ * @description
+ * Callback for `skiplist_traverse`, prints one value.
+ *
+ * @param val: The value of the current node.
+ * @param ctx: Unused.
+ */
+static void print_value(int val, void* ctx) {
+    (void)ctx;
+    printf("%d ", val);
+}
+
+/**
+ --> Batch Mode
+ *
+ * @function run_batch
+ * @description
+ * This function executes a whole operation log without prompts. Each
+ * operation is the menu option number followed by the value the menu would
+ * ask for; option 3 prints "found" or "not found", 4 the values and 5 the
+ * count. Option 6 (or the end of the log) stops the run.
+ *
+ * @param sl: The skip list the log operates on.
+ * @param log: The file holding the operation log, NULL or "-" for stdin.
+ * @return 0 on success, 1 if the log could not be opened or is malformed.
+ */
+int run_batch(struct skiplist* sl, const char* log) {
+    struct batch_in in;
+    int choice, data, status = 0;
+    long n = 0;
+
+    if (batch_open(&in, log) != 0) {
+        fprintf(stderr, "Cannot open %s\n", log);
+        return 1;
+    }
+    while (status == 0 && batch_next_int(&in, &choice) == 1 && choice != 6) {
+        n++;
+        switch (choice) {
+            case 1:
+            case 2:
+            case 3:
+                if (batch_next_int(&in, &data) != 1) {
+                    status = 1;
+                } else if (choice == 1) {
+                    skiplist_insert(sl, data);
+                } else if (choice == 2) {
+                    skiplist_delete(sl, data);
+                } else {
+                    fputs(skiplist_search(sl, data) ? "found\n" : "not found\n", stdout);
+                }
+                break;
+            case 4:
+                skiplist_traverse(sl, print_value, NULL);
+                putchar('\n');
+                break;
+            case 5:
+                batch_put_int(skiplist_count(sl));
+                break;
+            default:
+                status = 1;
+        }
+    }
+    if (status != 0) {
+        fprintf(stderr, "Invalid operation %ld\n", n);
+    }
+    batch_close(&in);
+    DS_EXPORT(skiplist_stats);
+    return status;
+}
+
+/**
+ --> Main Function
+ */
+int main(int argc, char* argv[]) {
+    struct skiplist sl;
+    int choice, data;
+
+    if (skiplist_init(&sl) != DS_OK) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0) {
+        choice = run_batch(&sl, argc > 2 ? argv[2] : NULL);
+        skiplist_free(&sl);
+        return choice;
+    }
+
+    while (1) {
+        printf("\n************ Menu ************\n");
+        printf("* 1. Insert\n");
+        printf("* 2. Delete\n");
+        printf("* 3. Search\n");
+        printf("* 4. Print in order\n");
+        printf("* 5. Count values\n");
+        printf("* 6. Exit\n");
+        printf("*******************************\n");
+        printf("\nEnter your choice: ");
+        scanf("%d", &choice);
+
+        switch (choice) {
+            case 1:
+                printf("Enter the value to insert: ");
+                scanf("%d", &data);
+                switch (skiplist_insert(&sl, data)) {
+                    case DS_OK:
+                        break;
+                    case DS_EXISTS:
+                        printf("%d is already in the list\n", data);
+                        break;
+                    default:
+                        printf("Memory allocation failed\n");
+                }
+                break;
+            case 2:
+                printf("Enter the value to delete: ");
+                scanf("%d", &data);
+                if (skiplist_delete(&sl, data) != DS_OK)
+                    printf("Value not found in the list\n");
+                break;
+            case 3:
+                printf("Enter the value to search: ");
+                scanf("%d", &data);
+                if (skiplist_search(&sl, data))
+                    printf("%d Value found\n", data);
+                else
+                    printf("Value not found\n");
+                break;
+            case 4:
+                if (skiplist_count(&sl) == 0) {
+                    printf("The list is empty.\n");
+                } else {
+                    printf("List data: \n");
+                    skiplist_traverse(&sl, print_value, NULL);
+                    printf("\n");
+                }
+                break;
+            case 5:
+                printf("Number of values: %d\n", skiplist_count(&sl));
+                break;
+            case 6:
+                skiplist_free(&sl);
+                DS_EXPORT(skiplist_stats);
+                exit(0);
+
+            default:
+                printf("Invalid choice!\n");
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+#ifndef BATCH_IO_H
+#define BATCH_IO_H
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Buffered reader for the non-interactive "--batch" mode of the programs.
+// An operation log is a whitespace separated list of menu option numbers,
+// each followed by the same arguments the menu would have asked for, e.g.
+// "1 10 1 20 2 3" for push 10, push 20, pop, peek on the stack.
+
+#define BATCH_READ_SIZE (1 << 20)
+#define BATCH_WRITE_SIZE (1 << 20)
+
+struct batch_in {
+    FILE* fp;
+    char* buf;
+    size_t len;
+    size_t pos;
+};
+
+// Open the operation log, "-" or NULL meaning stdin, returns 0 on success
+static inline int batch_open(struct batch_in* in, const char* path) {
+    in->fp = (path == NULL || strcmp(path, "-") == 0) ? stdin : fopen(path, "rb");
+    in->buf = (char*)malloc(BATCH_READ_SIZE);
+    in->len = 0;
+    in->pos = 0;
+    if (in->fp == NULL || in->buf == NULL) {
+        if (in->fp != NULL && in->fp != stdin) {
+            fclose(in->fp);
+        }
+        free(in->buf);
+        return -1;
+    }
+    // Results go out in large blocks instead of one write per printf
+    setvbuf(stdout, NULL, _IOFBF, BATCH_WRITE_SIZE);
+    return 0;
+}
+
+static inline void batch_close(struct batch_in* in) {
+    if (in->fp != stdin) {
+        fclose(in->fp);
+    }
+    free(in->buf);
+    fflush(stdout);
+}
+
+// Next byte of the log, EOF once the input is exhausted
+static inline int batch_getc(struct batch_in* in) {
+    if (in->pos == in->len) {
+        in->len = fread(in->buf, 1, BATCH_READ_SIZE, in->fp);
+        in->pos = 0;
+        if (in->len == 0) {
+            return EOF;
+        }
+    }
+    return (unsigned char)in->buf[in->pos++];
+}
+
+static inline int batch_skip_space(struct batch_in* in) {
+    int c;
+    do {
+        c = batch_getc(in);
+    } while (c == ' ' || c == '\n' || c == '\t' || c == '\r');
+    return c;
+}
+
+// Parse the next integer, returns 1 on success, 0 at end of input, -1 on a
+// malformed token or one outside the range of int
+static inline int batch_next_int(struct batch_in* in, int* out) {
+    int c = batch_skip_space(in);
+    int negative = 0, digits = 0, too_big = 0;
+    long long value = 0, limit = INT_MAX;
+
+    if (c == EOF) {
+        return 0;
+    }
+    if (c == '-') {
+        negative = 1;
+        limit = -(long long)INT_MIN;
+        c = batch_getc(in);
+    }
+    // Past the limit the digits are only consumed, so the whole token is rejected
+    while (c >= '0' && c <= '9') {
+        if (!too_big) {
+            value = value * 10 + (c - '0');
+            too_big = value > limit;
+        }
+        digits++;
+        c = batch_getc(in);
+    }
+    if (digits == 0 || too_big || (c != EOF && c != ' ' && c != '\n' && c != '\t' && c != '\r')) {
+        return -1;
+    }
+    *out = (int)(negative ? -value : value);
+    return 1;
+}
+
+// Read the next whitespace separated word (a file name), returns 1 on success
+static inline int batch_next_word(struct batch_in* in, char* dst, size_t cap) {
+    int c = batch_skip_space(in);
+    size_t n = 0;
+
+    if (c == EOF) {
+        return 0;
+    }
+    while (c != EOF && c != ' ' && c != '\n' && c != '\t' && c != '\r') {
+        if (n + 1 < cap) {
+            dst[n++] = (char)c;
+        }
+        c = batch_getc(in);
+    }
+    dst[n] = '\0';
+    return 1;
+}
+
+// Append an integer and a newline to the buffered output
+static inline void batch_put_int(int val) {
+    char text[16];
+    int n = sizeof(text);
+    unsigned int u = val < 0 ? 0u - (unsigned int)val : (unsigned int)val;
+
+    text[--n] = '\n';
+    do {
+        text[--n] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    if (val < 0) {
+        text[--n] = '-';
+    }
+    fwrite(text + n, 1, sizeof(text) - n, stdout);
+}
+
+#endif
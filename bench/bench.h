@@ -0,0 +1,221 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+// Small benchmark harness shared by the bench_* programs.
+// Every workload runs in a forked child so it starts from a fresh heap and its
+// peak memory can be read back from getrusage(). Anything a workload
+// prints goes to /dev/null; result rows go to the real stdout as CSV, or as
+// JSON lines with --json.
+
+#define BENCH_MAX_SIZES 16
+
+enum bench_order { ORDER_SORTED, ORDER_RANDOM, ORDER_ADVERSARIAL };
+
+static const char* const bench_order_names[] = {"sorted", "random", "adversarial"};
+
+struct bench_clock {
+    struct timespec start;
+    double ns;
+};
+
+struct bench_config {
+    long sizes[BENCH_MAX_SIZES];
+    int nsizes;
+    int json;
+    double quad_budget;   // largest n*n an O(n^2) workload may cost
+    int threads;          // most threads a concurrent workload runs with
+    FILE* out;
+};
+
+// Workload body: builds whatever it needs, times the measured part with
+// bench_start()/bench_stop() and returns the number of operations timed
+typedef long (*bench_fn)(long n, const int* keys, struct bench_clock* clk);
+
+static inline void bench_start(struct bench_clock* clk) {
+    clock_gettime(CLOCK_MONOTONIC, &clk->start);
+}
+
+static inline void bench_stop(struct bench_clock* clk) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    clk->ns += (double)(end.tv_sec - clk->start.tv_sec) * 1e9 + (double)(end.tv_nsec - clk->start.tv_nsec);
+}
+
+// Results of the timed work go through bench_consume(): a volatile store the
+// compiler must keep, so link-time optimisation cannot drop the calls behind them
+static volatile long long bench_sink;
+
+static inline void bench_consume(long long value) {
+    bench_sink = value;
+}
+
+// xorshift64*, fixed seed so every run sees the same key sequence
+static inline unsigned long long bench_rand(void) {
+    static unsigned long long state = 0x9E3779B97F4A7C15ULL;
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 2685821657736338717ULL;
+}
+
+// Keys 0..n-1 in the requested order; adversarial is a zigzag (0, n-1, 1, n-2, ...)
+// which degenerates an unbalanced BST just like sorted input but defeats
+// "append at the end" shortcuts
+static int* bench_keys(enum bench_order order, long n) {
+    int* keys = (int*)malloc((size_t)(n ? n : 1) * sizeof(int));
+    long i;
+    if (keys == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < n; i++) {
+        if (order == ORDER_ADVERSARIAL) {
+            keys[i] = (int)(i % 2 == 0 ? i / 2 : n - 1 - i / 2);
+        } else {
+            keys[i] = (int)i;
+        }
+    }
+    if (order == ORDER_RANDOM) {
+        for (i = n - 1; i > 0; i--) {
+            long j = (long)(bench_rand() % (unsigned long long)(i + 1));
+            int tmp = keys[i];
+            keys[i] = keys[j];
+            keys[j] = tmp;
+        }
+    }
+    return keys;
+}
+
+static void bench_usage(const char* prog) {
+    fprintf(stderr,
+            "usage: %s [--sizes N,N,...] [--quad-budget X] [--threads N] [--json]\n"
+            "  --sizes        element counts to run (default 1000,10000,100000,1000000)\n"
+            "  --quad-budget  skip O(n^2) workloads when n*n exceeds X (default 1e9)\n"
+            "  --threads      run concurrent workloads with 1, 2, 4, ... up to N threads\n"
+            "                 (default the number of cores)\n"
+            "  --json         print JSON lines instead of CSV\n",
+            prog);
+}
+
+// Parse the command line and move stdout to /dev/null, returns 0 on success
+static int bench_init(struct bench_config* cfg, int argc, char* argv[]) {
+    static const long defaults[] = {1000, 10000, 100000, 1000000};
+    int i, fd;
+
+    cfg->nsizes = 4;
+    memcpy(cfg->sizes, defaults, sizeof(defaults));
+    cfg->json = 0;
+    cfg->quad_budget = 1e9;
+    cfg->threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            cfg->json = 1;
+        } else if (strcmp(argv[i], "--quad-budget") == 0 && i + 1 < argc) {
+            cfg->quad_budget = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            cfg->threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) {
+            char* p = argv[++i];
+            cfg->nsizes = 0;
+            while (*p != '\0' && cfg->nsizes < BENCH_MAX_SIZES) {
+                cfg->sizes[cfg->nsizes++] = (long)strtod(p, &p);
+                if (*p == ',') {
+                    p++;
+                } else if (*p != '\0') {
+                    bench_usage(argv[0]);
+                    return -1;
+                }
+            }
+        } else {
+            bench_usage(argv[0]);
+            return -1;
+        }
+    }
+
+    if (cfg->threads < 1) {
+        cfg->threads = 1;
+    }
+
+    // Keep the real stdout for results, silence anything else written to it
+    fflush(stdout);
+    cfg->out = fdopen(dup(STDOUT_FILENO), "w");
+    fd = open("/dev/null", O_WRONLY);
+    if (cfg->out == NULL || fd < 0) {
+        return -1;
+    }
+    dup2(fd, STDOUT_FILENO);
+    close(fd);
+
+    if (!cfg->json) {
+        fprintf(cfg->out, "structure,operation,order,n,ops,ns_per_op,ops_per_sec,peak_kb\n");
+        fflush(cfg->out);
+    }
+    return 0;
+}
+
+static long bench_maxrss_kb(void) {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;
+}
+
+// Run one workload for every configured size
+static void bench_run(struct bench_config* cfg, const char* structure, const char* operation,
+                      enum bench_order order, int quadratic, bench_fn fn) {
+    int i;
+    for (i = 0; i < cfg->nsizes; i++) {
+        long n = cfg->sizes[i];
+        pid_t pid;
+        int status;
+
+        if (quadratic && (double)n * (double)n > cfg->quad_budget) {
+            fprintf(stderr, "skip %s/%s/%s n=%ld: O(n^2) over budget\n",
+                    structure, operation, bench_order_names[order], n);
+            continue;
+        }
+
+        fflush(cfg->out);
+        pid = fork();
+        if (pid == 0) {
+            struct bench_clock clk = {{0, 0}, 0.0};
+            long base_kb = bench_maxrss_kb();
+            int* keys = bench_keys(order, n);
+            long ops, peak_kb;
+            double ns_per_op;
+
+            if (keys == NULL) {
+                _exit(2);
+            }
+            ops = fn(n, keys, &clk);
+            peak_kb = bench_maxrss_kb() - base_kb;
+            ns_per_op = ops > 0 ? clk.ns / (double)ops : 0.0;
+            if (cfg->json) {
+                fprintf(cfg->out,
+                        "{\"structure\":\"%s\",\"operation\":\"%s\",\"order\":\"%s\",\"n\":%ld,"
+                        "\"ops\":%ld,\"ns_per_op\":%.2f,\"ops_per_sec\":%.0f,\"peak_kb\":%ld}\n",
+                        structure, operation, bench_order_names[order], n, ops, ns_per_op,
+                        ns_per_op > 0 ? 1e9 / ns_per_op : 0.0, peak_kb);
+            } else {
+                fprintf(cfg->out, "%s,%s,%s,%ld,%ld,%.2f,%.0f,%ld\n",
+                        structure, operation, bench_order_names[order], n, ops, ns_per_op,
+                        ns_per_op > 0 ? 1e9 / ns_per_op : 0.0, peak_kb);
+            }
+            fflush(cfg->out);
+            _exit(0);
+        }
+        if (pid < 0 || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            fprintf(stderr, "%s/%s/%s n=%ld failed\n", structure, operation, bench_order_names[order], n);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,136 @@
+// Benchmarks for the compact (index-linked) doubly linked list, same workloads
+// as bench_dlist so ns_per_op and peak_kb compare row by row
+#include "ds_clist.h"
+
+#include "bench.h"
+
+static struct clist bench_build(long n, const int* keys) {
+    struct clist list;
+    long i;
+    clist_init(&list);
+    for (i = 0; i < n; i++) {
+        clist_add_at_end(&list, keys[i]);
+    }
+    return list;
+}
+
+static long bench_add_beg(long n, const int* keys, struct bench_clock* clk) {
+    struct clist list;
+    long i;
+    clist_init(&list);
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        clist_add_beg(&list, keys[i]);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_add_at_end(long n, const int* keys, struct bench_clock* clk) {
+    struct clist list;
+    long i;
+    clist_init(&list);
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        clist_add_at_end(&list, keys[i]);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_insert_middle(long n, const int* keys, struct bench_clock* clk) {
+    struct clist list = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        clist_insert_at_position(&list, keys[i], (int)(n / 2));
+    }
+    bench_stop(clk);
+    return n;
+}
+
+// Positions near the tail are reached from the tail, as cheap as near the head
+static long bench_delete_near_tail(long n, const int* keys, struct bench_clock* clk) {
+    struct clist list = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        clist_delete_at_position(&list, (int)(n - i > 1 ? n - i - 1 : 1));
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_delete_beg(long n, const int* keys, struct bench_clock* clk) {
+    struct clist list = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        clist_delete_beg(&list);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_delete_end(long n, const int* keys, struct bench_clock* clk) {
+    struct clist list = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        clist_delete_end(&list);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_delete_by_value(long n, const int* keys, struct bench_clock* clk) {
+    struct clist list = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        clist_delete_by_value(&list, (int)i);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static void bench_visit(int val, void* ctx) {
+    *(long*)ctx += val;
+}
+
+static long bench_traverse_reverse(long n, const int* keys, struct bench_clock* clk) {
+    struct clist list = bench_build(n, keys);
+    long sum = 0;
+    bench_start(clk);
+    clist_traverse_reverse(&list, bench_visit, &sum);
+    bench_stop(clk);
+    bench_consume(sum);
+    clist_free(&list);
+    return n;
+}
+
+static long bench_clear(long n, const int* keys, struct bench_clock* clk) {
+    struct clist list = bench_build(n, keys);
+    bench_start(clk);
+    clist_free(&list);
+    bench_stop(clk);
+    return n;
+}
+
+int main(int argc, char* argv[]) {
+    struct bench_config cfg;
+    if (bench_init(&cfg, argc, argv) != 0) {
+        return 1;
+    }
+    bench_run(&cfg, "clist", "add_beg", ORDER_RANDOM, 0, bench_add_beg);
+    bench_run(&cfg, "clist", "add_at_end", ORDER_RANDOM, 0, bench_add_at_end);
+    bench_run(&cfg, "clist", "insert_at_position", ORDER_RANDOM, 1, bench_insert_middle);
+    bench_run(&cfg, "clist", "delete_beg", ORDER_RANDOM, 0, bench_delete_beg);
+    bench_run(&cfg, "clist", "delete_end", ORDER_RANDOM, 0, bench_delete_end);
+    bench_run(&cfg, "clist", "delete_at_position_tail", ORDER_RANDOM, 0, bench_delete_near_tail);
+    bench_run(&cfg, "clist", "delete_by_value", ORDER_RANDOM, 1, bench_delete_by_value);
+    bench_run(&cfg, "clist", "delete_by_value", ORDER_SORTED, 1, bench_delete_by_value);
+    bench_run(&cfg, "clist", "traverse_reverse", ORDER_RANDOM, 0, bench_traverse_reverse);
+    bench_run(&cfg, "clist", "clear_list", ORDER_RANDOM, 0, bench_clear);
+    return 0;
+}
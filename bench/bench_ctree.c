@@ -0,0 +1,151 @@
+// Benchmarks for the concurrent tree: single-threaded insert/search/delete, and
+// a read-mostly workload (98% search, 1% insert, 1% delete) and a read-only one
+// with 1, 2, 4, ... threads up to --threads (the core count by default, at most
+// CTREE_MAX_THREADS)
+#include <pthread.h>
+#include "ds_ctree.h"
+
+#include "bench.h"
+
+static struct ctree bench_ct;
+
+static void bench_build(long n, const int* keys) {
+    long i;
+    ctree_init(&bench_ct);
+    for (i = 0; i < n; i++) {
+        ctree_insert(&bench_ct, keys[i]);
+    }
+}
+
+static long bench_insert(long n, const int* keys, struct bench_clock* clk) {
+    bench_start(clk);
+    bench_build(n, keys);
+    bench_stop(clk);
+    ctree_free(&bench_ct);
+    return n;
+}
+
+static long bench_search_hit(long n, const int* keys, struct bench_clock* clk) {
+    int slot;
+    long hits = 0, i;
+    bench_build(n, keys);
+    slot = ctree_register(&bench_ct);
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        hits += ctree_search(&bench_ct, slot, keys[(i * 7919) % n]);
+    }
+    bench_stop(clk);
+    bench_consume(hits);
+    ctree_free(&bench_ct);
+    return n;
+}
+
+static long bench_delete(long n, const int* keys, struct bench_clock* clk) {
+    long i;
+    bench_build(n, keys);
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        ctree_delete(&bench_ct, keys[(i * 7919) % n]);
+    }
+    bench_stop(clk);
+    ctree_free(&bench_ct);
+    return n;
+}
+
+static int bench_threads;
+static int bench_write_pct;
+
+struct bench_worker {
+    pthread_t thread;
+    long ops;
+    long n;
+    const int* keys;
+    unsigned long long seed;
+};
+
+static void* bench_worker_run(void* arg) {
+    struct bench_worker* w = (struct bench_worker*)arg;
+    int slot = ctree_register(&bench_ct);
+    long hits = 0, i;
+    if (slot < 0) {
+        return NULL;
+    }
+    for (i = 0; i < w->ops; i++) {
+        unsigned long long r;
+        int key;
+        w->seed ^= w->seed >> 12;
+        w->seed ^= w->seed << 25;
+        w->seed ^= w->seed >> 27;
+        r = w->seed * 2685821657736338717ULL;
+        key = w->keys[(r >> 8) % (unsigned long long)w->n];
+        if ((int)(r % 200) < bench_write_pct) {
+            ctree_insert(&bench_ct, key);
+        } else if ((int)(r % 200) < 2 * bench_write_pct) {
+            ctree_delete(&bench_ct, key);
+        } else {
+            hits += ctree_search(&bench_ct, slot, key);
+        }
+    }
+    bench_consume(hits);
+    ctree_unregister(&bench_ct, slot);
+    return NULL;
+}
+
+static long bench_concurrent(long n, const int* keys, struct bench_clock* clk) {
+    struct bench_worker* workers = (struct bench_worker*)malloc((size_t)bench_threads * sizeof(struct bench_worker));
+    long i;
+    if (workers == NULL) {
+        return 0;
+    }
+    ctree_init(&bench_ct);
+    for (i = 0; i < n; i++) {
+        if (keys[i] % 2 == 0) {
+            ctree_insert(&bench_ct, keys[i]);
+        }
+    }
+    for (i = 0; i < bench_threads; i++) {
+        workers[i].ops = n / bench_threads;
+        workers[i].n = n;
+        workers[i].keys = keys;
+        workers[i].seed = 0x9E3779B97F4A7C15ULL * (unsigned long long)(i + 1);
+    }
+    bench_start(clk);
+    for (i = 0; i < bench_threads; i++) {
+        pthread_create(&workers[i].thread, NULL, bench_worker_run, &workers[i]);
+    }
+    for (i = 0; i < bench_threads; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+    bench_stop(clk);
+    ctree_free(&bench_ct);
+    free(workers);
+    return (n / bench_threads) * bench_threads;
+}
+
+int main(int argc, char* argv[]) {
+    struct bench_config cfg;
+    int most;
+    char name[32];
+    if (bench_init(&cfg, argc, argv) != 0) {
+        return 1;
+    }
+    most = cfg.threads < CTREE_MAX_THREADS ? cfg.threads : CTREE_MAX_THREADS;  // one slot each
+    bench_run(&cfg, "ctree", "insert", ORDER_RANDOM, 0, bench_insert);
+    bench_run(&cfg, "ctree", "search_hit", ORDER_RANDOM, 0, bench_search_hit);
+    bench_run(&cfg, "ctree", "delete", ORDER_RANDOM, 0, bench_delete);
+    for (bench_threads = 1;; bench_threads *= 2) {
+        if (bench_threads > most) {
+            bench_threads = most;
+        }
+        bench_write_pct = 2;
+        snprintf(name, sizeof(name), "read_mostly_t%d", bench_threads);
+        bench_run(&cfg, "ctree", name, ORDER_RANDOM, 0, bench_concurrent);
+        bench_write_pct = 0;
+        snprintf(name, sizeof(name), "read_only_t%d", bench_threads);
+        bench_run(&cfg, "ctree", name, ORDER_RANDOM, 0, bench_concurrent);
+        if (bench_threads >= most) {
+            break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,324 @@
+// Benchmarks for the doubly linked list: insertion, deletion and traversal
+#include "ds_dlist.h"
+
+#include "bench.h"
+
+static struct dlist bench_build(long n, const int* keys) {
+    struct dlist list;
+    long i;
+    dlist_init(&list);
+    for (i = 0; i < n; i++) {
+        dlist_add_at_end(&list, keys[i]);
+    }
+    return list;
+}
+
+static long bench_add_beg(long n, const int* keys, struct bench_clock* clk) {
+    struct dlist list;
+    long i;
+    dlist_init(&list);
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        dlist_add_beg(&list, keys[i]);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_add_at_end(long n, const int* keys, struct bench_clock* clk) {
+    struct dlist list;
+    long i;
+    dlist_init(&list);
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        dlist_add_at_end(&list, keys[i]);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_insert_middle(long n, const int* keys, struct bench_clock* clk) {
+    struct dlist list = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        dlist_insert_at_position(&list, keys[i], (int)(n / 2));
+    }
+    bench_stop(clk);
+    return n;
+}
+
+// Positions near the tail are reached from the tail, as cheap as near the head
+static long bench_delete_near_tail(long n, const int* keys, struct bench_clock* clk) {
+    struct dlist list = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        dlist_delete_at_position(&list, (int)(n - i > 1 ? n - i - 1 : 1));
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_delete_beg(long n, const int* keys, struct bench_clock* clk) {
+    struct dlist list = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        dlist_delete_beg(&list);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_delete_end(long n, const int* keys, struct bench_clock* clk) {
+    struct dlist list = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        dlist_delete_end(&list);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_delete_by_value(long n, const int* keys, struct bench_clock* clk) {
+    struct dlist list = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        dlist_delete_by_value(&list, (int)i);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+// Read every position in order; O(1) per call with the finger, O(n) without
+static long bench_get_at(long n, const int* keys, struct bench_clock* clk, int use_finger) {
+    struct dlist list = bench_build(n, keys);
+    long i, sum = 0;
+    int val = 0;
+    dlist_use_finger(&list, use_finger);
+    bench_start(clk);
+    for (i = 1; i <= n; i++) {
+        dlist_get_at(&list, (int)i, &val);
+        sum += val;
+    }
+    bench_stop(clk);
+    bench_consume(sum);
+    dlist_clear_list(&list);
+    return n;
+}
+
+static long bench_get_at_finger(long n, const int* keys, struct bench_clock* clk) {
+    return bench_get_at(n, keys, clk, 1);
+}
+
+static long bench_get_at_plain(long n, const int* keys, struct bench_clock* clk) {
+    return bench_get_at(n, keys, clk, 0);
+}
+
+static void bench_visit(int val, void* ctx) {
+    *(long*)ctx += val;
+}
+
+static long bench_traverse_reverse(long n, const int* keys, struct bench_clock* clk) {
+    struct dlist list = bench_build(n, keys);
+    long sum = 0;
+    bench_start(clk);
+    dlist_traverse_reverse(&list, bench_visit, &sum);
+    bench_stop(clk);
+    bench_consume(sum);
+    dlist_clear_list(&list);
+    return n;
+}
+
+// A list whose nodes went through churn: the nodes are allocated interleaved
+// with as many others of the same size, the others are freed in random order,
+// and then every node is replaced (new one allocated, old one freed) in another
+// random order, so the allocator hands out the holes left behind. Node i holds
+// key i and the list is linked in key order, so a scan jumps around the heap
+static struct dlist bench_build_scattered(long n, const int* keys) {
+    struct dlist_node** nodes = (struct dlist_node**)malloc((size_t)n * sizeof(struct dlist_node*));
+    struct dlist_node** others = (struct dlist_node**)malloc((size_t)n * sizeof(struct dlist_node*));
+    struct dlist list;
+    long i;
+    if (nodes == NULL || others == NULL) {
+        exit(2);
+    }
+    for (i = 0; i < n; i++) {
+        nodes[i] = (struct dlist_node*)malloc(sizeof(struct dlist_node));
+        others[i] = (struct dlist_node*)malloc(sizeof(struct dlist_node));
+    }
+    for (i = 0; i < n; i++) {
+        free(others[keys[i]]);
+    }
+    for (i = 0; i < n; i++) {
+        struct dlist_node* node = (struct dlist_node*)malloc(sizeof(struct dlist_node));
+        free(nodes[keys[n - 1 - i]]);
+        nodes[keys[n - 1 - i]] = node;
+    }
+    dlist_init(&list);
+    for (i = 0; i < n; i++) {
+        struct dlist_node* node = nodes[i];
+        node->data = (int)i;
+        node->slot = 0;
+        node->prev = list.tail;
+        node->next = NULL;
+        if (list.tail == NULL) {
+            list.head = node;
+        } else {
+            list.tail->next = node;
+        }
+        list.tail = node;
+    }
+    list.count = (int)n;
+    free(others);
+    free(nodes);
+    return list;
+}
+
+static long bench_traverse_scattered(long n, const int* keys, struct bench_clock* clk) {
+    struct dlist list = bench_build_scattered(n, keys);
+    long sum = 0;
+    bench_start(clk);
+    dlist_traverse(&list, bench_visit, &sum);
+    bench_stop(clk);
+    bench_consume(sum);
+    dlist_clear_list(&list);
+    return n;
+}
+
+static long bench_compact(long n, const int* keys, struct bench_clock* clk) {
+    struct dlist list = bench_build_scattered(n, keys);
+    bench_start(clk);
+    dlist_compact(&list);
+    bench_stop(clk);
+    dlist_clear_list(&list);
+    return n;
+}
+
+// The same scattered list, scanned after dlist_compact()
+static long bench_traverse_compacted(long n, const int* keys, struct bench_clock* clk) {
+    struct dlist list = bench_build_scattered(n, keys);
+    long sum = 0;
+    dlist_compact(&list);
+    bench_start(clk);
+    dlist_traverse(&list, bench_visit, &sum);
+    bench_stop(clk);
+    bench_consume(sum);
+    dlist_clear_list(&list);
+    return n;
+}
+
+// Purge a tenth of the values: one pass over the list plus one hash-set probe per node
+static long bench_remove_all(long n, const int* keys, struct bench_clock* clk) {
+    struct dlist list = bench_build(n, keys);
+    int count = (int)(n / 10 ? n / 10 : 1);
+    int* values = (int*)malloc((size_t)count * sizeof(int));
+    int i;
+    if (values == NULL) {
+        exit(2);
+    }
+    for (i = 0; i < count; i++) {
+        values[i] = i * 10;
+    }
+    bench_start(clk);
+    dlist_remove_all(&list, values, count);
+    bench_stop(clk);
+    free(values);
+    dlist_clear_list(&list);
+    return n;
+}
+
+static int bench_is_odd(int val, void* ctx) {
+    (void)ctx;
+    return val & 1;
+}
+
+static long bench_remove_if(long n, const int* keys, struct bench_clock* clk) {
+    struct dlist list = bench_build(n, keys);
+    bench_start(clk);
+    dlist_remove_if(&list, bench_is_odd, NULL);
+    bench_stop(clk);
+    dlist_clear_list(&list);
+    return n;
+}
+
+static long bench_reverse(long n, const int* keys, struct bench_clock* clk) {
+    struct dlist list = bench_build(n, keys);
+    bench_start(clk);
+    dlist_reverse(&list);
+    bench_stop(clk);
+    dlist_clear_list(&list);
+    return n;
+}
+
+// Merge the even and the odd values below n, interleaving every node
+static long bench_merge_sorted(long n, const int* keys, struct bench_clock* clk) {
+    struct dlist evens, odds;
+    long i;
+    (void)keys;
+    dlist_init(&evens);
+    dlist_init(&odds);
+    for (i = 0; i < n; i++) {
+        dlist_add_at_end(i % 2 ? &odds : &evens, (int)i);
+    }
+    bench_start(clk);
+    dlist_merge_sorted(&evens, &odds);
+    bench_stop(clk);
+    dlist_clear_list(&evens);
+    return n;
+}
+
+// Halve the list and join it back n times; both are O(1) once the cut is found
+static long bench_split_concatenate(long n, const int* keys, struct bench_clock* clk) {
+    struct dlist list = bench_build(n, keys), rest;
+    long i;
+    dlist_init(&rest);
+    dlist_use_finger(&list, 1);
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        dlist_split_at(&list, (int)(n / 2 + 1), &rest);
+        dlist_concatenate(&list, &rest);
+    }
+    bench_stop(clk);
+    dlist_clear_list(&list);
+    return n;
+}
+
+static long bench_clear(long n, const int* keys, struct bench_clock* clk) {
+    struct dlist list = bench_build(n, keys);
+    bench_start(clk);
+    dlist_clear_list(&list);
+    bench_stop(clk);
+    return n;
+}
+
+int main(int argc, char* argv[]) {
+    struct bench_config cfg;
+    if (bench_init(&cfg, argc, argv) != 0) {
+        return 1;
+    }
+    bench_run(&cfg, "dlist", "add_beg", ORDER_RANDOM, 0, bench_add_beg);
+    bench_run(&cfg, "dlist", "add_at_end", ORDER_RANDOM, 0, bench_add_at_end);
+    bench_run(&cfg, "dlist", "insert_at_position", ORDER_RANDOM, 1, bench_insert_middle);
+    bench_run(&cfg, "dlist", "delete_beg", ORDER_RANDOM, 0, bench_delete_beg);
+    bench_run(&cfg, "dlist", "delete_end", ORDER_RANDOM, 0, bench_delete_end);
+    bench_run(&cfg, "dlist", "delete_at_position_tail", ORDER_RANDOM, 0, bench_delete_near_tail);
+    bench_run(&cfg, "dlist", "delete_by_value", ORDER_RANDOM, 1, bench_delete_by_value);
+    bench_run(&cfg, "dlist", "delete_by_value", ORDER_SORTED, 1, bench_delete_by_value);
+    bench_run(&cfg, "dlist", "get_at_sequential", ORDER_RANDOM, 1, bench_get_at_plain);
+    bench_run(&cfg, "dlist", "get_at_sequential_finger", ORDER_RANDOM, 0, bench_get_at_finger);
+    bench_run(&cfg, "dlist", "traverse_reverse", ORDER_RANDOM, 0, bench_traverse_reverse);
+    bench_run(&cfg, "dlist", "traverse_scattered", ORDER_RANDOM, 0, bench_traverse_scattered);
+    bench_run(&cfg, "dlist", "compact", ORDER_RANDOM, 0, bench_compact);
+    bench_run(&cfg, "dlist", "traverse_compacted", ORDER_RANDOM, 0, bench_traverse_compacted);
+    bench_run(&cfg, "dlist", "remove_all", ORDER_RANDOM, 0, bench_remove_all);
+    bench_run(&cfg, "dlist", "remove_if", ORDER_RANDOM, 0, bench_remove_if);
+    bench_run(&cfg, "dlist", "reverse", ORDER_RANDOM, 0, bench_reverse);
+    bench_run(&cfg, "dlist", "merge_sorted", ORDER_SORTED, 0, bench_merge_sorted);
+    bench_run(&cfg, "dlist", "split_concatenate", ORDER_RANDOM, 1, bench_split_concatenate);
+    bench_run(&cfg, "dlist", "clear_list", ORDER_RANDOM, 0, bench_clear);
+    return 0;
+}
@@ -0,0 +1,135 @@
+// Benchmarks for the intrusive lists: the records are allocated once, outside
+// the timed part, and the lists only link them; compare with bench_slist/bench_dlist
+#include "ds_ilist.h"
+
+#include "bench.h"
+
+struct bench_record {
+    int id;
+    struct islist_link slink;
+    struct idlist_link dlink;
+};
+
+static struct bench_record* bench_records(long n, const int* keys) {
+    struct bench_record* records = (struct bench_record*)malloc((size_t)(n ? n : 1) * sizeof(struct bench_record));
+    long i;
+    if (records == NULL) {
+        exit(2);
+    }
+    for (i = 0; i < n; i++) {
+        records[i].id = keys[i];
+    }
+    return records;
+}
+
+static int bench_match(const void* link, void* ctx) {
+    return ds_container_of(link, struct bench_record, dlink)->id == *(const int*)ctx;
+}
+
+static long bench_islist_add_beg(long n, const int* keys, struct bench_clock* clk) {
+    struct bench_record* records = bench_records(n, keys);
+    struct islist list;
+    long i;
+    islist_init(&list);
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        islist_add_beg(&list, &records[i].slink);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_islist_reverse(long n, const int* keys, struct bench_clock* clk) {
+    struct bench_record* records = bench_records(n, keys);
+    struct islist list;
+    long i;
+    islist_init(&list);
+    for (i = 0; i < n; i++) {
+        islist_add_beg(&list, &records[i].slink);
+    }
+    bench_start(clk);
+    islist_reverse(&list);
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_idlist_add_at_end(long n, const int* keys, struct bench_clock* clk) {
+    struct bench_record* records = bench_records(n, keys);
+    struct idlist list;
+    long i;
+    idlist_init(&list);
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        idlist_add_at_end(&list, &records[i].dlink);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+// Sum the ids through container_of, the intrusive equivalent of traversing the owned list
+static long bench_idlist_traverse(long n, const int* keys, struct bench_clock* clk) {
+    struct bench_record* records = bench_records(n, keys);
+    struct idlist list;
+    struct idlist_link* pos;
+    long i, sum = 0;
+    idlist_init(&list);
+    for (i = 0; i < n; i++) {
+        idlist_add_at_end(&list, &records[i].dlink);
+    }
+    bench_start(clk);
+    IDLIST_FOR_EACH(pos, &list) {
+        sum += ds_container_of(pos, struct bench_record, dlink)->id;
+    }
+    bench_stop(clk);
+    bench_consume(sum);
+    return n;
+}
+
+static long bench_idlist_search(long n, const int* keys, struct bench_clock* clk) {
+    struct bench_record* records = bench_records(n, keys);
+    struct idlist list;
+    long found = 0, i;
+    idlist_init(&list);
+    for (i = 0; i < n; i++) {
+        idlist_add_at_end(&list, &records[i].dlink);
+    }
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        int key = keys[(i * 7919) % n];
+        found += idlist_search(&list, bench_match, &key) != NULL;
+    }
+    bench_stop(clk);
+    bench_consume(found);
+    return n;
+}
+
+// Delete every record by address in random order: O(1) each, no search and no free()
+static long bench_idlist_delete(long n, const int* keys, struct bench_clock* clk) {
+    struct bench_record* records = bench_records(n, keys);
+    struct idlist list;
+    long i;
+    idlist_init(&list);
+    for (i = 0; i < n; i++) {
+        idlist_add_at_end(&list, &records[i].dlink);
+    }
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        idlist_delete(&records[keys[i]].dlink);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+int main(int argc, char* argv[]) {
+    struct bench_config cfg;
+    if (bench_init(&cfg, argc, argv) != 0) {
+        return 1;
+    }
+    bench_run(&cfg, "islist", "add_beg", ORDER_RANDOM, 0, bench_islist_add_beg);
+    bench_run(&cfg, "islist", "reverse", ORDER_RANDOM, 0, bench_islist_reverse);
+    bench_run(&cfg, "idlist", "add_at_end", ORDER_RANDOM, 0, bench_idlist_add_at_end);
+    bench_run(&cfg, "idlist", "traverse", ORDER_RANDOM, 0, bench_idlist_traverse);
+    bench_run(&cfg, "idlist", "search", ORDER_RANDOM, 1, bench_idlist_search);
+    bench_run(&cfg, "idlist", "delete", ORDER_RANDOM, 0, bench_idlist_delete);
+    return 0;
+}
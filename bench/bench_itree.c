@@ -0,0 +1,114 @@
+// Benchmarks for the interval tree: insert for every key order (sorted starts
+// would make a plain BST degenerate), stabbing and range overlap queries, and
+// delete, plus the stabbing query done by visiting every interval, which is
+// what a tree without the max_end field would have to do. Key k stands for the
+// interval [2k, 2k + k % 32], so a point lies in about 8 intervals
+#include "ds_itree.h"
+
+#include "bench.h"
+
+static int interval_end(int key) {
+    return 2 * key + key % 32;
+}
+
+static struct itree bench_build(long n, const int* keys) {
+    struct itree t;
+    long i;
+    itree_init(&t);
+    for (i = 0; i < n; i++) {
+        itree_insert(&t, 2 * keys[i], interval_end(keys[i]));
+    }
+    return t;
+}
+
+static long bench_insert(long n, const int* keys, struct bench_clock* clk) {
+    struct itree t;
+    bench_start(clk);
+    t = bench_build(n, keys);
+    bench_stop(clk);
+    itree_free(&t);
+    return n;
+}
+
+static long bench_stab(long n, const int* keys, struct bench_clock* clk) {
+    struct itree t = bench_build(n, keys);
+    long found = 0, i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        found += itree_stab(&t, 2 * keys[(i * 7919) % n], NULL, NULL);
+    }
+    bench_stop(clk);
+    bench_consume(found);
+    itree_free(&t);
+    return n;
+}
+
+// Ranges 64 wide, about 40 intervals reported per query
+static long bench_overlap(long n, const int* keys, struct bench_clock* clk) {
+    struct itree t = bench_build(n, keys);
+    long found = 0, i;
+    int lo;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        lo = 2 * keys[(i * 7919) % n];
+        found += itree_overlap(&t, lo, lo + 64, NULL, NULL);
+    }
+    bench_stop(clk);
+    bench_consume(found);
+    itree_free(&t);
+    return n;
+}
+
+struct bench_stab_scan {
+    int point;
+    long found;
+};
+
+static void bench_check(int start, int end, void* ctx) {
+    struct bench_stab_scan* scan = (struct bench_stab_scan*)ctx;
+    if (start <= scan->point && scan->point <= end) {
+        scan->found++;
+    }
+}
+
+static long bench_stab_scan(long n, const int* keys, struct bench_clock* clk) {
+    struct itree t = bench_build(n, keys);
+    struct bench_stab_scan scan = {0, 0};
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        scan.point = 2 * keys[(i * 7919) % n];
+        itree_inorder(&t, bench_check, &scan);
+    }
+    bench_stop(clk);
+    bench_consume(scan.found);
+    itree_free(&t);
+    return n;
+}
+
+static long bench_delete(long n, const int* keys, struct bench_clock* clk) {
+    struct itree t = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        itree_delete(&t, 2 * keys[(i * 7919) % n], interval_end(keys[(i * 7919) % n]));
+    }
+    bench_stop(clk);
+    itree_free(&t);
+    return n;
+}
+
+int main(int argc, char* argv[]) {
+    struct bench_config cfg;
+    if (bench_init(&cfg, argc, argv) != 0) {
+        return 1;
+    }
+    bench_run(&cfg, "itree", "insert", ORDER_RANDOM, 0, bench_insert);
+    bench_run(&cfg, "itree", "insert", ORDER_SORTED, 0, bench_insert);
+    bench_run(&cfg, "itree", "stab", ORDER_RANDOM, 0, bench_stab);
+    bench_run(&cfg, "itree", "stab", ORDER_SORTED, 0, bench_stab);
+    bench_run(&cfg, "itree", "overlap", ORDER_RANDOM, 0, bench_overlap);
+    bench_run(&cfg, "itree", "stab_scan", ORDER_RANDOM, 1, bench_stab_scan);
+    bench_run(&cfg, "itree", "delete", ORDER_RANDOM, 0, bench_delete);
+    return 0;
+}
@@ -0,0 +1,310 @@
+// Benchmarks for the queue: insertion, supression, peek and an enqueue/dequeue churn mix,
+// and the same on the small queue, plus many short-lived queues of a few elements, rolling
+// min/max over the last 1024 values (window queue vs a rescan of the queue), and a producer
+// thread handing values to a consumer that blocks, waits on epoll or busy-polls
+#include <pthread.h>
+#include <sys/epoll.h>
+#include "ds_queue.h"
+#include "ds_bqueue.h"
+
+#include "bench.h"
+
+static struct queue bench_q;
+
+static long bench_insertion(long n, const int* keys, struct bench_clock* clk) {
+    long i;
+    queue_init(&bench_q);
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        queue_insertion(&bench_q, keys[i]);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_supression(long n, const int* keys, struct bench_clock* clk) {
+    long i;
+    queue_init(&bench_q);
+    for (i = 0; i < n; i++) {
+        queue_insertion(&bench_q, keys[i]);
+    }
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        queue_supression(&bench_q, NULL);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_peek(long n, const int* keys, struct bench_clock* clk) {
+    long i;
+    int val = 0;
+    queue_init(&bench_q);
+    queue_insertion(&bench_q, keys[0]);
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        queue_peek(&bench_q, &val);
+        bench_consume(val);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_free_queue(long n, const int* keys, struct bench_clock* clk) {
+    long i;
+    queue_init(&bench_q);
+    for (i = 0; i < n; i++) {
+        queue_insertion(&bench_q, keys[i]);
+    }
+    bench_start(clk);
+    queue_free(&bench_q);
+    bench_stop(clk);
+    return n;
+}
+
+// Preload n/2 elements, then n operations that enqueue or dequeue with equal odds
+static long bench_churn(long n, const int* keys, struct bench_clock* clk) {
+    long i;
+    queue_init(&bench_q);
+    for (i = 0; i < n / 2; i++) {
+        queue_insertion(&bench_q, keys[i]);
+    }
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        if (bench_rand() & 1) {
+            queue_insertion(&bench_q, keys[i]);
+        } else {
+            queue_supression(&bench_q, NULL);
+        }
+    }
+    bench_stop(clk);
+    return n;
+}
+
+// A queue of SHORT_LIVED elements is filled and drained again and again, n
+// insertions and n supressions in all
+#define SHORT_LIVED 8
+
+static long bench_short_lived(long n, const int* keys, struct bench_clock* clk) {
+    struct queue q;
+    long i;
+    int j;
+    bench_start(clk);
+    for (i = 0; i + SHORT_LIVED <= n; i += SHORT_LIVED) {
+        queue_init(&q);
+        for (j = 0; j < SHORT_LIVED; j++) {
+            queue_insertion(&q, keys[i + j]);
+        }
+        while (queue_supression(&q, NULL) == DS_OK) {
+        }
+    }
+    bench_stop(clk);
+    return n - n % SHORT_LIVED;
+}
+
+static long bench_small_short_lived(long n, const int* keys, struct bench_clock* clk) {
+    struct small_queue q;
+    long sum = 0, i;
+    int j, val;
+    bench_start(clk);
+    for (i = 0; i + SHORT_LIVED <= n; i += SHORT_LIVED) {
+        small_queue_init(&q);
+        for (j = 0; j < SHORT_LIVED; j++) {
+            small_queue_insertion(&q, keys[i + j]);
+        }
+        while (small_queue_supression(&q, &val) == DS_OK) {
+            sum += val;
+        }
+        small_queue_free(&q);
+    }
+    bench_stop(clk);
+    bench_consume(sum);
+    return n - n % SHORT_LIVED;
+}
+
+// n insertions into one small queue, so all but the first few spill to the heap ring
+static long bench_small_insertion(long n, const int* keys, struct bench_clock* clk) {
+    struct small_queue q;
+    long i;
+    small_queue_init(&q);
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        small_queue_insertion(&q, keys[i]);
+    }
+    bench_stop(clk);
+    small_queue_free(&q);
+    return n;
+}
+
+static long bench_small_churn(long n, const int* keys, struct bench_clock* clk) {
+    struct small_queue q;
+    long sum = 0, i;
+    int val;
+    small_queue_init(&q);
+    for (i = 0; i < n / 2; i++) {
+        small_queue_insertion(&q, keys[i]);
+    }
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        if (bench_rand() & 1) {
+            small_queue_insertion(&q, keys[i]);
+        } else if (small_queue_supression(&q, &val) == DS_OK) {
+            sum += val;
+        }
+    }
+    bench_stop(clk);
+    bench_consume(sum);
+    small_queue_free(&q);
+    return n;
+}
+
+#define BENCH_WINDOW 1024
+
+// Push every value and read the min and max of the last BENCH_WINDOW values
+static long bench_window_minmax(long n, const int* keys, struct bench_clock* clk) {
+    struct window_queue w;
+    long sum = 0, i;
+    int lo = 0, hi = 0;
+    if (window_queue_init(&w, BENCH_WINDOW, 0) != DS_OK) {
+        return 0;
+    }
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        window_queue_insertion(&w, keys[i], 0);
+        window_queue_min(&w, &lo);
+        window_queue_max(&w, &hi);
+        sum += hi - lo;
+    }
+    bench_stop(clk);
+    bench_consume(sum);
+    window_queue_free(&w);
+    return n;
+}
+
+// The same with the plain queue, rescanning the window for every value
+static long bench_rescan_minmax(long n, const int* keys, struct bench_clock* clk) {
+    struct queue_node* node;
+    long sum = 0, size = 0, i;
+    int lo, hi;
+    queue_init(&bench_q);
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        queue_insertion(&bench_q, keys[i]);
+        if (++size > BENCH_WINDOW) {
+            queue_supression(&bench_q, NULL);
+            size--;
+        }
+        lo = hi = bench_q.front->data;
+        for (node = bench_q.front; node != NULL; node = node->next) {
+            lo = node->data < lo ? node->data : lo;
+            hi = node->data > hi ? node->data : hi;
+        }
+        sum += hi - lo;
+    }
+    bench_stop(clk);
+    bench_consume(sum);
+    queue_free(&bench_q);
+    return n;
+}
+
+static struct bqueue bench_bq;
+
+struct bench_producer {
+    pthread_t thread;
+    long n;
+    const int* keys;
+};
+
+static void* bench_produce(void* arg) {
+    struct bench_producer* p = (struct bench_producer*)arg;
+    long i;
+    for (i = 0; i < p->n; i++) {
+        bqueue_push(&bench_bq, p->keys[i]);
+    }
+    return NULL;
+}
+
+// Time from the first push to the last value taken; mode 0 blocks in
+// bqueue_pop(), 1 waits on the eventfd with epoll, 2 spins on an empty queue
+static long bench_handoff(long n, const int* keys, struct bench_clock* clk, int mode) {
+    struct bench_producer producer;
+    struct epoll_event ev;
+    long sum = 0, taken = 0;
+    int val, ep = -1;
+
+    bqueue_init(&bench_bq);
+    if (mode == 1) {
+        ev.events = EPOLLIN;
+        ev.data.ptr = NULL;
+        ep = epoll_create1(0);
+        if (ep < 0 || bqueue_open_eventfd(&bench_bq) != DS_OK ||
+            epoll_ctl(ep, EPOLL_CTL_ADD, bqueue_event_fd(&bench_bq), &ev) != 0) {
+            if (ep >= 0) {
+                close(ep);
+            }
+            bqueue_free(&bench_bq);
+            return 0;
+        }
+    }
+    producer.n = n;
+    producer.keys = keys;
+    bench_start(clk);
+    if (pthread_create(&producer.thread, NULL, bench_produce, &producer) != 0) {
+        bench_stop(clk);
+        return 0;
+    }
+    while (taken < n) {
+        if (mode == 1) {
+            if (epoll_wait(ep, &ev, 1, -1) < 1) {
+                continue;
+            }
+            bqueue_ack_event(&bench_bq);
+        }
+        while (taken < n && bqueue_pop(&bench_bq, &val, mode == 0 ? -1 : 0) == DS_OK) {
+            sum += val;
+            taken++;
+        }
+    }
+    bench_stop(clk);
+    pthread_join(producer.thread, NULL);
+    bench_consume(sum);
+    if (ep >= 0) {
+        close(ep);
+    }
+    bqueue_free(&bench_bq);
+    return n;
+}
+
+static long bench_handoff_blocking(long n, const int* keys, struct bench_clock* clk) {
+    return bench_handoff(n, keys, clk, 0);
+}
+
+static long bench_handoff_eventfd(long n, const int* keys, struct bench_clock* clk) {
+    return bench_handoff(n, keys, clk, 1);
+}
+
+static long bench_handoff_poll(long n, const int* keys, struct bench_clock* clk) {
+    return bench_handoff(n, keys, clk, 2);
+}
+
+int main(int argc, char* argv[]) {
+    struct bench_config cfg;
+    if (bench_init(&cfg, argc, argv) != 0) {
+        return 1;
+    }
+    bench_run(&cfg, "queue", "insertion", ORDER_RANDOM, 0, bench_insertion);
+    bench_run(&cfg, "queue", "supression", ORDER_RANDOM, 0, bench_supression);
+    bench_run(&cfg, "queue", "peek", ORDER_RANDOM, 0, bench_peek);
+    bench_run(&cfg, "queue", "free_queue", ORDER_RANDOM, 0, bench_free_queue);
+    bench_run(&cfg, "queue", "churn", ORDER_RANDOM, 0, bench_churn);
+    bench_run(&cfg, "queue", "short_lived", ORDER_RANDOM, 0, bench_short_lived);
+    bench_run(&cfg, "small_queue", "insertion", ORDER_RANDOM, 0, bench_small_insertion);
+    bench_run(&cfg, "small_queue", "churn", ORDER_RANDOM, 0, bench_small_churn);
+    bench_run(&cfg, "small_queue", "short_lived", ORDER_RANDOM, 0, bench_small_short_lived);
+    bench_run(&cfg, "queue", "rescan_minmax", ORDER_RANDOM, 0, bench_rescan_minmax);
+    bench_run(&cfg, "window_queue", "insertion_minmax", ORDER_RANDOM, 0, bench_window_minmax);
+    bench_run(&cfg, "bqueue", "handoff_blocking", ORDER_RANDOM, 0, bench_handoff_blocking);
+    bench_run(&cfg, "bqueue", "handoff_eventfd", ORDER_RANDOM, 0, bench_handoff_eventfd);
+    bench_run(&cfg, "bqueue", "handoff_poll", ORDER_RANDOM, 0, bench_handoff_poll);
+    return 0;
+}
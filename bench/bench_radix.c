@@ -0,0 +1,120 @@
+// Benchmarks for the radix tree: the same insert / search rows as bench_tree for
+// every key order, where the radix tree always walks 4 levels, plus delete,
+// successor queries and an in-order walk. Search results go to bench_consume(),
+// otherwise link-time optimization drops the calls
+#include "ds_radix.h"
+
+#include "bench.h"
+
+static struct radix_tree bench_build(long n, const int* keys) {
+    struct radix_tree t;
+    long i;
+    radix_init(&t);
+    for (i = 0; i < n; i++) {
+        radix_insert(&t, keys[i]);
+    }
+    return t;
+}
+
+static long bench_insert(long n, const int* keys, struct bench_clock* clk) {
+    struct radix_tree t;
+    bench_start(clk);
+    t = bench_build(n, keys);
+    bench_stop(clk);
+    radix_free(&t);
+    return n;
+}
+
+static long bench_search_hit(long n, const int* keys, struct bench_clock* clk) {
+    struct radix_tree t = bench_build(n, keys);
+    long hits = 0, i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        hits += radix_search(&t, keys[(i * 7919) % n]);
+    }
+    bench_stop(clk);
+    bench_consume(hits);
+    radix_free(&t);
+    return n;
+}
+
+// Keys are 0..n-1, so shifting by n makes every lookup miss
+static long bench_search_miss(long n, const int* keys, struct bench_clock* clk) {
+    struct radix_tree t = bench_build(n, keys);
+    long hits = 0, i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        hits += radix_search(&t, keys[i] + (int)n);
+    }
+    bench_stop(clk);
+    bench_consume(hits);
+    radix_free(&t);
+    return n;
+}
+
+static long bench_delete(long n, const int* keys, struct bench_clock* clk) {
+    struct radix_tree t = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        radix_delete(&t, keys[(i * 7919) % n]);
+    }
+    bench_stop(clk);
+    radix_free(&t);
+    return n;
+}
+
+// Only the even keys are stored, so half the queries have to move on to the next key
+static long bench_successor(long n, const int* keys, struct bench_clock* clk) {
+    struct radix_tree t;
+    int next;
+    long i;
+    radix_init(&t);
+    for (i = 0; i < n; i++) {
+        if (keys[i] % 2 == 0) {
+            radix_insert(&t, keys[i]);
+        }
+    }
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        if (radix_successor(&t, keys[(i * 7919) % n], &next) == DS_OK) {
+            bench_consume(next);
+        }
+    }
+    bench_stop(clk);
+    radix_free(&t);
+    return n;
+}
+
+static void bench_visit(int val, void* ctx) {
+    *(long*)ctx += val;
+}
+
+static long bench_inorder(long n, const int* keys, struct bench_clock* clk) {
+    struct radix_tree t = bench_build(n, keys);
+    long sum = 0;
+    bench_start(clk);
+    radix_inorder(&t, bench_visit, &sum);
+    bench_stop(clk);
+    bench_consume(sum);
+    radix_free(&t);
+    return n;
+}
+
+int main(int argc, char* argv[]) {
+    struct bench_config cfg;
+    if (bench_init(&cfg, argc, argv) != 0) {
+        return 1;
+    }
+    bench_run(&cfg, "radix", "insert", ORDER_RANDOM, 0, bench_insert);
+    bench_run(&cfg, "radix", "insert", ORDER_SORTED, 0, bench_insert);
+    bench_run(&cfg, "radix", "insert", ORDER_ADVERSARIAL, 0, bench_insert);
+    bench_run(&cfg, "radix", "search_hit", ORDER_RANDOM, 0, bench_search_hit);
+    bench_run(&cfg, "radix", "search_hit", ORDER_SORTED, 0, bench_search_hit);
+    bench_run(&cfg, "radix", "search_miss", ORDER_RANDOM, 0, bench_search_miss);
+    bench_run(&cfg, "radix", "search_miss", ORDER_ADVERSARIAL, 0, bench_search_miss);
+    bench_run(&cfg, "radix", "delete", ORDER_RANDOM, 0, bench_delete);
+    bench_run(&cfg, "radix", "successor", ORDER_RANDOM, 0, bench_successor);
+    bench_run(&cfg, "radix", "inorder", ORDER_RANDOM, 0, bench_inorder);
+    return 0;
+}
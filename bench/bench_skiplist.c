@@ -0,0 +1,161 @@
+// Benchmarks for the skip lists: sequential insert/search/delete, and a mixed
+// workload on the lock-free variant with 1, 2, 4, ... threads up to --threads
+// (the core count by default, at most CSKIPLIST_MAX_THREADS)
+#include <pthread.h>
+#include "ds_skiplist.h"
+
+#include "bench.h"
+
+static struct skiplist bench_build(long n, const int* keys) {
+    struct skiplist sl;
+    long i;
+    skiplist_init(&sl);
+    for (i = 0; i < n; i++) {
+        skiplist_insert(&sl, keys[i]);
+    }
+    return sl;
+}
+
+static long bench_insert(long n, const int* keys, struct bench_clock* clk) {
+    bench_start(clk);
+    bench_build(n, keys);
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_search_hit(long n, const int* keys, struct bench_clock* clk) {
+    struct skiplist sl = bench_build(n, keys);
+    long found = 0, i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        found += skiplist_search(&sl, keys[(i * 7919) % n]);
+    }
+    bench_stop(clk);
+    bench_consume(found);
+    return n;
+}
+
+// Keys are 0..n-1, so shifting by n makes every lookup miss
+static long bench_search_miss(long n, const int* keys, struct bench_clock* clk) {
+    struct skiplist sl = bench_build(n, keys);
+    long found = 0, i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        found += skiplist_search(&sl, keys[i] + (int)n);
+    }
+    bench_stop(clk);
+    bench_consume(found);
+    return n;
+}
+
+static long bench_delete(long n, const int* keys, struct bench_clock* clk) {
+    struct skiplist sl = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        skiplist_delete(&sl, keys[(i * 7919) % n]);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+// Lock-free workload: the list starts with every even key, then each thread
+// runs its share of n operations, 80% searches, 10% inserts, 10% deletes
+static struct cskiplist bench_csl;
+static int bench_threads;
+
+struct bench_worker {
+    pthread_t thread;
+    long ops;
+    long n;
+    const int* keys;
+    unsigned long long seed;
+};
+
+static void* bench_worker_run(void* arg) {
+    struct bench_worker* w = (struct bench_worker*)arg;
+    int slot = cskiplist_register(&bench_csl);
+    long hits = 0, i;
+    if (slot < 0) {
+        return NULL;
+    }
+    for (i = 0; i < w->ops; i++) {
+        unsigned long long r;
+        int key;
+        w->seed ^= w->seed >> 12;
+        w->seed ^= w->seed << 25;
+        w->seed ^= w->seed >> 27;
+        r = w->seed * 2685821657736338717ULL;
+        key = w->keys[(r >> 8) % (unsigned long long)w->n];
+        if (r % 10 == 0) {
+            cskiplist_insert(&bench_csl, slot, key);
+        } else if (r % 10 == 1) {
+            cskiplist_delete(&bench_csl, slot, key);
+        } else {
+            hits += cskiplist_search(&bench_csl, slot, key);
+        }
+    }
+    bench_consume(hits);
+    cskiplist_unregister(&bench_csl, slot);
+    return NULL;
+}
+
+static long bench_concurrent_mix(long n, const int* keys, struct bench_clock* clk) {
+    struct bench_worker* workers = (struct bench_worker*)malloc((size_t)bench_threads * sizeof(struct bench_worker));
+    long i;
+    int slot;
+    if (workers == NULL) {
+        return 0;
+    }
+    cskiplist_init(&bench_csl);
+    slot = cskiplist_register(&bench_csl);
+    for (i = 0; i < n; i++) {
+        if (keys[i] % 2 == 0) {
+            cskiplist_insert(&bench_csl, slot, keys[i]);
+        }
+    }
+    cskiplist_unregister(&bench_csl, slot);
+    for (i = 0; i < bench_threads; i++) {
+        workers[i].ops = n / bench_threads;
+        workers[i].n = n;
+        workers[i].keys = keys;
+        workers[i].seed = 0x9E3779B97F4A7C15ULL * (unsigned long long)(i + 1);
+    }
+    bench_start(clk);
+    for (i = 0; i < bench_threads; i++) {
+        pthread_create(&workers[i].thread, NULL, bench_worker_run, &workers[i]);
+    }
+    for (i = 0; i < bench_threads; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+    bench_stop(clk);
+    cskiplist_free(&bench_csl);
+    free(workers);
+    return (n / bench_threads) * bench_threads;
+}
+
+int main(int argc, char* argv[]) {
+    struct bench_config cfg;
+    int most;
+    char name[32];
+    if (bench_init(&cfg, argc, argv) != 0) {
+        return 1;
+    }
+    most = cfg.threads < CSKIPLIST_MAX_THREADS ? cfg.threads : CSKIPLIST_MAX_THREADS;  // one slot each
+    bench_run(&cfg, "skiplist", "insert", ORDER_RANDOM, 0, bench_insert);
+    bench_run(&cfg, "skiplist", "insert", ORDER_SORTED, 0, bench_insert);
+    bench_run(&cfg, "skiplist", "search_hit", ORDER_RANDOM, 0, bench_search_hit);
+    bench_run(&cfg, "skiplist", "search_miss", ORDER_RANDOM, 0, bench_search_miss);
+    bench_run(&cfg, "skiplist", "delete", ORDER_RANDOM, 0, bench_delete);
+    for (bench_threads = 1;; bench_threads *= 2) {
+        if (bench_threads > most) {
+            bench_threads = most;
+        }
+        snprintf(name, sizeof(name), "concurrent_mix_t%d", bench_threads);
+        bench_run(&cfg, "cskiplist", name, ORDER_RANDOM, 0, bench_concurrent_mix);
+        if (bench_threads >= most) {
+            break;
+        }
+    }
+    return 0;
+}
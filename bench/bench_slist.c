@@ -0,0 +1,324 @@
+// Benchmarks for the singly linked list: insertion, deletion, search, sort and traversal,
+// including misses behind a Bloom filter and the scan of a scattered list before and after
+// slist_compact()
+#include "ds_slist.h"
+
+#include "bench.h"
+
+// Build the list in key order in O(n) by prepending from the back
+static struct slist_node* bench_build(long n, const int* keys) {
+    struct slist_node* head = NULL;
+    long i;
+    for (i = n - 1; i >= 0; i--) {
+        slist_add_beg(&head, keys[i]);
+    }
+    return head;
+}
+
+static long bench_add_beg(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = NULL;
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        slist_add_beg(&head, keys[i]);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_add_at_end(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = NULL;
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        slist_add_at_end(&head, keys[i]);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_insert_middle(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        slist_insert_at_position(&head, keys[i], (int)(n / 2));
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_delete_beg(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        slist_delete_beg(&head);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_delete_end(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        slist_delete_end(&head);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_delete_element(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        slist_delete_element(&head, (int)i);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_search_hit(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = bench_build(n, keys);
+    long found = 0, i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        found += slist_search_list(head, keys[(i * 7919) % n]);
+    }
+    bench_stop(clk);
+    bench_consume(found);
+    return n;
+}
+
+static long bench_search_miss(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = bench_build(n, keys);
+    long found = 0, i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        found += slist_search_list(head, keys[i] + (int)n);
+    }
+    bench_stop(clk);
+    bench_consume(found);
+    return n;
+}
+
+// Misses through a filter sized for 1% false positives, only those walk the list;
+// the list is built through slist_insert_filtered(), which keeps the filter up to date
+static long bench_search_miss_filtered(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = NULL;
+    struct ds_bloom filter;
+    long i;
+    if (ds_bloom_init(&filter, (uint32_t)n, 0.01) != DS_OK) {
+        return 0;
+    }
+    for (i = n - 1; i >= 0; i--) {
+        slist_insert_filtered(&head, &filter, keys[i]);
+    }
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        bench_consume(slist_search_filtered(head, &filter, keys[i] + (int)n));
+    }
+    bench_stop(clk);
+    ds_bloom_free(&filter);
+    return n;
+}
+
+// One call sorts the whole list, reported per element
+static long bench_arrange(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = bench_build(n, keys);
+    bench_start(clk);
+    slist_arrange_list(&head);
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_count(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = bench_build(n, keys);
+    bench_start(clk);
+    slist_count_of_nodes(head);
+    bench_stop(clk);
+    return n;
+}
+
+static void bench_visit(int val, void* ctx) {
+    *(long*)ctx += val;
+}
+
+static long bench_traverse(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = bench_build(n, keys);
+    long sum = 0;
+    bench_start(clk);
+    slist_traverse(head, bench_visit, &sum);
+    bench_stop(clk);
+    bench_consume(sum);
+    return n;
+}
+
+// A list whose nodes went through churn: the nodes are allocated interleaved
+// with as many others of the same size, the others are freed in random order,
+// and then every node is replaced (new one allocated, old one freed) in another
+// random order, so the allocator hands out the holes left behind. Node i holds
+// key i and the list is linked in key order, so a scan jumps around the heap
+static struct slist_node* bench_build_scattered(long n, const int* keys) {
+    struct slist_node** nodes = (struct slist_node**)malloc((size_t)n * sizeof(struct slist_node*));
+    struct slist_node** others = (struct slist_node**)malloc((size_t)n * sizeof(struct slist_node*));
+    struct slist_node* head = NULL;
+    long i;
+    if (nodes == NULL || others == NULL) {
+        exit(2);
+    }
+    for (i = 0; i < n; i++) {
+        nodes[i] = (struct slist_node*)malloc(sizeof(struct slist_node));
+        others[i] = (struct slist_node*)malloc(sizeof(struct slist_node));
+    }
+    for (i = 0; i < n; i++) {
+        free(others[keys[i]]);
+    }
+    for (i = 0; i < n; i++) {
+        struct slist_node* node = (struct slist_node*)malloc(sizeof(struct slist_node));
+        free(nodes[keys[n - 1 - i]]);
+        nodes[keys[n - 1 - i]] = node;
+    }
+    for (i = n - 1; i >= 0; i--) {
+        nodes[i]->data = (int)i;
+        nodes[i]->slot = 0;
+        nodes[i]->link = head;
+        head = nodes[i];
+    }
+    free(others);
+    free(nodes);
+    return head;
+}
+
+static long bench_traverse_scattered(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = bench_build_scattered(n, keys);
+    long sum = 0;
+    bench_start(clk);
+    slist_traverse(head, bench_visit, &sum);
+    bench_stop(clk);
+    bench_consume(sum);
+    slist_delete_entire_list(&head);
+    return n;
+}
+
+static long bench_compact(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = bench_build_scattered(n, keys);
+    bench_start(clk);
+    slist_compact(&head);
+    bench_stop(clk);
+    slist_delete_entire_list(&head);
+    return n;
+}
+
+// The same scattered list, scanned after slist_compact()
+static long bench_traverse_compacted(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = bench_build_scattered(n, keys);
+    long sum = 0;
+    slist_compact(&head);
+    bench_start(clk);
+    slist_traverse(head, bench_visit, &sum);
+    bench_stop(clk);
+    bench_consume(sum);
+    slist_delete_entire_list(&head);
+    return n;
+}
+
+// Purge a tenth of the values: one pass over the list plus one hash-set probe per node
+static long bench_remove_all(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = bench_build(n, keys);
+    int count = (int)(n / 10 ? n / 10 : 1);
+    int* values = (int*)malloc((size_t)count * sizeof(int));
+    int i;
+    if (values == NULL) {
+        exit(2);
+    }
+    for (i = 0; i < count; i++) {
+        values[i] = i * 10;
+    }
+    bench_start(clk);
+    slist_remove_all(&head, values, count);
+    bench_stop(clk);
+    free(values);
+    slist_delete_entire_list(&head);
+    return n;
+}
+
+static int bench_is_odd(int val, void* ctx) {
+    (void)ctx;
+    return val & 1;
+}
+
+static long bench_remove_if(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = bench_build(n, keys);
+    bench_start(clk);
+    slist_remove_if(&head, bench_is_odd, NULL);
+    bench_stop(clk);
+    slist_delete_entire_list(&head);
+    return n;
+}
+
+static long bench_reverse(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = bench_build(n, keys);
+    bench_start(clk);
+    slist_reverse(&head);
+    bench_stop(clk);
+    slist_delete_entire_list(&head);
+    return n;
+}
+
+// Merge the even and the odd values below n, interleaving every node
+static long bench_merge_sorted(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node *evens = NULL, *odds = NULL;
+    long i;
+    (void)keys;
+    for (i = n - 1; i >= 0; i--) {
+        slist_add_beg(i % 2 ? &odds : &evens, (int)i);
+    }
+    bench_start(clk);
+    slist_merge_sorted(&evens, &odds);
+    bench_stop(clk);
+    slist_delete_entire_list(&evens);
+    return n;
+}
+
+static long bench_delete_entire(long n, const int* keys, struct bench_clock* clk) {
+    struct slist_node* head = bench_build(n, keys);
+    bench_start(clk);
+    slist_delete_entire_list(&head);
+    bench_stop(clk);
+    return n;
+}
+
+int main(int argc, char* argv[]) {
+    struct bench_config cfg;
+    if (bench_init(&cfg, argc, argv) != 0) {
+        return 1;
+    }
+    bench_run(&cfg, "slist", "add_beg", ORDER_RANDOM, 0, bench_add_beg);
+    bench_run(&cfg, "slist", "add_at_end", ORDER_RANDOM, 1, bench_add_at_end);
+    bench_run(&cfg, "slist", "insert_at_position", ORDER_RANDOM, 1, bench_insert_middle);
+    bench_run(&cfg, "slist", "delete_beg", ORDER_RANDOM, 0, bench_delete_beg);
+    bench_run(&cfg, "slist", "delete_end", ORDER_RANDOM, 1, bench_delete_end);
+    bench_run(&cfg, "slist", "delete_element", ORDER_RANDOM, 1, bench_delete_element);
+    bench_run(&cfg, "slist", "delete_element", ORDER_SORTED, 1, bench_delete_element);
+    bench_run(&cfg, "slist", "search_list_hit", ORDER_RANDOM, 1, bench_search_hit);
+    bench_run(&cfg, "slist", "search_list_miss", ORDER_RANDOM, 1, bench_search_miss);
+    bench_run(&cfg, "slist", "search_list_miss_filtered", ORDER_RANDOM, 1, bench_search_miss_filtered);
+    bench_run(&cfg, "slist", "arrange_list", ORDER_SORTED, 1, bench_arrange);
+    bench_run(&cfg, "slist", "arrange_list", ORDER_RANDOM, 1, bench_arrange);
+    bench_run(&cfg, "slist", "arrange_list", ORDER_ADVERSARIAL, 1, bench_arrange);
+    bench_run(&cfg, "slist", "count_of_nodes", ORDER_RANDOM, 0, bench_count);
+    bench_run(&cfg, "slist", "traverse", ORDER_RANDOM, 0, bench_traverse);
+    bench_run(&cfg, "slist", "traverse_scattered", ORDER_RANDOM, 0, bench_traverse_scattered);
+    bench_run(&cfg, "slist", "compact", ORDER_RANDOM, 0, bench_compact);
+    bench_run(&cfg, "slist", "traverse_compacted", ORDER_RANDOM, 0, bench_traverse_compacted);
+    bench_run(&cfg, "slist", "remove_all", ORDER_RANDOM, 0, bench_remove_all);
+    bench_run(&cfg, "slist", "remove_if", ORDER_RANDOM, 0, bench_remove_if);
+    bench_run(&cfg, "slist", "reverse", ORDER_RANDOM, 0, bench_reverse);
+    bench_run(&cfg, "slist", "merge_sorted", ORDER_SORTED, 0, bench_merge_sorted);
+    bench_run(&cfg, "slist", "delete_entire_list", ORDER_RANDOM, 0, bench_delete_entire);
+    return 0;
+}
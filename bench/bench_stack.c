@@ -0,0 +1,220 @@
+// Benchmarks for the stack: push, pop, peek and a push/pop churn mix, and the
+// same on the small stack, plus many short-lived stacks of a few elements, and
+// the churn with a min/max/sum query after every operation, walking the linked
+// stack vs reading the aggregate stack
+#include "ds_stack.h"
+#include "bench.h"
+
+static struct stack bench_s;
+
+static long bench_push(long n, const int* keys, struct bench_clock* clk) {
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        stack_push(&bench_s, keys[i]);
+    }
+    bench_stop(clk);
+    stack_clear(&bench_s);
+    return n;
+}
+
+static long bench_pop(long n, const int* keys, struct bench_clock* clk) {
+    long i;
+    for (i = 0; i < n; i++) {
+        stack_push(&bench_s, keys[i]);
+    }
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        stack_pop(&bench_s, NULL);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_peek(long n, const int* keys, struct bench_clock* clk) {
+    long i;
+    int val = 0;
+    stack_push(&bench_s, keys[0]);
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        stack_peek(&bench_s, &val);
+        bench_consume(val);
+    }
+    bench_stop(clk);
+    stack_clear(&bench_s);
+    return n;
+}
+
+// Preload n/2 elements, then n operations that push or pop with equal odds
+static long bench_churn(long n, const int* keys, struct bench_clock* clk) {
+    long i;
+    for (i = 0; i < n / 2; i++) {
+        stack_push(&bench_s, keys[i]);
+    }
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        if (bench_rand() & 1) {
+            stack_push(&bench_s, keys[i]);
+        } else {
+            stack_pop(&bench_s, NULL);
+        }
+    }
+    bench_stop(clk);
+    stack_clear(&bench_s);
+    return n;
+}
+
+// A stack of SHORT_LIVED elements is built and emptied again and again, n
+// pushes and n pops in all
+#define SHORT_LIVED 8
+
+static long bench_short_lived(long n, const int* keys, struct bench_clock* clk) {
+    struct stack s;
+    long i;
+    int j;
+    bench_start(clk);
+    for (i = 0; i + SHORT_LIVED <= n; i += SHORT_LIVED) {
+        stack_init(&s);
+        for (j = 0; j < SHORT_LIVED; j++) {
+            stack_push(&s, keys[i + j]);
+        }
+        while (stack_pop(&s, NULL) == DS_OK) {
+        }
+    }
+    bench_stop(clk);
+    return n - n % SHORT_LIVED;
+}
+
+static long bench_small_short_lived(long n, const int* keys, struct bench_clock* clk) {
+    struct small_stack s;
+    long sum = 0, i;
+    int j, val;
+    bench_start(clk);
+    for (i = 0; i + SHORT_LIVED <= n; i += SHORT_LIVED) {
+        small_stack_init(&s);
+        for (j = 0; j < SHORT_LIVED; j++) {
+            small_stack_push(&s, keys[i + j]);
+        }
+        while (small_stack_pop(&s, &val) == DS_OK) {
+            sum += val;
+        }
+        small_stack_clear(&s);
+    }
+    bench_stop(clk);
+    bench_consume(sum);
+    return n - n % SHORT_LIVED;
+}
+
+// n pushes onto one small stack, so all but the first few spill to the heap array
+static long bench_small_push(long n, const int* keys, struct bench_clock* clk) {
+    struct small_stack s;
+    long i;
+    small_stack_init(&s);
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        small_stack_push(&s, keys[i]);
+    }
+    bench_stop(clk);
+    small_stack_clear(&s);
+    return n;
+}
+
+static long bench_small_churn(long n, const int* keys, struct bench_clock* clk) {
+    struct small_stack s;
+    long sum = 0, i;
+    int val;
+    small_stack_init(&s);
+    for (i = 0; i < n / 2; i++) {
+        small_stack_push(&s, keys[i]);
+    }
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        if (bench_rand() & 1) {
+            small_stack_push(&s, keys[i]);
+        } else if (small_stack_pop(&s, &val) == DS_OK) {
+            sum += val;
+        }
+    }
+    bench_stop(clk);
+    bench_consume(sum);
+    small_stack_clear(&s);
+    return n;
+}
+
+// The churn mix, reading the min, max and sum of the whole stack after every
+// push or pop; the linked stack has to walk all of it for that
+static long bench_churn_minmax(long n, const int* keys, struct bench_clock* clk) {
+    struct stack_node* ptr;
+    long long total = 0, sum;
+    long i;
+    int lo, hi;
+    for (i = 0; i < n / 2; i++) {
+        stack_push(&bench_s, keys[i]);
+    }
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        if (bench_rand() & 1) {
+            stack_push(&bench_s, keys[i]);
+        } else {
+            stack_pop(&bench_s, NULL);
+        }
+        if (bench_s.top != NULL) {
+            lo = hi = bench_s.top->data;
+            sum = 0;
+            for (ptr = bench_s.top; ptr != NULL; ptr = ptr->next) {
+                lo = ptr->data < lo ? ptr->data : lo;
+                hi = ptr->data > hi ? ptr->data : hi;
+                sum += ptr->data;
+            }
+            total += hi - lo + sum;
+        }
+    }
+    bench_stop(clk);
+    bench_consume(total);
+    stack_clear(&bench_s);
+    return n;
+}
+
+static long bench_agg_churn_minmax(long n, const int* keys, struct bench_clock* clk) {
+    struct agg_stack s;
+    long long total = 0;
+    long i;
+    int lo, hi;
+    agg_stack_init(&s);
+    for (i = 0; i < n / 2; i++) {
+        agg_stack_push(&s, keys[i]);
+    }
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        if (bench_rand() & 1) {
+            agg_stack_push(&s, keys[i]);
+        } else {
+            agg_stack_pop(&s, NULL);
+        }
+        if (agg_stack_min(&s, &lo) == DS_OK && agg_stack_max(&s, &hi) == DS_OK) {
+            total += hi - lo + agg_stack_sum(&s);
+        }
+    }
+    bench_stop(clk);
+    bench_consume(total);
+    agg_stack_clear(&s);
+    return n;
+}
+
+int main(int argc, char* argv[]) {
+    struct bench_config cfg;
+    if (bench_init(&cfg, argc, argv) != 0) {
+        return 1;
+    }
+    bench_run(&cfg, "stack", "push", ORDER_RANDOM, 0, bench_push);
+    bench_run(&cfg, "stack", "pop", ORDER_RANDOM, 0, bench_pop);
+    bench_run(&cfg, "stack", "peek", ORDER_RANDOM, 0, bench_peek);
+    bench_run(&cfg, "stack", "churn", ORDER_RANDOM, 0, bench_churn);
+    bench_run(&cfg, "stack", "short_lived", ORDER_RANDOM, 0, bench_short_lived);
+    bench_run(&cfg, "small_stack", "push", ORDER_RANDOM, 0, bench_small_push);
+    bench_run(&cfg, "small_stack", "churn", ORDER_RANDOM, 0, bench_small_churn);
+    bench_run(&cfg, "small_stack", "short_lived", ORDER_RANDOM, 0, bench_small_short_lived);
+    bench_run(&cfg, "stack", "churn_minmax", ORDER_RANDOM, 1, bench_churn_minmax);
+    bench_run(&cfg, "agg_stack", "churn_minmax", ORDER_RANDOM, 0, bench_agg_churn_minmax);
+    return 0;
+}
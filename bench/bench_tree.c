@@ -0,0 +1,298 @@
+// Benchmarks for the binary search tree: insert and search (hits and misses) for every key order,
+// batched searches, delete, arena-backed insert, delete/insert churn and teardown, searches
+// behind a Bloom filter, and the same operations on the persistent tree, whose updates copy the
+// search path. Search results go to bench_consume(), or link-time optimisation drops
+// the calls
+#include "ds_tree.h"
+#include "ds_ptree.h"
+
+#include "bench.h"
+
+static struct tree_node* bench_build(long n, const int* keys) {
+    struct tree_node* root = NULL;
+    long i;
+    for (i = 0; i < n; i++) {
+        root = tree_insert(root, keys[i]);
+    }
+    return root;
+}
+
+static long bench_insert(long n, const int* keys, struct bench_clock* clk) {
+    bench_start(clk);
+    bench_build(n, keys);
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_search_hit(long n, const int* keys, struct bench_clock* clk) {
+    struct tree_node* root = bench_build(n, keys);
+    long i, hits = 0;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        hits += tree_search(root, keys[(i * 7919) % n]);
+    }
+    bench_stop(clk);
+    bench_consume(hits);
+    return n;
+}
+
+// The same lookups handed to tree_search_batch() in groups of 1024 keys
+static long bench_search_hit_batch(long n, const int* keys, struct bench_clock* clk) {
+    struct tree_node* root = bench_build(n, keys);
+    int* lookups = (int*)malloc((size_t)n * sizeof(int));
+    uint8_t found[1024];
+    long i, hits = 0;
+    if (lookups == NULL) {
+        return 0;
+    }
+    for (i = 0; i < n; i++) {
+        lookups[i] = keys[(i * 7919) % n];
+    }
+    bench_start(clk);
+    for (i = 0; i < n; i += 1024) {
+        hits += tree_search_batch(root, lookups + i, n - i < 1024 ? n - i : 1024, found);
+    }
+    bench_stop(clk);
+    bench_consume(hits);
+    free(lookups);
+    return n;
+}
+
+// Keys are 0..n-1, so shifting by n makes every lookup miss
+static long bench_search_miss(long n, const int* keys, struct bench_clock* clk) {
+    struct tree_node* root = bench_build(n, keys);
+    long i, hits = 0;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        hits += tree_search(root, keys[i] + (int)n);
+    }
+    bench_stop(clk);
+    bench_consume(hits);
+    return n;
+}
+
+// Misses above the largest key only walk the right spine, which stays in cache.
+// These rows build the tree from the even keys 2k and miss with the odd keys
+// 2k + 1, which end at a leaf like a hit, with and without a filter sized for
+// 1% false positives. Filtered hits pay for the filter on top of the walk.
+static long bench_search_sparse(long n, const int* keys, struct bench_clock* clk, int miss, int filtered) {
+    struct tree_node* root = NULL;
+    struct ds_bloom filter;
+    long i, hits = 0;
+    for (i = 0; i < n; i++) {
+        root = tree_insert(root, 2 * keys[i]);
+    }
+    if (filtered) {
+        if (ds_bloom_init(&filter, (uint32_t)n, 0.01) != DS_OK) {
+            return 0;
+        }
+        tree_fill_filter(root, &filter);
+    }
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        int val = 2 * keys[(i * 7919) % n] + miss;
+        hits += filtered ? tree_search_filtered(root, &filter, val) : tree_search(root, val);
+    }
+    bench_stop(clk);
+    bench_consume(hits);
+    if (filtered) {
+        ds_bloom_free(&filter);
+    }
+    return n;
+}
+
+static long bench_search_hit_filtered(long n, const int* keys, struct bench_clock* clk) {
+    return bench_search_sparse(n, keys, clk, 0, 1);
+}
+
+static long bench_search_miss_sparse(long n, const int* keys, struct bench_clock* clk) {
+    return bench_search_sparse(n, keys, clk, 1, 0);
+}
+
+static long bench_search_miss_sparse_filtered(long n, const int* keys, struct bench_clock* clk) {
+    return bench_search_sparse(n, keys, clk, 1, 1);
+}
+
+static long bench_delete(long n, const int* keys, struct bench_clock* clk) {
+    struct tree_node* root = bench_build(n, keys);
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        tree_delete(&root, NULL, keys[(i * 7919) % n]);
+    }
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_arena_insert(long n, const int* keys, struct bench_clock* clk) {
+    struct tree_arena arena;
+    struct tree_node* root = NULL;
+    long i;
+    tree_arena_init(&arena);
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        root = tree_arena_insert(root, &arena, keys[i]);
+    }
+    bench_stop(clk);
+    tree_arena_destroy(&arena);
+    return n;
+}
+
+// Delete a value and insert it back, n times: with an arena the freed node is
+// the one the insert gets back, without one it is a free() and a malloc()
+static long bench_churn(long n, const int* keys, struct bench_clock* clk, int use_arena) {
+    struct tree_arena arena;
+    struct tree_node* root = NULL;
+    long i;
+    int val;
+    tree_arena_init(&arena);
+    for (i = 0; i < n; i++) {
+        root = use_arena ? tree_arena_insert(root, &arena, keys[i]) : tree_insert(root, keys[i]);
+    }
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        val = keys[(i * 7919) % n];
+        tree_delete(&root, use_arena ? &arena : NULL, val);
+        root = use_arena ? tree_arena_insert(root, &arena, val) : tree_insert(root, val);
+    }
+    bench_stop(clk);
+    if (use_arena) {
+        tree_arena_destroy(&arena);
+    } else {
+        tree_free(root);
+    }
+    return n;
+}
+
+static long bench_churn_malloc(long n, const int* keys, struct bench_clock* clk) {
+    return bench_churn(n, keys, clk, 0);
+}
+
+static long bench_churn_arena(long n, const int* keys, struct bench_clock* clk) {
+    return bench_churn(n, keys, clk, 1);
+}
+
+// Releasing a whole tree, reported per node: tree_free() visits every node,
+// tree_arena_destroy() frees one chunk per doubling
+static long bench_free(long n, const int* keys, struct bench_clock* clk) {
+    struct tree_node* root = bench_build(n, keys);
+    bench_start(clk);
+    tree_free(root);
+    bench_stop(clk);
+    return n;
+}
+
+static long bench_arena_destroy(long n, const int* keys, struct bench_clock* clk) {
+    struct tree_arena arena;
+    struct tree_node* root = NULL;
+    long i;
+    tree_arena_init(&arena);
+    for (i = 0; i < n; i++) {
+        root = tree_arena_insert(root, &arena, keys[i]);
+    }
+    bench_start(clk);
+    tree_arena_destroy(&arena);
+    bench_stop(clk);
+    return n;
+}
+
+static struct ptree_node* bench_ptree_build(long n, const int* keys) {
+    struct ptree_node *version = NULL, *next;
+    long i;
+    for (i = 0; i < n; i++) {
+        if (ptree_insert(version, keys[i], &next) == DS_OK) {
+            ptree_release(version);
+            version = next;
+        }
+    }
+    return version;
+}
+
+static long bench_ptree_insert(long n, const int* keys, struct bench_clock* clk) {
+    struct ptree_node* version;
+    bench_start(clk);
+    version = bench_ptree_build(n, keys);
+    bench_stop(clk);
+    ptree_release(version);
+    return n;
+}
+
+// Keep every version alive: n snapshots share all but O(log n) nodes each
+static long bench_ptree_insert_keep(long n, const int* keys, struct bench_clock* clk) {
+    struct ptree_node** versions = (struct ptree_node**)malloc((size_t)(n + 1) * sizeof(struct ptree_node*));
+    long i;
+    if (versions == NULL) {
+        exit(2);
+    }
+    versions[0] = NULL;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        if (ptree_insert(versions[i], keys[i], &versions[i + 1]) != DS_OK) {
+            exit(2);
+        }
+    }
+    bench_stop(clk);
+    for (i = 0; i <= n; i++) {
+        ptree_release(versions[i]);
+    }
+    free(versions);
+    return n;
+}
+
+static long bench_ptree_search_hit(long n, const int* keys, struct bench_clock* clk) {
+    struct ptree_node* version = bench_ptree_build(n, keys);
+    long hits = 0, i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        hits += ptree_search(version, keys[(i * 7919) % n]);
+    }
+    bench_stop(clk);
+    bench_consume(hits);
+    ptree_release(version);
+    return n;
+}
+
+static long bench_ptree_delete(long n, const int* keys, struct bench_clock* clk) {
+    struct ptree_node *version = bench_ptree_build(n, keys), *next;
+    long i;
+    bench_start(clk);
+    for (i = 0; i < n; i++) {
+        if (ptree_delete(version, keys[(i * 7919) % n], &next) == DS_OK) {
+            ptree_release(version);
+            version = next;
+        }
+    }
+    bench_stop(clk);
+    ptree_release(version);
+    return n;
+}
+
+int main(int argc, char* argv[]) {
+    struct bench_config cfg;
+    if (bench_init(&cfg, argc, argv) != 0) {
+        return 1;
+    }
+    // Sorted and zigzag keys degenerate the tree into a list: O(n^2) and n deep recursion
+    bench_run(&cfg, "tree", "insert", ORDER_RANDOM, 0, bench_insert);
+    bench_run(&cfg, "tree", "insert", ORDER_SORTED, 1, bench_insert);
+    bench_run(&cfg, "tree", "insert", ORDER_ADVERSARIAL, 1, bench_insert);
+    bench_run(&cfg, "tree", "search_hit", ORDER_RANDOM, 0, bench_search_hit);
+    bench_run(&cfg, "tree", "search_hit", ORDER_SORTED, 1, bench_search_hit);
+    bench_run(&cfg, "tree", "search_hit_batch", ORDER_RANDOM, 0, bench_search_hit_batch);
+    bench_run(&cfg, "tree", "search_miss", ORDER_RANDOM, 0, bench_search_miss);
+    bench_run(&cfg, "tree", "search_miss", ORDER_ADVERSARIAL, 1, bench_search_miss);
+    bench_run(&cfg, "tree", "delete", ORDER_RANDOM, 0, bench_delete);
+    bench_run(&cfg, "tree", "arena_insert", ORDER_RANDOM, 0, bench_arena_insert);
+    bench_run(&cfg, "tree", "churn_malloc", ORDER_RANDOM, 0, bench_churn_malloc);
+    bench_run(&cfg, "tree", "churn_arena", ORDER_RANDOM, 0, bench_churn_arena);
+    bench_run(&cfg, "tree", "free", ORDER_RANDOM, 0, bench_free);
+    bench_run(&cfg, "tree", "arena_destroy", ORDER_RANDOM, 0, bench_arena_destroy);
+    bench_run(&cfg, "tree", "search_hit_filtered", ORDER_RANDOM, 0, bench_search_hit_filtered);
+    bench_run(&cfg, "tree", "search_miss_sparse", ORDER_RANDOM, 0, bench_search_miss_sparse);
+    bench_run(&cfg, "tree", "search_miss_sparse_filtered", ORDER_RANDOM, 0, bench_search_miss_sparse_filtered);
+    bench_run(&cfg, "ptree", "insert", ORDER_RANDOM, 0, bench_ptree_insert);
+    bench_run(&cfg, "ptree", "insert_keep_versions", ORDER_RANDOM, 0, bench_ptree_insert_keep);
+    bench_run(&cfg, "ptree", "search_hit", ORDER_RANDOM, 0, bench_ptree_search_hit);
+    bench_run(&cfg, "ptree", "delete", ORDER_RANDOM, 0, bench_ptree_delete);
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include <stdlib.h>
+#include <string.h>
+#include "ds_bloom.h"
+
+// The most counters a value may use: their 6-bit offsets in the block all
+// come out of one 64-bit hash
+#define BLOOM_MAX_HASHES 10
+
+// splitmix64 finalizer, every input bit affects every output bit
+static uint64_t mix(uint64_t h) {
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    return h;
+}
+
+// Function to find the block of a value, *offsets receives the offsets of its counters in the block
+static uint8_t* block_of(const struct ds_bloom* f, int val, uint64_t* offsets) {
+    uint64_t h = mix((uint32_t)val);
+    *offsets = mix(h);
+    return f->counters + (size_t)(((h & 0xFFFFFFFFu) * f->blocks) >> 32) * DS_BLOOM_BLOCK;
+}
+
+// Expected false-positive rate when blocks hold per_block values on average
+// and each value sets k counters of its block. The number of values in a
+// block is Poisson distributed: the weights lambda^j / j! are summed and
+// normalised instead of computing exp(). A block holding j values has a given
+// counter still at zero with probability (1 - 1/64)^(k j).
+static double expected_fpr(double per_block, int k) {
+    double step = 1.0, zero = 1.0, weight = 1.0, total = 0.0, fpr = 0.0;
+    int i, j;
+    for (i = 0; i < k; i++) {
+        step *= 1.0 - 1.0 / DS_BLOOM_BLOCK;
+    }
+    for (j = 0; j < 4 * per_block + 32; j++) {
+        double all_set = 1.0;
+        for (i = 0; i < k; i++) {
+            all_set *= 1.0 - zero;
+        }
+        fpr += weight * all_set;
+        total += weight;
+        zero *= step;
+        weight *= per_block / (j + 1);
+    }
+    return fpr / total;
+}
+
+// Function to size the filter: the fewest counters per value, and the best
+// number of counters per value k for that size, that reach the rate asked for
+// (blocking costs some accuracy, so this is more than the textbook 1.44 k)
+int ds_bloom_init(struct ds_bloom* f, uint32_t capacity, double fpr) {
+    uint64_t blocks;
+    void* counters;
+    int per_value, k = 1;
+
+    if (!(fpr > 0.0 && fpr < 1.0)) {
+        fpr = 0.01;
+    }
+    if (capacity == 0) {
+        capacity = 1;
+    }
+    for (per_value = 2; per_value < DS_BLOOM_BLOCK; per_value++) {
+        for (k = 1; k <= BLOOM_MAX_HASHES; k++) {
+            if (expected_fpr((double)DS_BLOOM_BLOCK / per_value, k) <= fpr) {
+                break;
+            }
+        }
+        if (k <= BLOOM_MAX_HASHES) {
+            break;
+        }
+    }
+    if (k > BLOOM_MAX_HASHES) {
+        k = BLOOM_MAX_HASHES;
+    }
+    blocks = ((uint64_t)capacity * (uint64_t)per_value + DS_BLOOM_BLOCK - 1) / DS_BLOOM_BLOCK;
+
+    // Blocks on cache line boundaries, so one value never spans two lines
+    if (posix_memalign(&counters, DS_BLOOM_BLOCK, (size_t)blocks * DS_BLOOM_BLOCK) != 0) {
+        return DS_NO_MEMORY;
+    }
+    memset(counters, 0, (size_t)blocks * DS_BLOOM_BLOCK);
+    f->counters = (uint8_t*)counters;
+    f->blocks = (uint32_t)blocks;
+    f->hashes = k;
+    f->capacity = capacity;
+    f->fpr = fpr;
+    f->items = 0;
+    f->queries = 0;
+    f->rejected = 0;
+    f->false_positives = 0;
+    return DS_OK;
+}
+
+void ds_bloom_free(struct ds_bloom* f) {
+    free(f->counters);
+    f->counters = NULL;
+}
+
+int ds_bloom_grow(struct ds_bloom* f) {
+    struct ds_bloom resized;
+    if (f->items <= f->capacity) {
+        return 0;
+    }
+    if (ds_bloom_init(&resized, f->items <= UINT32_MAX / 2 ? f->items * 2 : UINT32_MAX, f->fpr) != DS_OK) {
+        f->capacity = UINT32_MAX;
+        return 0;
+    }
+    resized.queries = f->queries;
+    resized.rejected = f->rejected;
+    resized.false_positives = f->false_positives;
+    ds_bloom_free(f);
+    *f = resized;
+    return 1;
+}
+
+void ds_bloom_reset(struct ds_bloom* f) {
+    memset(f->counters, 0, (size_t)f->blocks * DS_BLOOM_BLOCK);
+    f->items = 0;
+}
+
+// A counter stuck at 255 has lost count, it is never decremented again
+void ds_bloom_add(struct ds_bloom* f, int val) {
+    uint64_t offsets;
+    uint8_t* block = block_of(f, val, &offsets);
+    int i;
+    for (i = 0; i < f->hashes; i++, offsets >>= 6) {
+        if (block[offsets & 63] != 255) {
+            block[offsets & 63]++;
+        }
+    }
+    f->items++;
+}
+
+void ds_bloom_remove(struct ds_bloom* f, int val) {
+    uint64_t offsets;
+    uint8_t* block = block_of(f, val, &offsets);
+    int i;
+    for (i = 0; i < f->hashes; i++, offsets >>= 6) {
+        if (block[offsets & 63] != 255 && block[offsets & 63] != 0) {
+            block[offsets & 63]--;
+        }
+    }
+    // Removing a value that was never added must not wrap the count around
+    if (f->items > 0) {
+        f->items--;
+    }
+}
+
+int ds_bloom_may_contain(struct ds_bloom* f, int val) {
+    uint64_t offsets;
+    const uint8_t* block = block_of(f, val, &offsets);
+    int i;
+    f->queries++;
+    for (i = 0; i < f->hashes; i++, offsets >>= 6) {
+        if (block[offsets & 63] == 0) {
+            f->rejected++;
+            return 0;
+        }
+    }
+    return 1;
+}
@@ -0,0 +1,61 @@
+#ifndef DS_BLOOM_H
+#define DS_BLOOM_H
+
+#include <stdint.h>
+#include "ds_status.h"
+
+// Counting Bloom filter over int values, kept next to a tree or a list to
+// answer most searches for absent values without walking the structure.
+// "Absent" is always right; "maybe" can be a false positive, at about the
+// rate the filter was sized for while it holds no more than its capacity.
+//
+// Counters instead of bits make removal possible, and duplicates are fine: a
+// value added twice has to be removed twice. Only remove a value that was
+// added; removing anything else could make a present value look absent. A
+// value deleted from the structure without being removed from the filter is
+// harmless, it only turns into false positives until the filter is rebuilt.
+//
+// The counters of one value all sit in one 64-byte block, so a query costs a
+// single cache miss. The effectiveness counters are always kept: they are
+// what tells whether a filter is worth its memory.
+
+#define DS_BLOOM_BLOCK 64
+
+struct ds_bloom {
+    uint8_t* counters;          // blocks of DS_BLOOM_BLOCK counters, saturating at 255
+    uint32_t blocks;
+    int hashes;                 // counters per value
+    uint32_t capacity;          // values the filter was sized for
+    double fpr;                 // false-positive rate it was sized for
+    uint32_t items;             // values added minus values removed
+    uint64_t queries;
+    uint64_t rejected;          // queries answered "absent"
+    uint64_t false_positives;   // "maybe" answers the search then missed
+};
+
+// Function to size a filter for capacity values at false-positive rate fpr, returns DS_OK or DS_NO_MEMORY
+int ds_bloom_init(struct ds_bloom* f, uint32_t capacity, double fpr);
+
+// Function to free the counters
+void ds_bloom_free(struct ds_bloom* f);
+
+// Function to resize a filter that holds more values than its capacity, for
+// twice the values it holds at the same rate. Returns 1 if it was resized: it
+// is then empty and must be filled again from the structure. Returns 0 if it
+// was not outgrown, or if the memory is not there, in which case it stops
+// growing and keeps working with a higher false-positive rate.
+int ds_bloom_grow(struct ds_bloom* f);
+
+// Function to forget every value, the effectiveness counters are kept
+void ds_bloom_reset(struct ds_bloom* f);
+
+// Function to add one occurrence of a value
+void ds_bloom_add(struct ds_bloom* f, int val);
+
+// Function to remove one occurrence of a value that was added
+void ds_bloom_remove(struct ds_bloom* f, int val);
+
+// Function to ask the filter, returns 0 if the value is certainly absent
+int ds_bloom_may_contain(struct ds_bloom* f, int val);
+
+#endif
@@ -0,0 +1,205 @@
+#include <limits.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include "ds_bqueue.h"
+
+// The lock is held for a few pointer writes, so waiters yield the CPU
+// instead of sleeping on it
+static void lock_items(struct bqueue* q) {
+    while (__atomic_exchange_n(&q->lock, 1, __ATOMIC_ACQUIRE)) {
+        while (__atomic_load_n(&q->lock, __ATOMIC_RELAXED)) {
+            sched_yield();
+        }
+    }
+}
+
+static void unlock_items(struct bqueue* q) {
+    __atomic_store_n(&q->lock, 0, __ATOMIC_RELEASE);
+}
+
+// Sleep while seq still holds expected, for at most *timeout if not NULL
+static void futex_wait(unsigned int* seq, unsigned int expected, const struct timespec* timeout) {
+    syscall(SYS_futex, seq, FUTEX_WAIT_PRIVATE, expected, timeout, NULL, 0);
+}
+
+// Bump seq so that a consumer about to wait does not, then wake up to n sleepers
+static void wake(struct bqueue* q, int n) {
+    __atomic_add_fetch(&q->seq, 1, __ATOMIC_RELEASE);
+    syscall(SYS_futex, &q->seq, FUTEX_WAKE_PRIVATE, n, NULL, NULL, 0);
+    __atomic_add_fetch(&q->wakes, 1, __ATOMIC_RELAXED);
+}
+
+// Make the eventfd readable, unless it already is and the loop has not read it
+static void signal_event(struct bqueue* q) {
+    uint64_t one = 1;
+    if (q->event_fd >= 0 && !__atomic_exchange_n(&q->signalled, 1, __ATOMIC_SEQ_CST)) {
+        if (write(q->event_fd, &one, sizeof(one)) == sizeof(one)) {
+            __atomic_add_fetch(&q->wakes, 1, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long)ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+void bqueue_init(struct bqueue* q) {
+    queue_init(&q->items);
+    q->lock = 0;
+    q->count = 0;
+    q->closed = 0;
+    q->seq = 0;
+    q->sleepers = 0;
+    q->event_fd = -1;
+    q->signalled = 0;
+    q->wakes = 0;
+}
+
+int bqueue_open_eventfd(struct bqueue* q) {
+    if (q->event_fd < 0) {
+        q->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (q->event_fd < 0) {
+            return DS_NO_MEMORY;
+        }
+    }
+    return DS_OK;
+}
+
+// Read the count first and only then allow new writes: clearing the flag
+// first would let a push write a count that this read swallows, leaving the
+// flag set with nothing to read, and the loop would never be woken again
+void bqueue_ack_event(struct bqueue* q) {
+    uint64_t count;
+    if (q->event_fd >= 0) {
+        if (read(q->event_fd, &count, sizeof(count)) < 0) {
+            count = 0;  // EAGAIN: nothing was written since the last ack
+        }
+        __atomic_store_n(&q->signalled, 0, __ATOMIC_SEQ_CST);
+    }
+}
+
+void bqueue_free(struct bqueue* q) {
+    queue_free(&q->items);
+    q->count = 0;
+    if (q->event_fd >= 0) {
+        close(q->event_fd);
+        q->event_fd = -1;
+    }
+}
+
+// The node is allocated before taking the lock. The fence pairs with the one
+// in bqueue_pop(): either this push sees the consumer counted in sleepers, or
+// the consumer sees the value before it sleeps
+int bqueue_push(struct bqueue* q, int x) {
+    struct queue_node* node = (struct queue_node*)malloc(sizeof(struct queue_node));
+    long before;
+    if (node == NULL) {
+        return DS_NO_MEMORY;
+    }
+    node->data = x;
+    node->next = NULL;
+
+    lock_items(q);
+    if (q->items.rear == NULL) {
+        q->items.front = node;
+    } else {
+        q->items.rear->next = node;
+    }
+    q->items.rear = node;
+    before = q->count;
+    __atomic_store_n(&q->count, before + 1, __ATOMIC_RELAXED);
+    unlock_items(q);
+
+    // Only the push that makes the queue non-empty wakes anyone
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (before == 0) {
+        if (__atomic_load_n(&q->sleepers, __ATOMIC_RELAXED) > 0) {
+            wake(q, 1);
+        }
+        signal_event(q);
+    }
+    return DS_OK;
+}
+
+// Unlink the front node under the lock, returns it or NULL; *left receives the values still queued
+static struct queue_node* take_front(struct bqueue* q, long* left) {
+    struct queue_node* node;
+    lock_items(q);
+    node = q->items.front;
+    if (node != NULL) {
+        q->items.front = node->next;
+        if (q->items.front == NULL) {
+            q->items.rear = NULL;
+        }
+        __atomic_store_n(&q->count, q->count - 1, __ATOMIC_RELAXED);
+    }
+    *left = q->count;
+    unlock_items(q);
+    return node;
+}
+
+// A consumer announces itself in sleepers, then checks once more that there
+// is nothing to take before it waits on seq. A value pushed meanwhile either
+// shows up in that check or comes with a wake, which bumps seq first, so the
+// wait returns at once instead of sleeping through it.
+// Pushes onto a non-empty queue wake nobody, so a consumer that was woken and
+// finds more values left wakes the next sleeper: a burst wakes the consumers
+// one after another, each of them once. Woken consumers stay counted in
+// sleepers until they run, so passing the wake on from every pop instead
+// would cost a wake per value.
+int bqueue_pop(struct bqueue* q, int* x, long timeout_ns) {
+    long deadline = timeout_ns > 0 ? now_ns() + timeout_ns : 0;
+    struct queue_node* node;
+    struct timespec ts;
+    unsigned int seq;
+    int woken = 0;
+    long left;
+
+    for (;;) {
+        seq = __atomic_load_n(&q->seq, __ATOMIC_ACQUIRE);
+        node = take_front(q, &left);
+        if (node != NULL) {
+            if (woken && left > 0 && __atomic_load_n(&q->sleepers, __ATOMIC_RELAXED) > 0) {
+                wake(q, 1);
+            }
+            if (x != NULL) {
+                *x = node->data;
+            }
+            free(node);
+            return DS_OK;
+        }
+        if (timeout_ns == 0 || __atomic_load_n(&q->closed, __ATOMIC_ACQUIRE)) {
+            return DS_EMPTY;
+        }
+        if (timeout_ns > 0) {
+            long remaining = deadline - now_ns();
+            if (remaining <= 0) {
+                return DS_EMPTY;
+            }
+            ts.tv_sec = remaining / 1000000000L;
+            ts.tv_nsec = remaining % 1000000000L;
+        }
+
+        __atomic_add_fetch(&q->sleepers, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (bqueue_count(q) == 0 && !__atomic_load_n(&q->closed, __ATOMIC_ACQUIRE)) {
+            futex_wait(&q->seq, seq, timeout_ns > 0 ? &ts : NULL);
+            woken = 1;
+        }
+        __atomic_sub_fetch(&q->sleepers, 1, __ATOMIC_RELAXED);
+    }
+}
+
+void bqueue_close(struct bqueue* q) {
+    __atomic_store_n(&q->closed, 1, __ATOMIC_SEQ_CST);
+    wake(q, INT_MAX);
+    signal_event(q);
+}
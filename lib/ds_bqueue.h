@@ -0,0 +1,68 @@
+#ifndef DS_BQUEUE_H
+#define DS_BQUEUE_H
+
+#include "ds_queue.h"
+#include "ds_status.h"
+
+// Blocking queue for producer and consumer threads (Linux)
+// Consumers sleep instead of polling: bqueue_pop() waits on a futex until a
+// value arrives or its timeout expires. An event loop can instead register the
+// queue's eventfd with epoll and drain the queue when it becomes readable.
+//
+// Wakeups are coalesced: a push only wakes a sleeper when it makes the queue
+// non-empty, and the eventfd is written once until the loop acknowledges it,
+// so a burst of pushes costs at most one wakeup. A consumer that takes a value
+// and sees more left wakes the next sleeper itself.
+//
+// Values are kept in a linked queue under a short lock; nodes are allocated
+// and freed outside it. As for ctree there are no DS_INSTRUMENT counters.
+
+struct bqueue {
+    struct queue items;     // guarded by lock
+    int lock;
+    long count;             // read without the lock by consumers about to sleep
+    int closed;
+    unsigned int seq;       // futex word, bumped before every wake
+    int sleepers;           // consumers waiting, or about to wait, on seq
+    int event_fd;           // -1 until bqueue_open_eventfd()
+    int signalled;          // the eventfd holds a count the loop has not read
+    unsigned long wakes;    // futex wakes and eventfd writes, to see the coalescing
+};
+
+void bqueue_init(struct bqueue* q);
+
+// Function to create the eventfd that becomes readable when values arrive,
+// returns DS_OK or DS_NO_MEMORY if the descriptor cannot be created
+int bqueue_open_eventfd(struct bqueue* q);
+
+// Function to get the eventfd to register with epoll or poll, -1 if none
+static inline int bqueue_event_fd(const struct bqueue* q) {
+    return q->event_fd;
+}
+
+// Function to read the eventfd before draining the queue with bqueue_pop(q, &x, 0)
+// Values pushed from then on make it readable again
+void bqueue_ack_event(struct bqueue* q);
+
+// Function to free the values and close the eventfd, no thread may use the queue any more
+void bqueue_free(struct bqueue* q);
+
+// Enqueue operation, wakes a consumer if needed, returns DS_OK or DS_NO_MEMORY
+int bqueue_push(struct bqueue* q, int x);
+
+// Dequeue operation, stores the removed value in *x (may be NULL)
+// Waits up to timeout_ns for a value: 0 only tries, a negative timeout waits
+// as long as it takes. Returns DS_OK, or DS_EMPTY if it timed out or the queue
+// was closed and is empty.
+int bqueue_pop(struct bqueue* q, int* x, long timeout_ns);
+
+// Function to wake every consumer for shutdown: pops return DS_EMPTY once
+// the values left are taken instead of waiting for more
+void bqueue_close(struct bqueue* q);
+
+// Function to get the number of values
+static inline long bqueue_count(const struct bqueue* q) {
+    return __atomic_load_n(&q->count, __ATOMIC_RELAXED);
+}
+
+#endif
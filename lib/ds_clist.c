@@ -0,0 +1,390 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "ds_clist.h"
+
+/**
+ * @file ds_clist.c
+ */
+
+DS_STATS_DEFINE(clist_stats, "compact doubly linked list");
+
+/**
+ --> Pool Management
+ *
+ * @function alloc_slot
+ * @description
+ * This function hands out a pool slot: a previously freed one if there is
+ * any, otherwise the next never-used one, doubling the pool when it is full.
+ *
+ * @param list: The list owning the pool.
+ * @return The index of the slot, or CLIST_NIL if the pool cannot grow.
+ */
+static uint32_t alloc_slot(struct clist *list) {
+    uint32_t idx = list->free_slot;
+
+    if (idx != CLIST_NIL) {
+        list->free_slot = list->pool[idx].next;
+    } else {
+        if (list->used == list->capacity) {
+            uint32_t capacity = list->capacity ? list->capacity * 2 : 16;
+            struct clist_node *pool;
+            if (list->capacity >= CLIST_NIL / 2) {
+                return CLIST_NIL;
+            }
+            pool = (struct clist_node *)realloc(list->pool, (size_t)capacity * sizeof(struct clist_node));
+            if (pool == NULL) {
+                return CLIST_NIL;
+            }
+            list->pool = pool;
+            list->capacity = capacity;
+        }
+        idx = list->used++;
+    }
+    DS_ALLOC(clist_stats);
+    return idx;
+}
+
+/**
+ * @function release_slot
+ * @description
+ * This function puts a slot back on the free chain for the next insertion.
+ *
+ * @param list: The list owning the pool.
+ * @param idx: The slot to release.
+ */
+static void release_slot(struct clist *list, uint32_t idx) {
+    list->pool[idx].next = list->free_slot;
+    list->free_slot = idx;
+    DS_FREE(clist_stats);
+}
+
+/**
+ * @function link_before
+ * @description
+ * This function links node `idx` in front of node `at`, or at the end of the
+ * list when `at` is CLIST_NIL, and updates head, tail and count.
+ *
+ * @param list: The list.
+ * @param idx: The node to link.
+ * @param at: The node that will follow it, or CLIST_NIL.
+ */
+static void link_before(struct clist *list, uint32_t idx, uint32_t at) {
+    struct clist_node *node = &list->pool[idx];
+    uint32_t prev = at == CLIST_NIL ? list->tail : list->pool[at].prev;
+
+    node->prev = prev;
+    node->next = at;
+    if (prev == CLIST_NIL) {
+        list->head = idx;
+    } else {
+        list->pool[prev].next = idx;
+    }
+    if (at == CLIST_NIL) {
+        list->tail = idx;
+    } else {
+        list->pool[at].prev = idx;
+    }
+    list->count++;
+}
+
+/**
+ * @function unlink_node
+ * @description
+ * This function removes node `idx` from the list and releases its slot.
+ *
+ * @param list: The list.
+ * @param idx: The node to remove.
+ */
+static void unlink_node(struct clist *list, uint32_t idx) {
+    struct clist_node *node = &list->pool[idx];
+
+    if (node->prev == CLIST_NIL) {
+        list->head = node->next;
+    } else {
+        list->pool[node->prev].next = node->next;
+    }
+    if (node->next == CLIST_NIL) {
+        list->tail = node->prev;
+    } else {
+        list->pool[node->next].prev = node->prev;
+    }
+    list->count--;
+    release_slot(list, idx);
+}
+
+/**
+ * @function node_at
+ * @description
+ * This function finds the node at a 1-based position. Since the list knows
+ * its length and both ends, it walks from whichever end is closer.
+ *
+ * @param list: The list.
+ * @param position: A position between 1 and the length of the list.
+ * @return The index of the node.
+ */
+static uint32_t node_at(const struct clist *list, uint32_t position) {
+    uint32_t idx, steps;
+
+    if (position - 1 <= list->count - position) {
+        idx = list->head;
+        for (steps = position - 1; steps > 0; steps--) {
+            idx = list->pool[idx].next;
+            DS_VISIT(clist_stats);
+        }
+    } else {
+        idx = list->tail;
+        for (steps = list->count - position; steps > 0; steps--) {
+            idx = list->pool[idx].prev;
+            DS_VISIT(clist_stats);
+        }
+    }
+    return idx;
+}
+
+void clist_init(struct clist *list) {
+    list->pool = NULL;
+    list->capacity = 0;
+    list->free_slot = CLIST_NIL;
+    list->used = 0;
+    list->head = CLIST_NIL;
+    list->tail = CLIST_NIL;
+    list->count = 0;
+}
+
+void clist_free(struct clist *list) {
+    free(list->pool);
+    clist_init(list);
+}
+
+/**
+ --> Traversing the List
+ *
+ * @function clist_traverse
+ * @description
+ * This function follows the `next` indices from the head and calls `visit`
+ * with the data of every node.
+ *
+ * @param list: The list.
+ * @param visit: The function called with every value, from head to tail.
+ * @param ctx: An opaque pointer passed through to `visit`.
+ */
+void clist_traverse(const struct clist *list, void (*visit)(int val, void *ctx), void *ctx) {
+    uint32_t idx;
+    DS_OP_BEGIN(clist_stats);
+    for (idx = list->head; idx != CLIST_NIL; idx = list->pool[idx].next) {
+        DS_VISIT(clist_stats);
+        visit(list->pool[idx].data, ctx);
+    }
+    DS_OP_END(clist_stats);
+}
+
+/**
+ * @function clist_traverse_reverse
+ * @description
+ * This function follows the `prev` indices from the tail, which the list
+ * keeps, so no walk to the last node is needed first.
+ *
+ * @param list: The list.
+ * @param visit: The function called with every value, from tail to head.
+ * @param ctx: An opaque pointer passed through to `visit`.
+ */
+void clist_traverse_reverse(const struct clist *list, void (*visit)(int val, void *ctx), void *ctx) {
+    uint32_t idx;
+    DS_OP_BEGIN(clist_stats);
+    for (idx = list->tail; idx != CLIST_NIL; idx = list->pool[idx].prev) {
+        DS_VISIT(clist_stats);
+        visit(list->pool[idx].data, ctx);
+    }
+    DS_OP_END(clist_stats);
+}
+
+/**
+ --> Insertion
+ *
+ * @function clist_add_beg
+ * @description
+ * This function takes a slot from the pool and links it before the head.
+ *
+ * @param list: The list.
+ * @param data: The integer value to be stored in the new node.
+ * @return DS_OK, or DS_NO_MEMORY.
+ */
+int clist_add_beg(struct clist *list, int data) {
+    uint32_t idx;
+    DS_OP_BEGIN(clist_stats);
+    idx = alloc_slot(list);
+    if (idx == CLIST_NIL) {
+        DS_OP_END(clist_stats);
+        return DS_NO_MEMORY;
+    }
+    list->pool[idx].data = data;
+    link_before(list, idx, list->head);
+    DS_OP_END(clist_stats);
+    return DS_OK;
+}
+
+/**
+ * @function clist_add_at_end
+ * @description
+ * This function takes a slot from the pool and links it after the tail, in
+ * O(1) since the list keeps its tail.
+ *
+ * @param list: The list.
+ * @param data: The integer value to be stored in the new node.
+ * @return DS_OK, or DS_NO_MEMORY.
+ */
+int clist_add_at_end(struct clist *list, int data) {
+    uint32_t idx;
+    DS_OP_BEGIN(clist_stats);
+    idx = alloc_slot(list);
+    if (idx == CLIST_NIL) {
+        DS_OP_END(clist_stats);
+        return DS_NO_MEMORY;
+    }
+    list->pool[idx].data = data;
+    link_before(list, idx, CLIST_NIL);
+    DS_OP_END(clist_stats);
+    return DS_OK;
+}
+
+/**
+ * @function clist_insert_at_position
+ * @description
+ * This function inserts a new node so that it ends up at `position`; the
+ * node currently there is found from the closer end of the list.
+ *
+ * @param list: The list.
+ * @param data: The integer value to be stored in the new node.
+ * @param position: The position of the new node, 1 to length + 1.
+ * @return DS_OK, DS_BAD_POSITION or DS_NO_MEMORY.
+ */
+int clist_insert_at_position(struct clist *list, int data, int position) {
+    uint32_t idx, at;
+    DS_OP_BEGIN(clist_stats);
+    if (position < 1 || (uint32_t)position > list->count + 1) {
+        DS_OP_END(clist_stats);
+        return DS_BAD_POSITION;
+    }
+    // Look up the successor before alloc_slot() may move the pool
+    at = (uint32_t)position == list->count + 1 ? CLIST_NIL : node_at(list, (uint32_t)position);
+    idx = alloc_slot(list);
+    if (idx == CLIST_NIL) {
+        DS_OP_END(clist_stats);
+        return DS_NO_MEMORY;
+    }
+    list->pool[idx].data = data;
+    link_before(list, idx, at);
+    DS_OP_END(clist_stats);
+    return DS_OK;
+}
+
+/**
+ --> Deletion
+ *
+ * @function clist_delete_by_value
+ * @description
+ * This function deletes the first node holding `value`.
+ *
+ * @param list: The list.
+ * @param value: The value to delete from the list.
+ * @return DS_OK, DS_EMPTY or DS_NOT_FOUND.
+ */
+int clist_delete_by_value(struct clist *list, int value) {
+    uint32_t idx;
+    DS_OP_BEGIN(clist_stats);
+    if (list->count == 0) {
+        DS_OP_END(clist_stats);
+        return DS_EMPTY;
+    }
+    for (idx = list->head; idx != CLIST_NIL; idx = list->pool[idx].next) {
+        DS_VISIT(clist_stats);
+        if (list->pool[idx].data == value) {
+            unlink_node(list, idx);
+            DS_OP_END(clist_stats);
+            return DS_OK;
+        }
+    }
+    DS_OP_END(clist_stats);
+    return DS_NOT_FOUND;
+}
+
+/**
+ * @function clist_delete_beg
+ * @description
+ * This function deletes the first node of the list.
+ *
+ * @param list: The list.
+ * @return DS_OK, or DS_EMPTY.
+ */
+int clist_delete_beg(struct clist *list) {
+    DS_OP_BEGIN(clist_stats);
+    if (list->count == 0) {
+        DS_OP_END(clist_stats);
+        return DS_EMPTY;
+    }
+    unlink_node(list, list->head);
+    DS_OP_END(clist_stats);
+    return DS_OK;
+}
+
+/**
+ * @function clist_delete_end
+ * @description
+ * This function deletes the last node of the list in O(1).
+ *
+ * @param list: The list.
+ * @return DS_OK, or DS_EMPTY.
+ */
+int clist_delete_end(struct clist *list) {
+    DS_OP_BEGIN(clist_stats);
+    if (list->count == 0) {
+        DS_OP_END(clist_stats);
+        return DS_EMPTY;
+    }
+    unlink_node(list, list->tail);
+    DS_OP_END(clist_stats);
+    return DS_OK;
+}
+
+/**
+ * @function clist_delete_at_position
+ * @description
+ * This function deletes the node at `position`, reached from the closer end.
+ *
+ * @param list: The list.
+ * @param position: The position of the node to delete (1-based index).
+ * @return DS_OK, DS_EMPTY or DS_BAD_POSITION.
+ */
+int clist_delete_at_position(struct clist *list, int position) {
+    DS_OP_BEGIN(clist_stats);
+    if (list->count == 0) {
+        DS_OP_END(clist_stats);
+        return DS_EMPTY;
+    }
+    if (position < 1 || (uint32_t)position > list->count) {
+        DS_OP_END(clist_stats);
+        return DS_BAD_POSITION;
+    }
+    unlink_node(list, node_at(list, (uint32_t)position));
+    DS_OP_END(clist_stats);
+    return DS_OK;
+}
+
+/**
+ * @function clist_clear_list
+ * @description
+ * This function empties the list in O(1): every slot becomes unused again
+ * and the pool is kept for the next insertions.
+ *
+ * @param list: The list.
+ */
+void clist_clear_list(struct clist *list) {
+#ifdef DS_INSTRUMENT
+    clist_stats.frees += list->count;
+#endif
+    list->free_slot = CLIST_NIL;
+    list->used = 0;
+    list->head = CLIST_NIL;
+    list->tail = CLIST_NIL;
+    list->count = 0;
+}
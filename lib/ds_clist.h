@@ -0,0 +1,105 @@
+#ifndef DS_CLIST_H
+#define DS_CLIST_H
+
+#include <stdint.h>
+#include "ds_stats.h"
+#include "ds_status.h"
+
+/**
+ * @file ds_clist.h
+ * Compact doubly linked list of integers. The nodes live in one growable
+ * pool and link to each other with 32-bit indices instead of pointers, so a
+ * node takes 12 bytes (value, prev, next) where a `dlist_node` takes 24 bytes
+ * plus the malloc header of every node. It covers the core of ds_dlist.h:
+ * traversal in both directions, insertion at either end or a position, and
+ * deletion by value, at either end or at a position. Search, sorting,
+ * reversal, splicing and snapshots are only offered by `struct dlist`.
+ */
+
+/** Index meaning "no node", the equivalent of NULL. */
+#define CLIST_NIL UINT32_MAX
+
+/**
+ --> Creating the Node of a compact list
+ *
+ * @struct clist_node
+ * @description
+ * - `data`: The integer value of the node.
+ * - `prev`: Index of the previous node in the pool, CLIST_NIL on the first node.
+ * - `next`: Index of the next node, CLIST_NIL on the last node. Free slots of
+ *           the pool are chained through `next` as well.
+ */
+struct clist_node {
+    int32_t data;
+    uint32_t prev;
+    uint32_t next;
+};
+
+/**
+ * @struct clist
+ * @description
+ * - `pool`: Every node, in use or free; grows by doubling, and since links are
+ *           indices the list stays valid when realloc() moves it.
+ * - `capacity`: Number of slots in the pool.
+ * - `free_slot`: First free slot, CLIST_NIL when every slot is in use.
+ * - `used`: Slots handed out so far; slots past it were never used.
+ * - `head`, `tail`, `count`: The ends of the list and its length.
+ */
+struct clist {
+    struct clist_node *pool;
+    uint32_t capacity;
+    uint32_t free_slot;
+    uint32_t used;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t count;
+};
+
+/**
+ * Counters for the list operations, only compiled in with -DDS_INSTRUMENT
+ * (see ds_stats.h). An allocation is a pool slot being handed out.
+ */
+DS_STATS_DECLARE(clist_stats);
+
+/** Creates an empty list; the pool is allocated on the first insertion. */
+void clist_init(struct clist *list);
+
+/** Frees the pool and leaves the list empty. */
+void clist_free(struct clist *list);
+
+/** Returns the number of nodes in the list. */
+static inline int clist_count_of_nodes(const struct clist *list) {
+    return (int)list->count;
+}
+
+/** Calls `visit` with the data of every node from head to tail. */
+void clist_traverse(const struct clist *list, void (*visit)(int val, void *ctx), void *ctx);
+
+/** Calls `visit` with the data of every node from tail to head. */
+void clist_traverse_reverse(const struct clist *list, void (*visit)(int val, void *ctx), void *ctx);
+
+/** Inserts a new node holding `data` at the beginning of the list, returns DS_OK or DS_NO_MEMORY. */
+int clist_add_beg(struct clist *list, int data);
+
+/** Inserts a new node holding `data` at the end of the list, returns DS_OK or DS_NO_MEMORY. */
+int clist_add_at_end(struct clist *list, int data);
+
+/** Inserts a new node holding `data` at `position` (1-based), returns a ds_status. */
+int clist_insert_at_position(struct clist *list, int data, int position);
+
+/** Deletes the first node holding `value`, returns DS_OK, DS_EMPTY or DS_NOT_FOUND. */
+int clist_delete_by_value(struct clist *list, int value);
+
+/** Deletes the first node of the list, returns DS_OK or DS_EMPTY. */
+int clist_delete_beg(struct clist *list);
+
+/** Deletes the last node of the list, returns DS_OK or DS_EMPTY. */
+int clist_delete_end(struct clist *list);
+
+/** Deletes the node at `position` (1-based), returns DS_OK, DS_EMPTY or DS_BAD_POSITION. */
+int clist_delete_at_position(struct clist *list, int position);
+
+/** Removes every node but keeps the pool for reuse. */
+void clist_clear_list(struct clist *list);
+
+#endif
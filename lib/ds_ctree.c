@@ -0,0 +1,199 @@
+#include <sched.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include "ds_ctree.h"
+#include "ds_walk.h"
+
+// Child links are read by readers while a writer changes them: readers load
+// them with acquire, writers publish with release so a new node is complete
+// before it can be reached
+static struct ctree_node* load_link(struct ctree_node* const* link) {
+    return __atomic_load_n(link, __ATOMIC_ACQUIRE);
+}
+
+static void store_link(struct ctree_node** link, struct ctree_node* node) {
+    __atomic_store_n(link, node, __ATOMIC_RELEASE);
+}
+
+// Writers' lock; a writer holds it for one O(height) walk, so waiters yield
+// the CPU instead of spinning on it for long
+static void lock_writers(struct ctree* t) {
+    while (__atomic_exchange_n(&t->lock, 1, __ATOMIC_ACQUIRE)) {
+        while (__atomic_load_n(&t->lock, __ATOMIC_RELAXED)) {
+            sched_yield();
+        }
+    }
+}
+
+static void unlock_writers(struct ctree* t) {
+    __atomic_store_n(&t->lock, 0, __ATOMIC_RELEASE);
+}
+
+void ctree_init(struct ctree* t) {
+    t->root = NULL;
+    t->seq = 0;
+    t->lock = 0;
+    t->count = 0;
+    ds_epoch_init(&t->reclaim, offsetof(struct ctree_node, retired));
+}
+
+// Function to free every node, no thread may use the tree any more
+// Rotating left children up frees the tree in O(n) without recursion
+void ctree_free(struct ctree* t) {
+    struct ctree_node* node = t->root;
+    while (node != NULL) {
+        if (node->left != NULL) {
+            struct ctree_node* left = node->left;
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        } else {
+            struct ctree_node* next = node->right;
+            free(node);
+            node = next;
+        }
+    }
+    ds_epoch_free(&t->reclaim);
+    ctree_init(t);
+}
+
+// Function to get a slot for the calling thread
+int ctree_register(struct ctree* t) {
+    return ds_epoch_register(&t->reclaim);
+}
+
+// Function to give the slot back
+void ctree_unregister(struct ctree* t, int slot) {
+    ds_epoch_unregister(&t->reclaim, slot);
+}
+
+// Function to search for a value without locking
+// A hit is always right. A miss is only trusted if no successor was moved
+// during the walk (seq even and unchanged), otherwise the walk is repeated
+int ctree_search(struct ctree* t, int slot, int val) {
+    const struct ctree_node* node;
+    unsigned long seq;
+    ds_epoch_enter(&t->reclaim, slot);
+    do {
+        seq = __atomic_load_n(&t->seq, __ATOMIC_ACQUIRE);
+        node = load_link(&t->root);
+        while (node != NULL && node->data != val) {
+            node = load_link(val < node->data ? &node->left : &node->right);
+        }
+        if (node != NULL) {
+            break;
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while ((seq & 1) || __atomic_load_n(&t->seq, __ATOMIC_RELAXED) != seq);
+    ds_epoch_exit(&t->reclaim, slot);
+    return node != NULL;
+}
+
+// Function to insert a value; the new node is complete before it is linked
+int ctree_insert(struct ctree* t, int val) {
+    struct ctree_node** link = &t->root;
+    struct ctree_node* node;
+    lock_writers(t);
+    while (*link != NULL) {
+        if (val == (*link)->data) {
+            unlock_writers(t);
+            return DS_EXISTS;
+        }
+        link = val < (*link)->data ? &(*link)->left : &(*link)->right;
+    }
+    node = (struct ctree_node*)malloc(sizeof(struct ctree_node));
+    if (node == NULL) {
+        unlock_writers(t);
+        return DS_NO_MEMORY;
+    }
+    node->data = val;
+    node->left = NULL;
+    node->right = NULL;
+    node->retired = NULL;
+    store_link(link, node);
+    __atomic_add_fetch(&t->count, 1, __ATOMIC_RELAXED);
+    unlock_writers(t);
+    return DS_OK;
+}
+
+// Function to delete a value
+// Nodes readers may be standing on are never modified: a node with at most
+// one child is bypassed, a node with two children is replaced by a new node
+// holding its successor, and the successor is then bypassed in turn
+int ctree_delete(struct ctree* t, int val) {
+    struct ctree_node** link = &t->root;
+    struct ctree_node* node;
+    lock_writers(t);
+    while (*link != NULL && (*link)->data != val) {
+        link = val < (*link)->data ? &(*link)->left : &(*link)->right;
+    }
+    node = *link;
+    if (node == NULL) {
+        unlock_writers(t);
+        return DS_NOT_FOUND;
+    }
+
+    if (node->left == NULL || node->right == NULL) {
+        store_link(link, node->left != NULL ? node->left : node->right);
+        ds_epoch_retire(&t->reclaim, node);
+    } else {
+        struct ctree_node** succ_link = &node->right;
+        struct ctree_node* succ = node->right;
+        struct ctree_node* copy = (struct ctree_node*)malloc(sizeof(struct ctree_node));
+        if (copy == NULL) {
+            unlock_writers(t);
+            return DS_NO_MEMORY;
+        }
+        while (succ->left != NULL) {
+            succ_link = &succ->left;
+            succ = succ->left;
+        }
+        copy->data = succ->data;
+        copy->left = node->left;
+        copy->right = succ == node->right ? succ->right : node->right;
+        copy->retired = NULL;
+
+        // Between the two stores the successor's value is in the tree twice,
+        // but a reader that passed it on the old path may miss it: seq is odd
+        // meanwhile so that reader retries
+        __atomic_store_n(&t->seq, t->seq + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        store_link(link, copy);
+        if (succ != node->right) {
+            store_link(succ_link, succ->right);
+        }
+        __atomic_store_n(&t->seq, t->seq + 1, __ATOMIC_RELEASE);
+        ds_epoch_retire(&t->reclaim, node);
+        ds_epoch_retire(&t->reclaim, succ);
+    }
+    __atomic_sub_fetch(&t->count, 1, __ATOMIC_RELAXED);
+    unlock_writers(t);
+    return DS_OK;
+}
+
+// Inorder traversal function LNR without locking
+// Writers change links meanwhile, so the path back up is kept on an explicit
+// stack instead of being threaded through the nodes, and a degenerate tree
+// does not recurse as deep as it is long
+int ctree_inorder(struct ctree* t, int slot, void (*visit)(int val, void* ctx), void* ctx) {
+    struct ds_walk walk;
+    const struct ctree_node* node;
+    int status = DS_OK;
+
+    ds_walk_init(&walk);
+    ds_epoch_enter(&t->reclaim, slot);
+    node = load_link(&t->root);
+    while (status == DS_OK && (node != NULL || walk.count > 0)) {
+        if (node != NULL) {
+            status = ds_walk_push(&walk, node);     // Come back to it after the left subtree
+            node = load_link(&node->left);
+        } else {
+            node = (const struct ctree_node*)ds_walk_pop(&walk);
+            visit(node->data, ctx);                 // Visit the root
+            node = load_link(&node->right);         // Traverse the right subtree
+        }
+    }
+    ds_epoch_exit(&t->reclaim, slot);
+    ds_walk_free(&walk);
+    return status;
+}
@@ -0,0 +1,68 @@
+#ifndef DS_CTREE_H
+#define DS_CTREE_H
+
+#include "ds_epoch.h"
+#include "ds_status.h"
+
+// Concurrent binary search tree for read-mostly workloads (a set: no duplicates)
+// Readers never lock or write shared memory other than their own slot: they
+// follow child links published with release stores, RCU style. Writers take
+// one lock, so they run one at a time, and never change a node a reader may be
+// on: a deleted node is unlinked and a node with two children is replaced by a
+// new copy holding its successor. Removed nodes are freed by epoch-based
+// reclamation (ds_epoch.h) once no reader can still hold them. A search that
+// misses while a successor was being moved up is retried (optimistic version
+// validation).
+//
+// Every reading thread registers once to get a slot and passes it to its reads.
+// As for cskiplist there are no DS_INSTRUMENT counters.
+
+#define CTREE_MAX_THREADS DS_EPOCH_MAX_THREADS
+
+struct ctree_node {
+    int data;
+    struct ctree_node* left;
+    struct ctree_node* right;
+    struct ctree_node* retired;   // next node on a reclamation list
+};
+
+struct ctree {
+    struct ctree_node* root;
+    unsigned long seq;                 // odd while a deletion moves a successor
+    int lock;                          // writers' lock
+    long count;
+    struct ds_epoch reclaim;           // reader slots and removed nodes
+};
+
+void ctree_init(struct ctree* t);
+
+// Function to free every node, no thread may use the tree any more
+void ctree_free(struct ctree* t);
+
+// Function to get a slot for the calling thread, returns it or DS_NO_MEMORY if all are taken
+int ctree_register(struct ctree* t);
+
+// Function to give the slot back when the thread is done with the tree
+void ctree_unregister(struct ctree* t, int slot);
+
+// Function to search for a value without locking, returns 1 if found
+int ctree_search(struct ctree* t, int slot, int val);
+
+// Function to insert a value, returns DS_OK, DS_EXISTS or DS_NO_MEMORY
+int ctree_insert(struct ctree* t, int val);
+
+// Function to delete a value, returns DS_OK, DS_NOT_FOUND or DS_NO_MEMORY
+// (a node with two children is replaced by a new copy, which can fail)
+int ctree_delete(struct ctree* t, int val);
+
+// Inorder traversal function LNR without locking; values inserted or
+// deleted meanwhile may or may not be seen. Returns DS_OK, or DS_NO_MEMORY if
+// the walk stack of a deep tree cannot grow, after visiting a prefix in order
+int ctree_inorder(struct ctree* t, int slot, void (*visit)(int val, void* ctx), void* ctx);
+
+// Function to get the number of values
+static inline long ctree_count(const struct ctree* t) {
+    return __atomic_load_n(&t->count, __ATOMIC_RELAXED);
+}
+
+#endif
@@ -0,0 +1,970 @@
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "ds_dlist.h"
+#include "ds_intset.h"
+#include "ds_slab.h"
+
+/**
+ * @file ds_dlist.c
+ */
+
+DS_STATS_DEFINE(dlist_stats, "doubly linked list");
+
+/**
+ * @function free_node
+ * @description
+ * This function frees a node: on its own, or back into the block
+ * dlist_compact() carved it from, which goes with its last node.
+ *
+ * @param node: The node, already unlinked.
+ */
+static void free_node(struct dlist_node* node) {
+    if (node->slot != 0) {
+        ds_slab_put(node, node->slot, sizeof(*node));
+    } else {
+        free(node);
+    }
+}
+
+/**
+ --> Linking and Unlinking Nodes
+ *
+ * @function link_before
+ * @description
+ * This function links `node` in front of `at`, or after the tail when `at`
+ * is `NULL`, and keeps the head, tail, count and finger of the list right.
+ *
+ * @param list: The list.
+ * @param node: The node to link.
+ * @param at: The node that will follow it, or `NULL`.
+ * @param position: The position `node` ends up at.
+ */
+static void link_before(struct dlist* list, struct dlist_node* node, struct dlist_node* at, int position) {
+    struct dlist_node* prev = at == NULL ? list->tail : at->prev;
+
+    node->prev = prev;
+    node->next = at;
+    if (prev == NULL) {
+        list->head = node;
+    } else {
+        prev->next = node;
+    }
+    if (at == NULL) {
+        list->tail = node;
+    } else {
+        at->prev = node;
+    }
+    list->count++;
+
+    // Every node from `position` on moved one place back
+    if (list->finger != NULL && position <= list->finger_pos) {
+        list->finger_pos++;
+    }
+}
+
+/**
+ * @function unlink_node
+ * @description
+ * This function unlinks `node` and frees it. If the finger was on that node
+ * it moves to the node taking its place, so deleting position after position
+ * keeps the finger close.
+ *
+ * @param list: The list.
+ * @param node: The node to delete.
+ * @param position: The position of `node`.
+ */
+static void unlink_node(struct dlist* list, struct dlist_node* node, int position) {
+    if (node->prev == NULL) {
+        list->head = node->next;
+    } else {
+        node->prev->next = node->next;
+    }
+    if (node->next == NULL) {
+        list->tail = node->prev;
+    } else {
+        node->next->prev = node->prev;
+    }
+    list->count--;
+
+    if (list->finger == node) {
+        if (node->next != NULL) {
+            list->finger = node->next;
+        } else {
+            list->finger = node->prev;
+            list->finger_pos--;
+        }
+    } else if (list->finger != NULL && position < list->finger_pos) {
+        list->finger_pos--;
+    }
+
+    free_node(node);
+    DS_FREE(dlist_stats);
+}
+
+/**
+ * @function node_at
+ * @description
+ * This function finds the node at a 1-based position. It starts from the
+ * head, the tail or the finger, whichever is closest, and leaves the finger
+ * on the node it found when the finger is enabled.
+ *
+ * @param list: The list.
+ * @param position: A position between 1 and the length of the list.
+ * @return The node at `position`.
+ */
+static struct dlist_node* node_at(struct dlist* list, int position) {
+    struct dlist_node* temp;
+    int steps;
+
+    if (position - 1 <= list->count - position) {
+        temp = list->head;
+        steps = position - 1;
+    } else {
+        temp = list->tail;
+        steps = position - list->count;
+    }
+    if (list->finger != NULL && abs(position - list->finger_pos) < abs(steps)) {
+        temp = list->finger;
+        steps = position - list->finger_pos;
+    }
+
+    // Each step asks for the node two ahead, so its miss starts one step early
+    for (; steps > 0; steps--) {
+        if (steps > 1) {
+            __builtin_prefetch(temp->next->next);
+        }
+        temp = temp->next;
+        DS_VISIT(dlist_stats);
+    }
+    for (; steps < 0; steps++) {
+        if (steps < -1) {
+            __builtin_prefetch(temp->prev->prev);
+        }
+        temp = temp->prev;
+        DS_VISIT(dlist_stats);
+    }
+
+    if (list->use_finger) {
+        list->finger = temp;
+        list->finger_pos = position;
+    }
+    return temp;
+}
+
+void dlist_init(struct dlist* list) {
+    list->head = NULL;
+    list->tail = NULL;
+    list->count = 0;
+    list->use_finger = 0;
+    list->finger = NULL;
+    list->finger_pos = 0;
+}
+
+void dlist_use_finger(struct dlist* list, int enabled) {
+    list->use_finger = enabled;
+    list->finger = NULL;
+    list->finger_pos = 0;
+}
+
+/**
+ --> Traversing a Doubly Linked List
+ *
+ * @function dlist_traverse
+ * @description
+ * This function hands the data stored in each node of a doubly linked list
+ * to a callback. It starts from the head node and calls `visit` with the
+ * `data` field of each node, then moves to the next node by following the
+ * `next` pointer until it reaches the end of the list.
+ *
+ * @param list: The list.
+ * @param visit: The function called with every value, from head to tail.
+ * @param ctx: An opaque pointer passed through to `visit`.
+ */
+void dlist_traverse(const struct dlist* list, void (*visit)(int val, void* ctx), void* ctx) {
+    DS_OP_BEGIN(dlist_stats);
+    struct dlist_node* temp = list->head;
+    while (temp != NULL) {
+        // Ask for the node after next while visit() runs
+        if (temp->next != NULL) {
+            __builtin_prefetch(temp->next->next);
+        }
+        visit(temp->data, ctx);
+        temp = temp->next;
+        DS_VISIT(dlist_stats);
+    }
+    DS_OP_END(dlist_stats);
+}
+
+/**
+ --> Insertion at the Beginning of the List
+ *
+ * @function dlist_add_beg
+ * @description
+ * This function inserts a new node at the beginning of a doubly linked list.
+ * The new node is created dynamically with the specified data, and it is
+ * linked as the first node in the list by updating the `next` pointer of
+ * the new node and the `prev` pointer of the original head node.
+ *
+ * @param list: The list.
+ * @param data: The integer value to be stored in the new node.
+ * @return DS_OK, or DS_NO_MEMORY.
+ */
+int dlist_add_beg(struct dlist* list, int data) {
+    DS_OP_BEGIN(dlist_stats);
+    struct dlist_node* new_node = (struct dlist_node*)malloc(sizeof(struct dlist_node));
+    if (new_node == NULL) {
+        DS_OP_END(dlist_stats);
+        return DS_NO_MEMORY;
+    }
+    DS_ALLOC(dlist_stats);
+
+    new_node->data = data;
+
+    new_node->slot = 0;
+    link_before(list, new_node, list->head, 1);
+    DS_OP_END(dlist_stats);
+    return DS_OK;
+}
+
+/**
+ --> Insertion at the End of the List
+ *
+ * @function dlist_add_at_end
+ * @description
+ * This function inserts a new node at the end of a doubly linked list. The
+ * list keeps its tail, so the new node is linked after it in O(1).
+ *
+ * @param list: The list.
+ * @param data: The integer value to be stored in the new node.
+ * @return DS_OK, or DS_NO_MEMORY.
+ */
+int dlist_add_at_end(struct dlist* list, int data) {
+    DS_OP_BEGIN(dlist_stats);
+    struct dlist_node* new_node = (struct dlist_node*)malloc(sizeof(struct dlist_node));
+    if (new_node == NULL) {
+        DS_OP_END(dlist_stats);
+        return DS_NO_MEMORY;
+    }
+    DS_ALLOC(dlist_stats);
+
+    new_node->data = data;
+
+    new_node->slot = 0;
+    link_before(list, new_node, NULL, list->count + 1);
+    DS_OP_END(dlist_stats);
+    return DS_OK;
+}
+
+/**
+ --> Insertion at Any Position of the List
+ *
+ * @function dlist_insert_at_position
+ * @description
+ * This function inserts a new node at a specific position in a doubly linked list.
+ * The node currently at that position is reached from the head, the tail or
+ * the finger, whichever is closest, and the new node is linked in front of it.
+ *
+ * @param list: The list.
+ * @param data: The integer value to be stored in the new node.
+ * @param position: The position at which to insert the new node (1 to length + 1).
+ * @return DS_OK, DS_BAD_POSITION or DS_NO_MEMORY.
+ */
+int dlist_insert_at_position(struct dlist* list, int data, int position) {
+    DS_OP_BEGIN(dlist_stats);
+    if (position < 1 || position > list->count + 1) {
+        DS_OP_END(dlist_stats);
+        return DS_BAD_POSITION;
+    }
+    struct dlist_node* new_node = (struct dlist_node*)malloc(sizeof(struct dlist_node));
+    if (new_node == NULL) {
+        DS_OP_END(dlist_stats);
+        return DS_NO_MEMORY;
+    }
+    DS_ALLOC(dlist_stats);
+
+    new_node->data = data;
+
+    new_node->slot = 0;
+    link_before(list, new_node, position == list->count + 1 ? NULL : node_at(list, position), position);
+    DS_OP_END(dlist_stats);
+    return DS_OK;
+}
+
+/**
+ --> Access by Position
+ *
+ * @function dlist_get_at
+ * @description
+ * This function reads the value at a specific position, walking from the
+ * head, the tail or the finger, whichever is closest.
+ *
+ * @param list: The list.
+ * @param position: The position of the node to read (1-based index).
+ * @param val: Receives the value.
+ * @return DS_OK, DS_EMPTY or DS_BAD_POSITION.
+ */
+int dlist_get_at(struct dlist* list, int position, int* val) {
+    DS_OP_BEGIN(dlist_stats);
+    if (list->count == 0) {
+        DS_OP_END(dlist_stats);
+        return DS_EMPTY;
+    }
+    if (position < 1 || position > list->count) {
+        DS_OP_END(dlist_stats);
+        return DS_BAD_POSITION;
+    }
+    *val = node_at(list, position)->data;
+    DS_OP_END(dlist_stats);
+    return DS_OK;
+}
+
+/**
+ --> Deletion by Value
+ *
+ * @function dlist_delete_by_value
+ * @description
+ * This function deletes the first node holding `value` from a doubly linked
+ * list by linking its neighbours to each other.
+ *
+ * @param list: The list.
+ * @param value: The value to delete from the list.
+ * @return DS_OK, DS_EMPTY or DS_NOT_FOUND.
+ */
+int dlist_delete_by_value(struct dlist* list, int value) {
+    DS_OP_BEGIN(dlist_stats);
+    if (list->head == NULL) {
+        DS_OP_END(dlist_stats);
+        return DS_EMPTY;
+    }
+
+    // Traverse the list to find the node with the value, counting positions for the finger
+    struct dlist_node* temp = list->head;
+    int position = 1;
+    while (temp != NULL && temp->data != value) {
+        if (temp->next != NULL) {
+            __builtin_prefetch(temp->next->next);
+        }
+        temp = temp->next;
+        position++;
+        DS_VISIT(dlist_stats);
+    }
+
+    // If value was not found
+    if (temp == NULL) {
+        DS_OP_END(dlist_stats);
+        return DS_NOT_FOUND;
+    }
+
+    unlink_node(list, temp, position);
+    DS_OP_END(dlist_stats);
+    return DS_OK;
+}
+
+
+/**
+ --> Deletion at the Beginning of the List
+ *
+ * @function dlist_delete_beg
+ * @description
+ * This function deletes the first node of a doubly linked list.
+ * It updates the `next` pointer of the head node and the `prev` pointer
+ * of the second node (if it exists) to remove the first node.
+ *
+ * @param list: The list.
+ * @return DS_OK, or DS_EMPTY.
+ */
+int dlist_delete_beg(struct dlist* list) {
+    DS_OP_BEGIN(dlist_stats);
+    if (list->head == NULL) {
+        DS_OP_END(dlist_stats);
+        return DS_EMPTY;
+    }
+
+    unlink_node(list, list->head, 1);
+    DS_OP_END(dlist_stats);
+    return DS_OK;
+}
+
+/**
+ --> Deletion at the End of the List
+ *
+ * @function dlist_delete_end
+ * @description
+ * This function deletes the last node of a doubly linked list in O(1),
+ * through the tail kept by the list.
+ *
+ * @param list: The list.
+ * @return DS_OK, or DS_EMPTY.
+ */
+int dlist_delete_end(struct dlist* list) {
+    DS_OP_BEGIN(dlist_stats);
+    if (list->tail == NULL) {
+        DS_OP_END(dlist_stats);
+        return DS_EMPTY;
+    }
+
+    unlink_node(list, list->tail, list->count);
+    DS_OP_END(dlist_stats);
+    return DS_OK;
+}
+
+/**
+ --> Deletion at a Specific Position
+ *
+ * @function dlist_delete_at_position
+ * @description
+ * This function deletes a node at a specific position in a doubly linked list.
+ * The node is reached from the head, the tail or the finger, whichever is
+ * closest, and its neighbours are linked to each other.
+ *
+ * @param list: The list.
+ * @param position: The position of the node to delete (1-based index).
+ * @return DS_OK, DS_EMPTY or DS_BAD_POSITION.
+ */
+int dlist_delete_at_position(struct dlist* list, int position) {
+    DS_OP_BEGIN(dlist_stats);
+    if (list->head == NULL) {
+        DS_OP_END(dlist_stats);
+        return DS_EMPTY;
+    }
+    if (position < 1 || position > list->count) {
+        DS_OP_END(dlist_stats);
+        return DS_BAD_POSITION;
+    }
+
+    unlink_node(list, node_at(list, position), position);
+    DS_OP_END(dlist_stats);
+    return DS_OK;
+}
+
+/**
+ --> Filtering the List
+ *
+ * @function dlist_remove_if
+ * @description
+ * This function deletes, in a single pass, every node whose value `match`
+ * accepts. Matching nodes are unlinked onto a private chain during the walk
+ * and the whole chain is freed at the end in one tight loop. The finger is
+ * dropped when anything was deleted.
+ *
+ * @param list: The list.
+ * @param match: Returns non-zero for the values to delete.
+ * @param ctx: An opaque pointer passed through to `match`.
+ * @return The number of nodes deleted.
+ */
+int dlist_remove_if(struct dlist* list, int (*match)(int val, void* ctx), void* ctx) {
+    DS_OP_BEGIN(dlist_stats);
+    struct dlist_node *temp = list->head, *removed = NULL;
+    int count = 0;
+
+    while (temp != NULL) {
+        struct dlist_node* next_node = temp->next;
+        DS_VISIT(dlist_stats);
+        if (match(temp->data, ctx)) {
+            if (temp->prev == NULL) {
+                list->head = next_node;
+            } else {
+                temp->prev->next = next_node;
+            }
+            if (next_node == NULL) {
+                list->tail = temp->prev;
+            } else {
+                next_node->prev = temp->prev;
+            }
+            temp->next = removed;
+            removed = temp;
+            count++;
+        }
+        temp = next_node;
+    }
+    list->count -= count;
+    if (count > 0) {
+        list->finger = NULL;
+    }
+
+    while (removed != NULL) {
+        struct dlist_node* next_node = removed->next;
+        free_node(removed);
+        DS_FREE(dlist_stats);
+        removed = next_node;
+    }
+    DS_OP_END(dlist_stats);
+    return count;
+}
+
+static int match_intset(int val, void* ctx) {
+    return ds_intset_contains((const struct ds_intset*)ctx, val);
+}
+
+/**
+ * @function dlist_remove_all
+ * @description
+ * This function deletes every node holding any of `values`. The values go
+ * into a small hash set first, so the list is walked once whatever the
+ * number of values.
+ *
+ * @param list: The list.
+ * @param values: The values to delete.
+ * @param count: The number of values.
+ * @return The number of nodes deleted, or DS_NO_MEMORY.
+ */
+int dlist_remove_all(struct dlist* list, const int* values, int count) {
+    struct ds_intset set;
+    int removed;
+    if (ds_intset_init(&set, values, count) != DS_OK) {
+        return DS_NO_MEMORY;
+    }
+    removed = dlist_remove_if(list, match_intset, &set);
+    ds_intset_free(&set);
+    return removed;
+}
+
+/**
+ --> Clearing the List
+ *
+ * @function dlist_clear_list
+ * @description
+ * This function frees every node of a doubly linked list and leaves it
+ * empty; whether the finger is enabled does not change.
+ *
+ * @param list: The list.
+ */
+void dlist_clear_list(struct dlist* list) {
+    DS_OP_BEGIN(dlist_stats);
+    struct dlist_node* temp = list->head;
+    while (temp != NULL) {
+        struct dlist_node* next_node = temp->next;
+        free_node(temp);
+        DS_FREE(dlist_stats);
+        temp = next_node;
+    }
+    list->head = NULL;
+    list->tail = NULL;
+    list->count = 0;
+    list->finger = NULL;
+    list->finger_pos = 0;
+    DS_OP_END(dlist_stats);
+}
+
+/**
+ --> Traversing the List in Reverse
+ *
+ * @function dlist_traverse_reverse
+ * @description
+ * This function starts at the tail kept by the list and follows the `prev`
+ * pointers back to the head, calling `visit` with the data of every node.
+ *
+ * @param list: The list.
+ * @param visit: The function called with every value, from tail to head.
+ * @param ctx: An opaque pointer passed through to `visit`.
+ */
+void dlist_traverse_reverse(const struct dlist* list, void (*visit)(int val, void* ctx), void* ctx) {
+    DS_OP_BEGIN(dlist_stats);
+    struct dlist_node* temp = list->tail;
+    while (temp != NULL) {
+        if (temp->prev != NULL) {
+            __builtin_prefetch(temp->prev->prev);
+        }
+        visit(temp->data, ctx);
+        temp = temp->prev;
+        DS_VISIT(dlist_stats);
+    }
+    DS_OP_END(dlist_stats);
+}
+
+/**
+ --> Relinking Lists
+ *
+ * @function dlist_reverse
+ * @description
+ * This function reverses the list in place by swapping the `prev` and `next`
+ * pointers of every node, then the head and the tail. The finger stays on
+ * its node, whose position is mirrored.
+ *
+ * @param list: The list.
+ */
+void dlist_reverse(struct dlist* list) {
+    DS_OP_BEGIN(dlist_stats);
+    struct dlist_node* temp = list->head;
+    while (temp != NULL) {
+        struct dlist_node* next_node = temp->next;
+        temp->next = temp->prev;
+        temp->prev = next_node;
+        temp = next_node;
+        DS_VISIT(dlist_stats);
+    }
+    temp = list->head;
+    list->head = list->tail;
+    list->tail = temp;
+    if (list->finger != NULL) {
+        list->finger_pos = list->count + 1 - list->finger_pos;
+    }
+    DS_OP_END(dlist_stats);
+}
+
+/**
+ * @function dlist_concatenate
+ * @description
+ * This function moves every node of `other` to the end of `list` in O(1),
+ * by linking the two tails and heads together, and leaves `other` empty.
+ *
+ * @param list: The list to extend.
+ * @param other: The list whose nodes move, a different list.
+ */
+void dlist_concatenate(struct dlist* list, struct dlist* other) {
+    DS_OP_BEGIN(dlist_stats);
+    if (list == other || other->head == NULL) {
+        DS_OP_END(dlist_stats);
+        return;
+    }
+    if (list->tail == NULL) {
+        list->head = other->head;
+    } else {
+        list->tail->next = other->head;
+        other->head->prev = list->tail;
+    }
+    list->tail = other->tail;
+    list->count += other->count;
+
+    other->head = NULL;
+    other->tail = NULL;
+    other->count = 0;
+    other->finger = NULL;
+    DS_OP_END(dlist_stats);
+}
+
+/**
+ * @function dlist_split_at
+ * @description
+ * This function cuts the list in front of `position`: the nodes from
+ * `position` to the end move to `rest`, reached from the closer end, and the
+ * nodes before it stay in `list`. `rest` must be empty, its nodes would
+ * otherwise be lost.
+ *
+ * @param list: The list to split.
+ * @param position: The first position that moves (1 to length + 1).
+ * @param rest: An empty list that receives the moved nodes.
+ * @return DS_OK, or DS_BAD_POSITION.
+ */
+int dlist_split_at(struct dlist* list, int position, struct dlist* rest) {
+    DS_OP_BEGIN(dlist_stats);
+    if (list == rest || position < 1 || position > list->count + 1) {
+        DS_OP_END(dlist_stats);
+        return DS_BAD_POSITION;
+    }
+    rest->finger = NULL;
+    if (position == list->count + 1) {
+        rest->head = NULL;
+        rest->tail = NULL;
+        rest->count = 0;
+        DS_OP_END(dlist_stats);
+        return DS_OK;
+    }
+
+    struct dlist_node* cut = node_at(list, position);
+    rest->head = cut;
+    rest->tail = list->tail;
+    rest->count = list->count - position + 1;
+    list->tail = cut->prev;
+    list->count = position - 1;
+    if (cut->prev == NULL) {
+        list->head = NULL;
+    } else {
+        cut->prev->next = NULL;
+    }
+    cut->prev = NULL;
+    if (list->finger != NULL && list->finger_pos >= position) {
+        list->finger = NULL;
+    }
+    DS_OP_END(dlist_stats);
+    return DS_OK;
+}
+
+/**
+ * @function dlist_splice
+ * @description
+ * This function moves the nodes at positions `from` to `to` of `src` into
+ * `list`, so that the first of them ends up at `position`. Both ends of the
+ * range and the insertion point are reached from the closer end of their
+ * list; the range is then cut out and linked in without allocating.
+ *
+ * @param list: The destination list.
+ * @param position: Where the range goes in `list` (1 to length + 1).
+ * @param src: The source list, a different list.
+ * @param from: The first position of the range in `src`.
+ * @param to: The last position of the range in `src`.
+ * @return DS_OK, or DS_BAD_POSITION.
+ */
+int dlist_splice(struct dlist* list, int position, struct dlist* src, int from, int to) {
+    DS_OP_BEGIN(dlist_stats);
+    if (list == src || position < 1 || position > list->count + 1 || from < 1 || to < from || to > src->count) {
+        DS_OP_END(dlist_stats);
+        return DS_BAD_POSITION;
+    }
+    struct dlist_node* first = node_at(src, from);
+    struct dlist_node* last = node_at(src, to);
+    struct dlist_node* at = position == list->count + 1 ? NULL : node_at(list, position);
+    struct dlist_node* prev;
+    int moved = to - from + 1;
+
+    // Cut the range out of the source
+    if (first->prev == NULL) {
+        src->head = last->next;
+    } else {
+        first->prev->next = last->next;
+    }
+    if (last->next == NULL) {
+        src->tail = first->prev;
+    } else {
+        last->next->prev = first->prev;
+    }
+    src->count -= moved;
+    if (src->finger != NULL && src->finger_pos >= from) {
+        if (src->finger_pos <= to) {
+            src->finger = NULL;
+        } else {
+            src->finger_pos -= moved;
+        }
+    }
+
+    // Link it in front of `at`
+    prev = at == NULL ? list->tail : at->prev;
+    first->prev = prev;
+    last->next = at;
+    if (prev == NULL) {
+        list->head = first;
+    } else {
+        prev->next = first;
+    }
+    if (at == NULL) {
+        list->tail = last;
+    } else {
+        at->prev = last;
+    }
+    list->count += moved;
+    if (list->finger != NULL && list->finger_pos >= position) {
+        list->finger_pos += moved;
+    }
+    DS_OP_END(dlist_stats);
+    return DS_OK;
+}
+
+/**
+ * @function dlist_merge_sorted
+ * @description
+ * This function merges `other` into `list`, both sorted in ascending order,
+ * by relinking their nodes in one pass; `other` is left empty. On equal
+ * values the node of `list` comes first, so the merge is stable.
+ *
+ * @param list: The first sorted list, which receives every node.
+ * @param other: The second sorted list, a different list.
+ */
+void dlist_merge_sorted(struct dlist* list, struct dlist* other) {
+    DS_OP_BEGIN(dlist_stats);
+    struct dlist_node *a = list->head, *b = other->head, *tail = NULL;
+    if (list == other) {
+        DS_OP_END(dlist_stats);
+        return;
+    }
+    list->head = NULL;
+    while (a != NULL || b != NULL) {
+        struct dlist_node* next_node;
+        if (a == NULL || (b != NULL && b->data < a->data)) {
+            next_node = b;
+            b = b->next;
+        } else {
+            next_node = a;
+            a = a->next;
+        }
+        next_node->prev = tail;
+        if (tail == NULL) {
+            list->head = next_node;
+        } else {
+            tail->next = next_node;
+        }
+        tail = next_node;
+        DS_VISIT(dlist_stats);
+    }
+    list->tail = tail;
+    list->count += other->count;
+    list->finger = NULL;
+
+    other->head = NULL;
+    other->tail = NULL;
+    other->count = 0;
+    other->finger = NULL;
+    DS_OP_END(dlist_stats);
+}
+
+/**
+ --> Moving the List into One Block of Nodes
+ *
+ * @function dlist_compact
+ * @description
+ * After long churn the nodes are scattered across the heap and every step of
+ * a scan is a cache miss. This function carves one node per value out of a
+ * single block (see ds_slab.h), copies the values into them from head to
+ * tail and frees the old nodes, so scans sweep the block in one direction
+ * whatever the allocator does with single nodes. The new nodes are freed one
+ * by one like any other; the block goes with the last of them. Values and
+ * their order are unchanged, but every node gets a new address; the finger
+ * moves to the new node at its position.
+ *
+ * @param list: The list.
+ * @return DS_OK, or DS_NO_MEMORY (list untouched) if the block cannot be allocated.
+ */
+int dlist_compact(struct dlist* list) {
+    DS_OP_BEGIN(dlist_stats);
+    struct dlist_node *block, *temp = list->head, *next;
+    int i;
+
+    if (list->count == 0) {
+        DS_OP_END(dlist_stats);
+        return DS_OK;
+    }
+    block = (struct dlist_node*)ds_slab_alloc((size_t)list->count, sizeof(struct dlist_node));
+    if (block == NULL) {
+        DS_OP_END(dlist_stats);
+        return DS_NO_MEMORY;
+    }
+
+    // Nothing can fail from here on, so each old node goes as soon as it is copied
+    for (i = 0; i < list->count; i++) {
+        DS_VISIT(dlist_stats);
+        DS_ALLOC(dlist_stats);
+        block[i].data = temp->data;
+        block[i].slot = (uint32_t)(i + 1);
+        block[i].prev = i > 0 ? &block[i - 1] : NULL;
+        block[i].next = i + 1 < list->count ? &block[i + 1] : NULL;
+        if (temp == list->finger) {
+            list->finger = &block[i];
+        }
+        next = temp->next;
+        free_node(temp);
+        DS_FREE(dlist_stats);
+        temp = next;
+    }
+    list->head = block;
+    list->tail = &block[list->count - 1];
+    DS_OP_END(dlist_stats);
+    return DS_OK;
+}
+
+/**
+ --> Binary Snapshot of the List
+ *
+ * The file holds a 4-byte magic ("DLL1"), a `uint32_t` node count and then
+ * the `int32_t` values from head to tail.
+ */
+static const char LIST_MAGIC[4] = {'D', 'L', 'L', '1'};
+
+/**
+ * @function dlist_save
+ * @description
+ * This function writes the list to a binary snapshot file. The values are
+ * gathered into one buffer first so the payload goes out in a single `fwrite`.
+ *
+ * @param list: The list.
+ * @param path: The name of the file to write.
+ * @return 0 on success, -1 if the file could not be written.
+ */
+int dlist_save(const struct dlist* list, const char* path) {
+    uint32_t count = (uint32_t)list->count, i = 0;
+    struct dlist_node* temp;
+    int32_t* values;
+    FILE* fp;
+    int status = -1;
+
+    values = (int32_t*)malloc((count ? count : 1) * sizeof(int32_t));
+    if (values == NULL) {
+        return -1;
+    }
+    for (temp = list->head; temp != NULL; temp = temp->next) {
+        values[i++] = temp->data;
+    }
+
+    fp = fopen(path, "wb");
+    if (fp != NULL) {
+        if (fwrite(LIST_MAGIC, sizeof(LIST_MAGIC), 1, fp) == 1 &&
+            fwrite(&count, sizeof(count), 1, fp) == 1 &&
+            fwrite(values, sizeof(int32_t), count, fp) == count) {
+            status = 0;
+        }
+        if (fclose(fp) != 0) {
+            status = -1;
+        }
+    }
+    free(values);
+    return status;
+}
+
+/**
+ * @function dlist_load
+ * @description
+ * This function replaces the list with the content of a snapshot file.
+ * All values are read with one `fread`, then the nodes are linked in a single
+ * pass through a tail pointer. The old list is cleared only after the new one
+ * has been built, so a failed load leaves it untouched.
+ *
+ * @param list: The list.
+ * @param path: The name of the file to read.
+ * @return 0 on success, -1 if the file is missing, malformed or memory ran out.
+ */
+int dlist_load(struct dlist* list, const char* path) {
+    char magic[4];
+    uint32_t count, i;
+    int32_t* values;
+    struct dlist_node *new_head = NULL, *tail = NULL;
+    FILE* fp = fopen(path, "rb");
+
+    if (fp == NULL) {
+        return -1;
+    }
+    if (fread(magic, sizeof(magic), 1, fp) != 1 || memcmp(magic, LIST_MAGIC, sizeof(magic)) != 0 ||
+        fread(&count, sizeof(count), 1, fp) != 1 || count > INT_MAX) {
+        fclose(fp);
+        return -1;
+    }
+    values = (int32_t*)malloc((count ? count : 1) * sizeof(int32_t));
+    if (values == NULL || fread(values, sizeof(int32_t), count, fp) != count) {
+        free(values);
+        fclose(fp);
+        return -1;
+    }
+    fclose(fp);
+
+    for (i = 0; i < count; i++) {
+        struct dlist_node* new_node = (struct dlist_node*)malloc(sizeof(struct dlist_node));
+        if (new_node == NULL) {
+            while (new_head != NULL) {
+                struct dlist_node* next_node = new_head->next;
+                free_node(new_head);
+                DS_FREE(dlist_stats);
+                new_head = next_node;
+            }
+            free(values);
+            return -1;
+        }
+        DS_ALLOC(dlist_stats);
+        new_node->data = values[i];
+        new_node->slot = 0;
+        new_node->prev = tail;
+        new_node->next = NULL;
+        if (tail == NULL) {
+            new_head = new_node;
+        } else {
+            tail->next = new_node;
+        }
+        tail = new_node;
+    }
+    free(values);
+
+    dlist_clear_list(list);
+    list->head = new_head;
+    list->tail = tail;
+    list->count = (int)count;
+    return 0;
+}
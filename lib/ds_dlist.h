@@ -0,0 +1,140 @@
+#ifndef DS_DLIST_H
+#define DS_DLIST_H
+
+#include <stdint.h>
+#include "ds_stats.h"
+#include "ds_status.h"
+
+/**
+ * @file ds_dlist.h
+ * Doubly linked list of integers. Every function takes a `struct dlist`
+ * handle, which knows both ends and the length of the list, so positional
+ * operations walk from the closer end. Nothing here prints: operations
+ * return a ds_status (see ds_status.h) or a value.
+ */
+
+/**
+ --> Creating the Node of a doubly linked list
+ *
+ * @struct dlist_node
+ * @description
+ * This structure represents a single node in a doubly linked list.
+ * Each node stores:
+ * - `data`: An integer value that holds the data for the node.
+ * - `slot`: 0 for a node allocated on its own, otherwise its place in the
+ *           block dlist_compact() carved it from (see ds_slab.h). Code that
+ *           mallocs a node itself must set it to 0, and only the list
+ *           functions may free a node.
+ * - `prev`: A pointer to the previous node in the linked list.
+ * - `next`: A pointer to the next node in the linked list.
+ */
+struct dlist_node {
+    int data;
+    uint32_t slot;
+    struct dlist_node* prev;
+    struct dlist_node* next;
+};
+
+/**
+ * @struct dlist
+ * @description
+ * - `head`, `tail`: The first and last nodes, `NULL` when the list is empty.
+ * - `count`: The number of nodes.
+ * - `use_finger`: Non-zero to remember the node of the last positional access
+ *                 (off by default, see dlist_use_finger()).
+ * - `finger`, `finger_pos`: That node and its position, `NULL` when unset.
+ */
+struct dlist {
+    struct dlist_node* head;
+    struct dlist_node* tail;
+    int count;
+    int use_finger;
+    struct dlist_node* finger;
+    int finger_pos;
+};
+
+/**
+ * Counters for the list operations, only compiled in with -DDS_INSTRUMENT
+ * (see ds_stats.h). `max_visited` is the longest walk of a single operation.
+ */
+DS_STATS_DECLARE(dlist_stats);
+
+/** Creates an empty list, without a finger. */
+void dlist_init(struct dlist* list);
+
+/**
+ * Turns the finger on or off. With the finger on, a positional operation may
+ * start from the last position accessed, so walking positions in order
+ * (get_at 1, 2, 3, ...) costs O(1) per call instead of O(n).
+ */
+void dlist_use_finger(struct dlist* list, int enabled);
+
+/** Returns the number of nodes in the list. */
+static inline int dlist_count_of_nodes(const struct dlist* list) {
+    return list->count;
+}
+
+/** Calls `visit` with the data of every node from head to tail. */
+void dlist_traverse(const struct dlist* list, void (*visit)(int val, void* ctx), void* ctx);
+
+/** Inserts a new node holding `data` at the beginning of the list, returns DS_OK or DS_NO_MEMORY. */
+int dlist_add_beg(struct dlist* list, int data);
+
+/** Inserts a new node holding `data` at the end of the list, returns DS_OK or DS_NO_MEMORY. */
+int dlist_add_at_end(struct dlist* list, int data);
+
+/** Inserts a new node holding `data` at `position` (1 to length + 1), returns a ds_status. */
+int dlist_insert_at_position(struct dlist* list, int data, int position);
+
+/** Stores the value at `position` (1-based) in `*val`, returns DS_OK, DS_EMPTY or DS_BAD_POSITION. */
+int dlist_get_at(struct dlist* list, int position, int* val);
+
+/** Deletes the first node holding `value`, returns DS_OK, DS_EMPTY or DS_NOT_FOUND. */
+int dlist_delete_by_value(struct dlist* list, int value);
+
+/** Deletes the first node of the list, returns DS_OK or DS_EMPTY. */
+int dlist_delete_beg(struct dlist* list);
+
+/** Deletes the last node of the list, returns DS_OK or DS_EMPTY. */
+int dlist_delete_end(struct dlist* list);
+
+/** Deletes the node at `position` (1-based), returns DS_OK, DS_EMPTY or DS_BAD_POSITION. */
+int dlist_delete_at_position(struct dlist* list, int position);
+
+/** Deletes every node whose value `match` accepts in one pass, returns the number deleted. */
+int dlist_remove_if(struct dlist* list, int (*match)(int val, void* ctx), void* ctx);
+
+/** Deletes every node holding one of the `count` values in one pass, returns the number deleted or DS_NO_MEMORY. */
+int dlist_remove_all(struct dlist* list, const int* values, int count);
+
+/** Frees every node and leaves the list empty. */
+void dlist_clear_list(struct dlist* list);
+
+/** Calls `visit` with the data of every node from tail to head. */
+void dlist_traverse_reverse(const struct dlist* list, void (*visit)(int val, void* ctx), void* ctx);
+
+/** Reverses the list in place by relinking its nodes. */
+void dlist_reverse(struct dlist* list);
+
+/** Moves every node of `other` to the end of `list` in O(1), leaving `other` empty. */
+void dlist_concatenate(struct dlist* list, struct dlist* other);
+
+/** Moves the nodes from `position` (1 to length + 1) on to the empty list `rest`, returns DS_OK or DS_BAD_POSITION. */
+int dlist_split_at(struct dlist* list, int position, struct dlist* rest);
+
+/** Moves positions `from`..`to` of `src` into `list` at `position`, returns DS_OK or DS_BAD_POSITION. */
+int dlist_splice(struct dlist* list, int position, struct dlist* src, int from, int to);
+
+/** Merges the sorted list `other` into the sorted list `list` without allocating, leaving `other` empty. */
+void dlist_merge_sorted(struct dlist* list, struct dlist* other);
+
+/** Moves the values into nodes carved in list order from one block, for faster scans; returns DS_OK or DS_NO_MEMORY. */
+int dlist_compact(struct dlist* list);
+
+/** Writes the list to a binary snapshot file, returns 0 on success. */
+int dlist_save(const struct dlist* list, const char* path);
+
+/** Replaces the list with the content of a snapshot file, returns 0 on success. */
+int dlist_load(struct dlist* list, const char* path);
+
+#endif
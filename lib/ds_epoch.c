@@ -0,0 +1,89 @@
+#include <stdlib.h>
+#include "ds_epoch.h"
+
+static void** chain_link(const struct ds_epoch* e, void* obj) {
+    return (void**)((char*)obj + e->link);
+}
+
+static void free_chain(const struct ds_epoch* e, void* obj) {
+    while (obj != NULL) {
+        void* next = *chain_link(e, obj);
+        free(obj);
+        obj = next;
+    }
+}
+
+void ds_epoch_init(struct ds_epoch* e, size_t link) {
+    int i;
+    e->epoch = 0;
+    e->link = link;
+    for (i = 0; i < 3; i++) {
+        e->limbo[i] = NULL;
+    }
+    for (i = 0; i < DS_EPOCH_MAX_THREADS; i++) {
+        e->slots[i].epoch = 0;
+        e->slots[i].active = 0;
+        e->slots[i].used = 0;
+    }
+}
+
+// Function to free every retired object
+void ds_epoch_free(struct ds_epoch* e) {
+    int i;
+    for (i = 0; i < 3; i++) {
+        free_chain(e, e->limbo[i]);
+    }
+    ds_epoch_init(e, e->link);
+}
+
+// Function to get a slot for the calling thread
+int ds_epoch_register(struct ds_epoch* e) {
+    int i;
+    for (i = 0; i < DS_EPOCH_MAX_THREADS; i++) {
+        int expected = 0;
+        if (__atomic_compare_exchange_n(&e->slots[i].used, &expected, 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            return i;
+        }
+    }
+    return DS_NO_MEMORY;
+}
+
+// Function to give the slot back
+void ds_epoch_unregister(struct ds_epoch* e, int slot) {
+    __atomic_store_n(&e->slots[slot].active, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&e->slots[slot].used, 0, __ATOMIC_RELEASE);
+}
+
+// Move to the next epoch if every active thread has seen the current one.
+// Only the thread whose compare-and-swap moves it frees the oldest list;
+// nobody is still retiring into that list, since a retiring thread holds the
+// epoch back to at most one past its own
+static void try_advance(struct ds_epoch* e) {
+    unsigned long epoch = __atomic_load_n(&e->epoch, __ATOMIC_ACQUIRE);
+    int i;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    for (i = 0; i < DS_EPOCH_MAX_THREADS; i++) {
+        struct ds_epoch_slot* s = &e->slots[i];
+        if (__atomic_load_n(&s->active, __ATOMIC_ACQUIRE) && __atomic_load_n(&s->epoch, __ATOMIC_RELAXED) != epoch) {
+            return;
+        }
+    }
+    if (__atomic_compare_exchange_n(&e->epoch, &epoch, epoch + 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+        free_chain(e, __atomic_exchange_n(&e->limbo[(epoch + 2) % 3], NULL, __ATOMIC_ACQUIRE));
+    }
+}
+
+// Function to hand an unlinked object to the reclamation
+// The fence orders the unlink before the epoch is read, so a thread that
+// enters a later epoch cannot find the object any more
+void ds_epoch_retire(struct ds_epoch* e, void* obj) {
+    void** head;
+    void* first;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    head = &e->limbo[__atomic_load_n(&e->epoch, __ATOMIC_ACQUIRE) % 3];
+    first = __atomic_load_n(head, __ATOMIC_RELAXED);
+    do {
+        *chain_link(e, obj) = first;
+    } while (!__atomic_compare_exchange_n(head, &first, obj, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    try_advance(e);
+}
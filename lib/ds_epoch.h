@@ -0,0 +1,69 @@
+#ifndef DS_EPOCH_H
+#define DS_EPOCH_H
+
+#include <stddef.h>
+#include "ds_status.h"
+
+// Epoch-based reclamation for the structures that readers walk without
+// locking (ctree, cskiplist). A thread announces the epoch it started in
+// before it touches any node and withdraws when it is done. An unlinked node
+// is retired into the limbo list of the current epoch, and the epoch moves on
+// once every active thread has seen it: nodes retired two epochs back were
+// unlinked before any of those threads started, so nobody can reach them any
+// more and they are freed.
+//
+// Retired objects are chained through a pointer field inside them, at the
+// offset given to ds_epoch_init(), and released with free().
+
+#define DS_EPOCH_MAX_THREADS 64
+
+// One slot per registered thread, on its own cache line: the alignment starts
+// the slots array on a line boundary and rounds every slot up to a whole line,
+// so a slot shares its line neither with the global fields nor with another
+// slot. A structure holding a struct ds_epoch inherits the alignment, which
+// holds for static and automatic storage; heap copies need aligned_alloc()
+struct ds_epoch_slot {
+    unsigned long epoch;
+    int active;
+    int used;
+} __attribute__((aligned(64)));
+
+struct ds_epoch {
+    unsigned long epoch;        // global epoch
+    size_t link;                // offset of the chain pointer in a retired object
+    void* limbo[3];             // retired objects, by epoch modulo 3
+    struct ds_epoch_slot slots[DS_EPOCH_MAX_THREADS];
+};
+
+void ds_epoch_init(struct ds_epoch* e, size_t link);
+
+// Function to free every retired object, no thread may use the structure any more
+void ds_epoch_free(struct ds_epoch* e);
+
+// Function to get a slot for the calling thread, returns it or DS_NO_MEMORY if all are taken
+int ds_epoch_register(struct ds_epoch* e);
+
+// Function to give the slot back when the thread is done with the structure
+void ds_epoch_unregister(struct ds_epoch* e, int slot);
+
+// Function to announce the epoch before touching any node; the fence orders
+// that announcement before the first load of a link, and pairs with the one
+// taken before the slots are checked
+static inline void ds_epoch_enter(struct ds_epoch* e, int slot) {
+    struct ds_epoch_slot* s = &e->slots[slot];
+    __atomic_store_n(&s->epoch, __atomic_load_n(&e->epoch, __ATOMIC_ACQUIRE), __ATOMIC_RELAXED);
+    __atomic_store_n(&s->active, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void ds_epoch_exit(struct ds_epoch* e, int slot) {
+    __atomic_store_n(&e->slots[slot].active, 0, __ATOMIC_RELEASE);
+}
+
+// Function to hand an object that can no longer be reached from the structure
+// to the reclamation. Callers either are inside the epoch (between enter and
+// exit) or are serialised by a lock, so the epoch cannot move past theirs
+// while they retire
+void ds_epoch_retire(struct ds_epoch* e, void* obj);
+
+#endif
@@ -0,0 +1,248 @@
+#ifndef DS_ILIST_H
+#define DS_ILIST_H
+
+#include <stddef.h>
+#include "ds_status.h"
+
+/**
+ * @file ds_ilist.h
+ * Intrusive singly and doubly linked lists. Instead of allocating a node
+ * that holds the data, the caller embeds a link in its own struct and the
+ * list only chains those links together:
+ *
+ *     struct order {
+ *         int id;
+ *         struct idlist_link by_time;   // an order can sit on several lists
+ *     };
+ *
+ *     idlist_add_at_end(&pending, &o->by_time);
+ *     struct order *first = ds_container_of(idlist_first(&pending), struct order, by_time);
+ *
+ * Nothing here allocates or frees: the objects belong to the caller, who
+ * must unlink an object before freeing it. Everything is inline, there is no
+ * library code behind this header.
+ */
+
+/** Pointer to the struct of type `type` whose member `member` is at `ptr`. */
+#define ds_container_of(ptr, type, member) ((type *)((char *)(ptr) - offsetof(type, member)))
+
+/** Match callback for the search functions, returns non-zero on the wanted link. */
+typedef int (*ilist_match_fn)(const void *link, void *ctx);
+
+/**
+ --> Intrusive Singly Linked List
+ *
+ * @struct islist_link
+ * @description
+ * The link embedded in the caller's struct. `next` is the following link,
+ * `NULL` on the last one.
+ */
+struct islist_link {
+    struct islist_link *next;
+};
+
+/** A singly linked list is a handle on its first link. */
+struct islist {
+    struct islist_link *head;
+};
+
+#define ISLIST_FOR_EACH(pos, list) for ((pos) = (list)->head; (pos) != NULL; (pos) = (pos)->next)
+
+static inline void islist_init(struct islist *list) {
+    list->head = NULL;
+}
+
+static inline int islist_is_empty(const struct islist *list) {
+    return list->head == NULL;
+}
+
+/** Inserts `link` at the beginning of the list. */
+static inline void islist_add_beg(struct islist *list, struct islist_link *link) {
+    link->next = list->head;
+    list->head = link;
+}
+
+/** Inserts `link` right after `pos`, which must be on the list. */
+static inline void islist_insert_after(struct islist_link *pos, struct islist_link *link) {
+    link->next = pos->next;
+    pos->next = link;
+}
+
+/** Unlinks and returns the first link, NULL if the list is empty. */
+static inline struct islist_link *islist_delete_beg(struct islist *list) {
+    struct islist_link *link = list->head;
+    if (link != NULL) {
+        list->head = link->next;
+        link->next = NULL;
+    }
+    return link;
+}
+
+/** Unlinks `link` from the list in one walk, returns DS_OK or DS_NOT_FOUND. */
+static inline int islist_delete(struct islist *list, struct islist_link *link) {
+    struct islist_link **pp = &list->head;
+    while (*pp != NULL && *pp != link) {
+        pp = &(*pp)->next;
+    }
+    if (*pp == NULL) {
+        return DS_NOT_FOUND;
+    }
+    *pp = link->next;
+    link->next = NULL;
+    return DS_OK;
+}
+
+/** Returns the first link for which `match` returns non-zero, NULL if there is none. */
+static inline struct islist_link *islist_search(const struct islist *list, ilist_match_fn match, void *ctx) {
+    struct islist_link *pos;
+    ISLIST_FOR_EACH(pos, list) {
+        if (match(pos, ctx)) {
+            return pos;
+        }
+    }
+    return NULL;
+}
+
+/** Reverses the order of the links in place. */
+static inline void islist_reverse(struct islist *list) {
+    struct islist_link *prev = NULL, *curr = list->head;
+    while (curr != NULL) {
+        struct islist_link *next = curr->next;
+        curr->next = prev;
+        prev = curr;
+        curr = next;
+    }
+    list->head = prev;
+}
+
+/** Returns the number of links on the list. */
+static inline int islist_count(const struct islist *list) {
+    const struct islist_link *pos;
+    int count = 0;
+    for (pos = list->head; pos != NULL; pos = pos->next) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ --> Intrusive Doubly Linked List
+ *
+ * @struct idlist_link
+ * @description
+ * The link embedded in the caller's struct. The list is circular around a
+ * sentinel link stored in the list handle, so insertion and deletion never
+ * test for the ends and deleting a known object is O(1).
+ */
+struct idlist_link {
+    struct idlist_link *prev;
+    struct idlist_link *next;
+};
+
+/** A doubly linked list is its sentinel; `head.next` is the first link, `head.prev` the last. */
+struct idlist {
+    struct idlist_link head;
+};
+
+#define IDLIST_FOR_EACH(pos, list) \
+    for ((pos) = (list)->head.next; (pos) != &(list)->head; (pos) = (pos)->next)
+
+#define IDLIST_FOR_EACH_REVERSE(pos, list) \
+    for ((pos) = (list)->head.prev; (pos) != &(list)->head; (pos) = (pos)->prev)
+
+static inline void idlist_init(struct idlist *list) {
+    list->head.prev = &list->head;
+    list->head.next = &list->head;
+}
+
+static inline int idlist_is_empty(const struct idlist *list) {
+    return list->head.next == &list->head;
+}
+
+/** Inserts `link` before `pos`, which is a link on the list or the sentinel. */
+static inline void idlist_insert_before(struct idlist_link *pos, struct idlist_link *link) {
+    link->prev = pos->prev;
+    link->next = pos;
+    pos->prev->next = link;
+    pos->prev = link;
+}
+
+/** Inserts `link` at the beginning of the list. */
+static inline void idlist_add_beg(struct idlist *list, struct idlist_link *link) {
+    idlist_insert_before(list->head.next, link);
+}
+
+/** Inserts `link` at the end of the list. */
+static inline void idlist_add_at_end(struct idlist *list, struct idlist_link *link) {
+    idlist_insert_before(&list->head, link);
+}
+
+/** Unlinks `link` from whatever list it is on, in O(1). */
+static inline void idlist_delete(struct idlist_link *link) {
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->prev = NULL;
+    link->next = NULL;
+}
+
+/** Returns the first link, NULL if the list is empty. */
+static inline struct idlist_link *idlist_first(const struct idlist *list) {
+    return idlist_is_empty(list) ? NULL : list->head.next;
+}
+
+/** Returns the last link, NULL if the list is empty. */
+static inline struct idlist_link *idlist_last(const struct idlist *list) {
+    return idlist_is_empty(list) ? NULL : list->head.prev;
+}
+
+/** Unlinks and returns the first link, NULL if the list is empty. */
+static inline struct idlist_link *idlist_delete_beg(struct idlist *list) {
+    struct idlist_link *link = idlist_first(list);
+    if (link != NULL) {
+        idlist_delete(link);
+    }
+    return link;
+}
+
+/** Unlinks and returns the last link, NULL if the list is empty. */
+static inline struct idlist_link *idlist_delete_end(struct idlist *list) {
+    struct idlist_link *link = idlist_last(list);
+    if (link != NULL) {
+        idlist_delete(link);
+    }
+    return link;
+}
+
+/** Returns the first link for which `match` returns non-zero, NULL if there is none. */
+static inline struct idlist_link *idlist_search(const struct idlist *list, ilist_match_fn match, void *ctx) {
+    struct idlist_link *pos;
+    IDLIST_FOR_EACH(pos, list) {
+        if (match(pos, ctx)) {
+            return pos;
+        }
+    }
+    return NULL;
+}
+
+/** Reverses the order of the links in place by swapping every prev/next pair. */
+static inline void idlist_reverse(struct idlist *list) {
+    struct idlist_link *pos = &list->head;
+    do {
+        struct idlist_link *next = pos->next;
+        pos->next = pos->prev;
+        pos->prev = next;
+        pos = next;
+    } while (pos != &list->head);
+}
+
+/** Returns the number of links on the list. */
+static inline int idlist_count(const struct idlist *list) {
+    const struct idlist_link *pos;
+    int count = 0;
+    for (pos = list->head.next; pos != &list->head; pos = pos->next) {
+        count++;
+    }
+    return count;
+}
+
+#endif
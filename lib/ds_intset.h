@@ -0,0 +1,86 @@
+#ifndef DS_INTSET_H
+#define DS_INTSET_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ds_status.h"
+
+/**
+ * @file ds_intset.h
+ * Small read-only set of integers for the filtering passes of the lists
+ * (`*_remove_all`): built once from an array, then asked about every node.
+ * Open addressing with linear probing over a power-of-two table kept at most
+ * half full. Sets of up to DS_INTSET_INLINE / 2 values live inside the struct,
+ * so the common case does not allocate.
+ */
+
+#define DS_INTSET_INLINE 64
+
+struct ds_intset {
+    int32_t *keys;
+    unsigned char *used;
+    unsigned shift;
+    int32_t inline_keys[DS_INTSET_INLINE];
+    unsigned char inline_used[DS_INTSET_INLINE];
+};
+
+static inline uint32_t ds_intset_slot(const struct ds_intset *set, int value) {
+    // Fibonacci hashing: the high bits of the product are well mixed
+    return ((uint32_t)value * 0x9E3779B1u) >> set->shift;
+}
+
+/** Builds the set from `count` values (duplicates are fine), returns DS_OK or DS_NO_MEMORY. */
+static inline int ds_intset_init(struct ds_intset *set, const int *values, int count) {
+    unsigned bits = 6;
+    size_t size;
+    int i;
+
+    while (bits < 31 && ((size_t)1 << bits) < (size_t)count * 2) {
+        bits++;
+    }
+    size = (size_t)1 << bits;
+    if (size == DS_INTSET_INLINE) {
+        set->keys = set->inline_keys;
+        set->used = set->inline_used;
+    } else {
+        set->keys = (int32_t *)malloc(size * (sizeof(int32_t) + 1));
+        if (set->keys == NULL) {
+            return DS_NO_MEMORY;
+        }
+        set->used = (unsigned char *)(set->keys + size);
+    }
+    memset(set->used, 0, size);
+    set->shift = 32 - bits;
+
+    for (i = 0; i < count; i++) {
+        uint32_t slot = ds_intset_slot(set, values[i]);
+        while (set->used[slot] && set->keys[slot] != values[i]) {
+            slot = (slot + 1) & (uint32_t)(size - 1);
+        }
+        set->keys[slot] = values[i];
+        set->used[slot] = 1;
+    }
+    return DS_OK;
+}
+
+/** Returns non-zero if `value` is in the set. */
+static inline int ds_intset_contains(const struct ds_intset *set, int value) {
+    uint32_t mask = (UINT32_C(1) << (32 - set->shift)) - 1;
+    uint32_t slot = ds_intset_slot(set, value);
+    while (set->used[slot]) {
+        if (set->keys[slot] == value) {
+            return 1;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return 0;
+}
+
+static inline void ds_intset_free(struct ds_intset *set) {
+    if (set->keys != set->inline_keys) {
+        free(set->keys);
+    }
+}
+
+#endif
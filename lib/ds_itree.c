@@ -0,0 +1,225 @@
+#include <stdlib.h>
+#include "ds_itree.h"
+
+DS_STATS_DEFINE(itree_stats, "itree");
+
+// Function to order two intervals by start, then end
+static int compare(int start, int end, const struct itree_node* node) {
+    if (start != node->start) {
+        return start < node->start ? -1 : 1;
+    }
+    if (end != node->end) {
+        return end < node->end ? -1 : 1;
+    }
+    return 0;
+}
+
+static int height(const struct itree_node* node) {
+    return node != NULL ? node->height : 0;
+}
+
+// Function to recompute the height and max_end of a node from its children
+static void update(struct itree_node* node) {
+    int left = height(node->left), right = height(node->right);
+    node->height = 1 + (left > right ? left : right);
+    node->max_end = node->end;
+    if (node->left != NULL && node->left->max_end > node->max_end) {
+        node->max_end = node->left->max_end;
+    }
+    if (node->right != NULL && node->right->max_end > node->max_end) {
+        node->max_end = node->right->max_end;
+    }
+}
+
+// Rotations move two nodes; the moved-down one is updated before its new parent
+static struct itree_node* rotate_right(struct itree_node* node) {
+    struct itree_node* left = node->left;
+    node->left = left->right;
+    left->right = node;
+    update(node);
+    update(left);
+    return left;
+}
+
+static struct itree_node* rotate_left(struct itree_node* node) {
+    struct itree_node* right = node->right;
+    node->right = right->left;
+    right->left = node;
+    update(node);
+    update(right);
+    return right;
+}
+
+// Function to restore the AVL balance of a node whose subtrees changed, returns the new subtree root
+static struct itree_node* rebalance(struct itree_node* node) {
+    int balance;
+    update(node);
+    balance = height(node->left) - height(node->right);
+    if (balance > 1) {
+        if (height(node->left->left) < height(node->left->right)) {
+            node->left = rotate_left(node->left);
+        }
+        return rotate_right(node);
+    }
+    if (balance < -1) {
+        if (height(node->right->right) < height(node->right->left)) {
+            node->right = rotate_right(node->right);
+        }
+        return rotate_left(node);
+    }
+    return node;
+}
+
+// Recursion is bounded by the height, which balancing keeps at O(log n)
+static struct itree_node* insert_node(struct itree_node* node, int start, int end, int* status) {
+    int order;
+    if (node == NULL) {
+        node = (struct itree_node*)malloc(sizeof(struct itree_node));
+        if (node == NULL) {
+            *status = DS_NO_MEMORY;
+            return NULL;
+        }
+        DS_ALLOC(itree_stats);
+        node->start = start;
+        node->end = end;
+        node->max_end = end;
+        node->height = 1;
+        node->left = NULL;
+        node->right = NULL;
+        return node;
+    }
+    DS_VISIT(itree_stats);
+    order = compare(start, end, node);
+    if (order == 0) {
+        *status = DS_EXISTS;
+        return node;
+    }
+    if (order < 0) {
+        struct itree_node* left = insert_node(node->left, start, end, status);
+        if (*status != DS_OK) {
+            return node;
+        }
+        node->left = left;
+    } else {
+        struct itree_node* right = insert_node(node->right, start, end, status);
+        if (*status != DS_OK) {
+            return node;
+        }
+        node->right = right;
+    }
+    return rebalance(node);
+}
+
+int itree_insert(struct itree* t, int start, int end) {
+    int status = DS_OK;
+    if (end < start) {
+        return DS_BAD_POSITION;
+    }
+    DS_OP_BEGIN(itree_stats);
+    t->root = insert_node(t->root, start, end, &status);
+    if (status == DS_OK) {
+        t->count++;
+    }
+    DS_OP_END(itree_stats);
+    return status;
+}
+
+// A node with two children takes the interval of its successor, the leftmost
+// node of its right subtree, which is then deleted from there instead
+static struct itree_node* delete_node(struct itree_node* node, int start, int end, int* status) {
+    int order;
+    if (node == NULL) {
+        *status = DS_NOT_FOUND;
+        return NULL;
+    }
+    DS_VISIT(itree_stats);
+    order = compare(start, end, node);
+    if (order < 0) {
+        node->left = delete_node(node->left, start, end, status);
+    } else if (order > 0) {
+        node->right = delete_node(node->right, start, end, status);
+    } else if (node->left != NULL && node->right != NULL) {
+        struct itree_node* successor = node->right;
+        while (successor->left != NULL) {
+            DS_VISIT(itree_stats);
+            successor = successor->left;
+        }
+        node->start = successor->start;
+        node->end = successor->end;
+        node->right = delete_node(node->right, successor->start, successor->end, status);
+    } else {
+        struct itree_node* child = node->left != NULL ? node->left : node->right;
+        free(node);
+        DS_FREE(itree_stats);
+        return child;
+    }
+    return rebalance(node);
+}
+
+int itree_delete(struct itree* t, int start, int end) {
+    int status = DS_OK;
+    DS_OP_BEGIN(itree_stats);
+    t->root = delete_node(t->root, start, end, &status);
+    if (status == DS_OK) {
+        t->count--;
+    }
+    DS_OP_END(itree_stats);
+    return status;
+}
+
+// Subtrees whose largest end is before lo hold no overlap; nor does the right
+// subtree of a node starting after hi, since everything there starts later
+static long overlap(const struct itree_node* node, int lo, int hi,
+                    void (*visit)(int start, int end, void* ctx), void* ctx) {
+    long found = 0;
+    while (node != NULL && node->max_end >= lo) {
+        DS_VISIT(itree_stats);
+        found += overlap(node->left, lo, hi, visit, ctx);
+        if (node->start > hi) {
+            break;
+        }
+        if (node->end >= lo) {
+            if (visit != NULL) {
+                visit(node->start, node->end, ctx);
+            }
+            found++;
+        }
+        node = node->right;  // Loop instead of recursing on the right
+    }
+    return found;
+}
+
+long itree_overlap(const struct itree* t, int lo, int hi,
+                   void (*visit)(int start, int end, void* ctx), void* ctx) {
+    long found;
+    DS_OP_BEGIN(itree_stats);
+    found = lo <= hi ? overlap(t->root, lo, hi, visit, ctx) : 0;
+    DS_OP_END(itree_stats);
+    return found;
+}
+
+static void inorder(const struct itree_node* node, void (*visit)(int start, int end, void* ctx), void* ctx) {
+    if (node != NULL) {
+        inorder(node->left, visit, ctx);        // Traverse the left subtree
+        visit(node->start, node->end, ctx);     // Visit the root
+        inorder(node->right, visit, ctx);       // Traverse the right subtree
+    }
+}
+
+void itree_inorder(const struct itree* t, void (*visit)(int start, int end, void* ctx), void* ctx) {
+    inorder(t->root, visit, ctx);
+}
+
+static void free_nodes(struct itree_node* node) {
+    if (node != NULL) {
+        free_nodes(node->left);
+        free_nodes(node->right);
+        free(node);
+        DS_FREE(itree_stats);
+    }
+}
+
+void itree_free(struct itree* t) {
+    free_nodes(t->root);
+    itree_init(t);
+}
@@ -0,0 +1,71 @@
+#ifndef DS_ITREE_H
+#define DS_ITREE_H
+
+#include <stddef.h>
+#include "ds_stats.h"
+#include "ds_status.h"
+
+// Interval tree: a binary search tree of closed intervals [start, end] keyed
+// by start (then end), where every node also holds the largest end in its
+// subtree. A query skips every subtree whose largest end is before the range
+// and, as in any search tree, every right subtree that starts after it. The
+// tree is kept AVL-balanced, which the max_end fields survive since a rotation
+// only has to recompute them for the two nodes it moves, so insert and delete
+// are O(log n) and a query is O(log n) per interval reported, O(log n) when
+// there is none.
+//
+// Each (start, end) pair is stored once, like the keys of radix_tree.
+
+struct itree_node {
+    int start;
+    int end;
+    int max_end;    // largest end in this subtree
+    int height;     // of this subtree, 1 for a leaf
+    struct itree_node* left;
+    struct itree_node* right;
+};
+
+struct itree {
+    struct itree_node* root;
+    long count;
+};
+
+// Counters, only compiled in with -DDS_INSTRUMENT
+DS_STATS_DECLARE(itree_stats);
+
+static inline void itree_init(struct itree* t) {
+    t->root = NULL;
+    t->count = 0;
+}
+
+// Function to free every node of the tree
+void itree_free(struct itree* t);
+
+// Function to insert [start, end], returns DS_OK, DS_EXISTS, DS_NO_MEMORY,
+// or DS_BAD_POSITION if end is before start
+int itree_insert(struct itree* t, int start, int end);
+
+// Function to delete [start, end], returns DS_OK or DS_NOT_FOUND
+int itree_delete(struct itree* t, int start, int end);
+
+// Function to find the intervals that overlap [lo, hi], calls visit() on each
+// in order of start; returns how many there are
+long itree_overlap(const struct itree* t, int lo, int hi,
+                   void (*visit)(int start, int end, void* ctx), void* ctx);
+
+// Function to find the intervals that contain point, calls visit() on each
+// in order of start (visit may be NULL); returns how many there are
+static inline long itree_stab(const struct itree* t, int point,
+                              void (*visit)(int start, int end, void* ctx), void* ctx) {
+    return itree_overlap(t, point, point, visit, ctx);
+}
+
+// Inorder traversal function LNR, calls visit() on every interval
+void itree_inorder(const struct itree* t, void (*visit)(int start, int end, void* ctx), void* ctx);
+
+// Function to get the number of intervals
+static inline long itree_count(const struct itree* t) {
+    return t->count;
+}
+
+#endif
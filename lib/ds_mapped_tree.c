@@ -0,0 +1,206 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ds_mapped_tree.h"
+
+static const char MAPPED_MAGIC[4] = {'B', 'S', 'T', 'M'};
+
+// Function to convert an in-memory tree to the mapped file format, returns 0 on success
+int mapped_tree_write(struct tree_node* root, const char* path) {
+    struct Frame {
+        struct tree_node* node;
+        uint32_t parent;   // record whose link must be patched, UINT32_MAX for the root
+        uint32_t depth;
+        int is_right;
+    };
+    struct mapped_tree_header header;
+    uint32_t count = tree_count_nodes(root), n = 0, sp = 0;
+    struct mapped_tree_node* records;
+    struct Frame* stack;
+    FILE* fp;
+    int status = -1;
+
+    if ((uint64_t)count * sizeof(struct mapped_tree_node) > INT32_MAX) {
+        return -1;  // offsets would not fit in 32 bits
+    }
+    records = (struct mapped_tree_node*)malloc((count ? count : 1) * sizeof(struct mapped_tree_node));
+    stack = (struct Frame*)malloc((count ? count : 1) * sizeof(struct Frame));
+    if (records == NULL || stack == NULL) {
+        free(records);
+        free(stack);
+        return -1;
+    }
+
+    memcpy(header.magic, MAPPED_MAGIC, sizeof(header.magic));
+    header.count = count;
+    header.height = 0;
+    header.reserved = 0;
+
+    if (root != NULL) {
+        stack[sp].node = root;
+        stack[sp].parent = UINT32_MAX;
+        stack[sp].depth = 1;
+        stack[sp].is_right = 0;
+        sp++;
+    }
+    while (sp > 0) {
+        struct Frame f = stack[--sp];
+        struct mapped_tree_node* rec = &records[n];
+        rec->data = f.node->data;
+        rec->left = 0;
+        rec->right = 0;
+        if (f.parent != UINT32_MAX) {
+            int32_t offset = (int32_t)((n - f.parent) * sizeof(struct mapped_tree_node));
+            if (f.is_right) {
+                records[f.parent].right = offset;
+            } else {
+                records[f.parent].left = offset;
+            }
+        }
+        if (f.depth > header.height) {
+            header.height = f.depth;
+        }
+        if (f.node->right != NULL) {
+            stack[sp].node = f.node->right;
+            stack[sp].parent = n;
+            stack[sp].depth = f.depth + 1;
+            stack[sp].is_right = 1;
+            sp++;
+        }
+        if (f.node->left != NULL) {
+            stack[sp].node = f.node->left;
+            stack[sp].parent = n;
+            stack[sp].depth = f.depth + 1;
+            stack[sp].is_right = 0;
+            sp++;
+        }
+        n++;
+    }
+    free(stack);
+
+    fp = fopen(path, "wb");
+    if (fp != NULL) {
+        if (fwrite(&header, sizeof(header), 1, fp) == 1 &&
+            fwrite(records, sizeof(struct mapped_tree_node), count, fp) == count) {
+            status = 0;
+        }
+        if (fclose(fp) != 0) {
+            status = -1;
+        }
+    }
+    free(records);
+    return status;
+}
+
+// Function to map a tree file read-only, returns 0 on success
+int mapped_tree_open(struct mapped_tree* t, const char* path) {
+    struct mapped_tree_header header;
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+
+    // Empty until the file checks out, so a failure leaves nothing to unmap
+    t->base = NULL;
+    t->size = 0;
+    t->nodes = NULL;
+    t->count = 0;
+    if (fd < 0) {
+        return -1;
+    }
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(header)) {
+        close(fd);
+        return -1;
+    }
+    t->size = (size_t)st.st_size;
+    t->base = mmap(NULL, t->size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (t->base == MAP_FAILED) {
+        t->base = NULL;
+        t->size = 0;
+        return -1;
+    }
+
+    memcpy(&header, t->base, sizeof(header));
+    if (memcmp(header.magic, MAPPED_MAGIC, sizeof(header.magic)) != 0 ||
+        (t->size - sizeof(header)) / sizeof(struct mapped_tree_node) < header.count) {
+        munmap(t->base, t->size);
+        t->base = NULL;
+        t->size = 0;
+        return -1;
+    }
+    t->nodes = (const struct mapped_tree_node*)((const char*)t->base + sizeof(header));
+    t->count = header.count;
+    t->height = header.height;
+    return 0;
+}
+
+// Function to unmap a tree file
+void mapped_tree_close(struct mapped_tree* t) {
+    if (t->base != NULL) {
+        munmap(t->base, t->size);
+    }
+    t->base = NULL;
+    t->size = 0;
+    t->nodes = NULL;
+    t->count = 0;
+}
+
+// Follow a relative link, NULL when there is no child or the link leaves the file
+static const struct mapped_tree_node* mapped_tree_child(const struct mapped_tree* t, const struct mapped_tree_node* node, int32_t offset) {
+    const char* end = (const char*)(t->nodes + t->count);
+    const char* child;
+    if (offset <= 0 || offset % (int32_t)sizeof(struct mapped_tree_node) != 0) {
+        return NULL;  // links only point forward, which also rules out cycles
+    }
+    child = (const char*)node + offset;
+    if (child >= end) {
+        return NULL;
+    }
+    return (const struct mapped_tree_node*)child;
+}
+
+// Function to search a value directly in the mapped pages, returns 1 if found
+int mapped_tree_search(const struct mapped_tree* t, int val) {
+    const struct mapped_tree_node* node = t->count > 0 ? t->nodes : NULL;
+    DS_OP_BEGIN(tree_stats);
+    while (node != NULL) {
+        DS_VISIT(tree_stats);
+        if (node->data == val) {
+            break;
+        }
+        node = mapped_tree_child(t, node, val < node->data ? node->left : node->right);
+    }
+    DS_OP_END(tree_stats);
+    return node != NULL;
+}
+
+// Function to visit every value of the mapped tree in order (LNR), returns 0 on success
+int mapped_tree_inorder(const struct mapped_tree* t, void (*visit)(int val, void* ctx), void* ctx) {
+    const struct mapped_tree_node** stack;
+    const struct mapped_tree_node* node = t->count > 0 ? t->nodes : NULL;
+    uint32_t sp = 0;
+
+    stack = (const struct mapped_tree_node**)malloc((t->height ? t->height : 1) * sizeof(*stack));
+    if (stack == NULL) {
+        return -1;
+    }
+    while (node != NULL || sp > 0) {
+        while (node != NULL) {
+            if (sp == t->height) {
+                free(stack);
+                return -1;  // deeper than the header claims: corrupt file
+            }
+            stack[sp++] = node;
+            node = mapped_tree_child(t, node, node->left);
+        }
+        node = stack[--sp];
+        visit(node->data, ctx);
+        node = mapped_tree_child(t, node, node->right);
+    }
+    free(stack);
+    return 0;
+}
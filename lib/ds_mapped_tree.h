@@ -0,0 +1,49 @@
+#ifndef DS_MAPPED_TREE_H
+#define DS_MAPPED_TREE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ds_tree.h"
+
+// Pointer-free tree file that can be searched in place after mmap()
+// Records are stored in preorder right after the header; child links are byte
+// offsets relative to the record itself (0 = no child), so they always point forward
+struct mapped_tree_header {
+    char magic[4];
+    uint32_t count;
+    uint32_t height;
+    uint32_t reserved;
+};
+
+struct mapped_tree_node {
+    int32_t data;
+    int32_t left;
+    int32_t right;
+};
+
+// A read-only view of a mapped tree file
+struct mapped_tree {
+    void* base;
+    size_t size;
+    const struct mapped_tree_node* nodes;
+    uint32_t count;
+    uint32_t height;
+};
+
+// Function to convert an in-memory tree to the mapped file format, returns 0 on success
+int mapped_tree_write(struct tree_node* root, const char* path);
+
+// Function to map a tree file read-only, returns 0 on success
+// t must not hold a mapping (mapped_tree_close() it first); on failure it is left empty
+int mapped_tree_open(struct mapped_tree* t, const char* path);
+
+// Function to unmap a tree file
+void mapped_tree_close(struct mapped_tree* t);
+
+// Function to search a value directly in the mapped pages, returns 1 if found
+int mapped_tree_search(const struct mapped_tree* t, int val);
+
+// Function to visit every value of the mapped tree in order (LNR), returns 0 on success
+int mapped_tree_inorder(const struct mapped_tree* t, void (*visit)(int val, void* ctx), void* ctx);
+
+#endif
@@ -0,0 +1,270 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "ds_ptree.h"
+#include "ds_walk.h"
+
+// Every new node starts with one reference, owned by its parent or by the version
+static struct ptree_node* new_node(int val, struct ptree_node* left, struct ptree_node* right) {
+    struct ptree_node* node = (struct ptree_node*)malloc(sizeof(struct ptree_node));
+    if (node != NULL) {
+        node->data = val;
+        node->refs = 1;
+        node->left = left;
+        node->right = right;
+    }
+    return node;
+}
+
+// Function to take one more reference on a version (O(1)), returns the version
+struct ptree_node* ptree_retain(struct ptree_node* version) {
+    if (version != NULL) {
+        __atomic_add_fetch(&version->refs, 1, __ATOMIC_RELAXED);
+    }
+    return version;
+}
+
+// Function to drop a reference, freeing the nodes no other version shares
+// Iterative so a degenerate tree does not exhaust the call stack: a node that
+// dies is chained through its left link while its left subtree is released,
+// then its right subtree is released when it is popped and freed
+void ptree_release(struct ptree_node* version) {
+    struct ptree_node* dead = NULL;
+    while (1) {
+        if (version != NULL && __atomic_sub_fetch(&version->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+            struct ptree_node* left = version->left;
+            version->left = dead;
+            dead = version;
+            version = left;
+        } else if (dead != NULL) {
+            struct ptree_node* node = dead;
+            dead = node->left;
+            version = node->right;
+            free(node);
+        } else {
+            break;
+        }
+    }
+}
+
+// Copy of node that shares the child on the side the path does not take
+// The child on the path side is left NULL, the caller links a new copy there
+static struct ptree_node* copy_step(const struct ptree_node* node, int go_left) {
+    return new_node(node->data, go_left ? NULL : ptree_retain(node->left), go_left ? ptree_retain(node->right) : NULL);
+}
+
+// Function to build a new version with val added, stored in *out
+int ptree_insert(struct ptree_node* version, int val, struct ptree_node** out) {
+    struct ptree_node* root = NULL;
+    struct ptree_node** link = &root;
+    const struct ptree_node* cur = version;
+
+    // Copy the search path, each copy hanging from the previous one
+    while (cur != NULL) {
+        int go_left = val < cur->data;
+        *link = copy_step(cur, go_left);
+        if (*link == NULL) {
+            ptree_release(root);
+            return DS_NO_MEMORY;
+        }
+        link = go_left ? &(*link)->left : &(*link)->right;
+        cur = go_left ? cur->left : cur->right;
+    }
+    *link = new_node(val, NULL, NULL);
+    if (*link == NULL) {
+        ptree_release(root);
+        return DS_NO_MEMORY;
+    }
+    *out = root;
+    return DS_OK;
+}
+
+// Function to search for a value in a version, returns 1 if found
+int ptree_search(const struct ptree_node* version, int val) {
+    while (version != NULL && version->data != val) {
+        version = val < version->data ? version->left : version->right;
+    }
+    return version != NULL;
+}
+
+// Function to build a new version without one occurrence of val, stored in *out
+// A node with two children is replaced by a copy holding its successor, and
+// the successor is cut out of a path copy of the right subtree
+int ptree_delete(struct ptree_node* version, int val, struct ptree_node** out) {
+    struct ptree_node* root = NULL;
+    struct ptree_node** link = &root;
+    const struct ptree_node* cur = version;
+
+    // Check first so a miss copies nothing
+    if (!ptree_search(version, val)) {
+        return DS_NOT_FOUND;
+    }
+    while (cur->data != val) {
+        int go_left = val < cur->data;
+        *link = copy_step(cur, go_left);
+        if (*link == NULL) {
+            ptree_release(root);
+            return DS_NO_MEMORY;
+        }
+        link = go_left ? &(*link)->left : &(*link)->right;
+        cur = go_left ? cur->left : cur->right;
+    }
+
+    if (cur->left == NULL || cur->right == NULL) {
+        *link = ptree_retain(cur->left != NULL ? cur->left : cur->right);
+    } else {
+        const struct ptree_node* succ = cur->right;
+        while (succ->left != NULL) {
+            succ = succ->left;
+        }
+        *link = new_node(succ->data, ptree_retain(cur->left), NULL);
+        if (*link == NULL) {
+            ptree_release(root);
+            return DS_NO_MEMORY;
+        }
+        link = &(*link)->right;
+        cur = cur->right;
+        while (cur->left != NULL) {
+            *link = copy_step(cur, 1);
+            if (*link == NULL) {
+                ptree_release(root);
+                return DS_NO_MEMORY;
+            }
+            link = &(*link)->left;
+            cur = cur->left;
+        }
+        *link = ptree_retain(cur->right);
+    }
+    *out = root;
+    return DS_OK;
+}
+
+// Inorder traversal function LNR
+// The nodes are shared with other versions and may be read by other threads,
+// so the path back up is kept on an explicit stack rather than threaded
+// through the nodes, and rather than recursing as deep as the tree
+int ptree_inorder(const struct ptree_node* version, void (*visit)(int val, void* ctx), void* ctx) {
+    struct ds_walk walk;
+    const struct ptree_node* node = version;
+    int status = DS_OK;
+
+    ds_walk_init(&walk);
+    while (status == DS_OK && (node != NULL || walk.count > 0)) {
+        if (node != NULL) {
+            status = ds_walk_push(&walk, node);     // Come back to it after the left subtree
+            node = node->left;
+        } else {
+            node = (const struct ptree_node*)ds_walk_pop(&walk);
+            visit(node->data, ctx);                 // Visit the root
+            node = node->right;                     // Traverse the right subtree
+        }
+    }
+    ds_walk_free(&walk);
+    return status;
+}
+
+// Function to count the nodes of a version
+// Only the right child of a node with two children waits on the stack, so a
+// path-copied chain of sorted inserts needs none
+long ptree_count_nodes(const struct ptree_node* version) {
+    struct ds_walk walk;
+    const struct ptree_node* node = version;
+    long count = 0;
+
+    ds_walk_init(&walk);
+    while (node != NULL) {
+        count++;
+        if (node->left != NULL && node->right != NULL && ds_walk_push(&walk, node->right) != DS_OK) {
+            count = DS_NO_MEMORY;
+            break;
+        }
+        node = node->left != NULL ? node->left : node->right;
+        if (node == NULL) {
+            node = (const struct ptree_node*)ds_walk_pop(&walk);
+        }
+    }
+    ds_walk_free(&walk);
+    return count;
+}
+
+// The lock only covers reading or swapping t->root together with its
+// reference count, a handful of instructions; no tree walk happens under it
+static void lock_root(struct ptree* t) {
+    while (__atomic_exchange_n(&t->lock, 1, __ATOMIC_ACQUIRE)) {
+        while (__atomic_load_n(&t->lock, __ATOMIC_RELAXED)) {
+        }
+    }
+}
+
+static void unlock_root(struct ptree* t) {
+    __atomic_store_n(&t->lock, 0, __ATOMIC_RELEASE);
+}
+
+void ptree_init(struct ptree* t) {
+    t->root = NULL;
+    t->lock = 0;
+}
+
+// Function to release the current version, the snapshots still held stay valid
+void ptree_destroy(struct ptree* t) {
+    ptree_release(t->root);
+    t->root = NULL;
+}
+
+// Function to take a reference on the current version
+struct ptree_node* ptree_snapshot(struct ptree* t) {
+    struct ptree_node* version;
+    lock_root(t);
+    version = ptree_retain(t->root);
+    unlock_root(t);
+    return version;
+}
+
+// Swap in next if the current version is still base; the tree's reference
+// on base moves to next. Returns 0 if another writer published first
+static int publish(struct ptree* t, struct ptree_node* base, struct ptree_node* next) {
+    int done;
+    lock_root(t);
+    done = t->root == base;
+    if (done) {
+        t->root = next;
+    }
+    unlock_root(t);
+    if (done) {
+        ptree_release(base);
+    }
+    return done;
+}
+
+// Function to insert a value and publish the new version
+// Writers build their version from a snapshot without blocking each other and
+// start again if another writer published in the meantime
+int ptree_add(struct ptree* t, int val) {
+    while (1) {
+        struct ptree_node* base = ptree_snapshot(t);
+        struct ptree_node* next;
+        int status = ptree_insert(base, val, &next);
+        if (status == DS_OK && !publish(t, base, next)) {
+            ptree_release(next);
+            ptree_release(base);
+            continue;
+        }
+        ptree_release(base);
+        return status;
+    }
+}
+
+// Function to delete a value and publish the new version
+int ptree_remove(struct ptree* t, int val) {
+    while (1) {
+        struct ptree_node* base = ptree_snapshot(t);
+        struct ptree_node* next;
+        int status = ptree_delete(base, val, &next);
+        if (status == DS_OK && !publish(t, base, next)) {
+            ptree_release(next);
+            ptree_release(base);
+            continue;
+        }
+        ptree_release(base);
+        return status;
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef DS_PTREE_H
+#define DS_PTREE_H
+
+#include <stdint.h>
+#include "ds_status.h"
+
+// Persistent binary search tree: nodes are never modified once built, so
+// insert and delete copy the path from the root to the change and share every
+// other subtree with the previous version. A version is a root pointer that
+// holds one reference; it stays valid and unchanged until it is released,
+// whatever happens to newer versions. Duplicates go right, as in tree_insert().
+// Reference counts are atomic, so versions can be read and released from any
+// thread. There are no DS_INSTRUMENT counters here, as for cskiplist.
+
+struct ptree_node {
+    int data;
+    uint32_t refs;
+    struct ptree_node* left;
+    struct ptree_node* right;
+};
+
+// Function to take one more reference on a version (O(1)), returns the version
+struct ptree_node* ptree_retain(struct ptree_node* version);
+
+// Function to drop a reference, freeing the nodes no other version shares
+void ptree_release(struct ptree_node* version);
+
+// Function to build a new version with val added, stored in *out; returns DS_OK or DS_NO_MEMORY
+// The old version is left as it was and still has to be released by its owner
+int ptree_insert(struct ptree_node* version, int val, struct ptree_node** out);
+
+// Function to build a new version without one occurrence of val, stored in *out
+// Returns DS_OK, DS_NOT_FOUND (*out untouched) or DS_NO_MEMORY
+int ptree_delete(struct ptree_node* version, int val, struct ptree_node** out);
+
+// Function to search for a value in a version, returns 1 if found
+int ptree_search(const struct ptree_node* version, int val);
+
+// Inorder traversal function LNR, calls visit() on every value; returns DS_OK,
+// or DS_NO_MEMORY if the walk stack of a deep version cannot grow, after
+// visiting the smallest values in order
+int ptree_inorder(const struct ptree_node* version, void (*visit)(int val, void* ctx), void* ctx);
+
+// Function to count the nodes of a version, returns the count or DS_NO_MEMORY
+long ptree_count_nodes(const struct ptree_node* version);
+
+// The current version of a tree shared between threads. Writers publish new
+// versions, readers take a snapshot in O(1) and then search or traverse it
+// without any lock while writers carry on.
+struct ptree {
+    struct ptree_node* root;
+    int lock;
+};
+
+void ptree_init(struct ptree* t);
+
+// Function to release the current version, the snapshots still held stay valid
+void ptree_destroy(struct ptree* t);
+
+// Function to take a reference on the current version, to be given back with ptree_release()
+struct ptree_node* ptree_snapshot(struct ptree* t);
+
+// Function to insert a value and publish the new version, returns DS_OK or DS_NO_MEMORY
+int ptree_add(struct ptree* t, int val);
+
+// Function to delete a value and publish the new version, returns DS_OK, DS_NOT_FOUND or DS_NO_MEMORY
+int ptree_remove(struct ptree* t, int val);
+
+#endif
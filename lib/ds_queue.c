@@ -0,0 +1,317 @@
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "ds_queue.h"
+
+DS_STATS_DEFINE(queue_stats, "queue");
+DS_STATS_DEFINE(small_queue_stats, "small_queue");
+DS_STATS_DEFINE(window_queue_stats, "window_queue");
+
+// Free a detached chain of nodes
+static void release_nodes(struct queue_node* n) {
+    while (n != NULL) {
+        struct queue_node* next = n->next;
+        free(n);
+        DS_FREE(queue_stats);
+        n = next;
+    }
+}
+
+// Function to free the queue: one pass over the nodes, no per-node dequeue
+void queue_free(struct queue* q) {
+    release_nodes(q->front);
+    q->front = NULL;
+    q->rear = NULL;
+}
+
+// Double the capacity of a small queue: the elements are copied in order to
+// the start of a new heap ring, unwrapping them, and the old ring is dropped
+int small_queue_grow(struct small_queue* q) {
+    int* old = small_queue_items(q);
+    int* items;
+    int first;
+    if (q->capacity > INT_MAX / 2) {
+        return DS_NO_MEMORY;
+    }
+    items = (int*)malloc(2 * (size_t)q->capacity * sizeof(int));
+    if (items == NULL) {
+        return DS_NO_MEMORY;
+    }
+    DS_ALLOC(small_queue_stats);
+    first = q->capacity - q->head < q->count ? q->capacity - q->head : q->count;
+    memcpy(items, old + q->head, (size_t)first * sizeof(int));
+    memcpy(items + first, old, (size_t)(q->count - first) * sizeof(int));
+    if (q->capacity != SMALL_QUEUE_INLINE) {
+        free(old);
+        DS_FREE(small_queue_stats);
+    }
+    q->buf.heap = items;
+    q->capacity *= 2;
+    q->head = 0;
+    return DS_OK;
+}
+
+// Empty the small queue, freeing the heap ring if it spilled
+void small_queue_free(struct small_queue* q) {
+    if (q->capacity != SMALL_QUEUE_INLINE) {
+        free(q->buf.heap);
+        DS_FREE(small_queue_stats);
+    }
+    small_queue_init(q);
+}
+
+#define WINDOW_QUEUE_INITIAL 16
+
+// Allocate the rings of a window queue for capacity slots, returns DS_OK or DS_NO_MEMORY
+static int window_alloc(struct window_queue* w, long capacity, int** values, long** stamps, long** min_pos, long** max_pos) {
+    *values = (int*)malloc((size_t)capacity * sizeof(int));
+    *stamps = w->span > 0 ? (long*)malloc((size_t)capacity * sizeof(long)) : NULL;
+    *min_pos = (long*)malloc((size_t)capacity * sizeof(long));
+    *max_pos = (long*)malloc((size_t)capacity * sizeof(long));
+    if (*values == NULL || (w->span > 0 && *stamps == NULL) || *min_pos == NULL || *max_pos == NULL) {
+        free(*values);
+        free(*stamps);
+        free(*min_pos);
+        free(*max_pos);
+        // The caller's window may be freed later, so leave nothing dangling
+        *values = NULL;
+        *stamps = NULL;
+        *min_pos = NULL;
+        *max_pos = NULL;
+        return DS_NO_MEMORY;
+    }
+    DS_ALLOC(window_queue_stats);
+    return DS_OK;
+}
+
+int window_queue_init(struct window_queue* w, long limit, long span) {
+    w->limit = limit > 0 ? limit : 0;
+    w->span = span > 0 ? span : 0;
+    w->first = 0;
+    w->next = 0;
+    w->capacity = WINDOW_QUEUE_INITIAL;
+    w->min_head = w->min_tail = 0;
+    w->max_head = w->max_tail = 0;
+    return window_alloc(w, w->capacity, &w->values, &w->stamps, &w->min_pos, &w->max_pos);
+}
+
+void window_queue_free(struct window_queue* w) {
+    if (w->values != NULL) {
+        DS_FREE(window_queue_stats);
+    }
+    free(w->values);
+    free(w->stamps);
+    free(w->min_pos);
+    free(w->max_pos);
+    w->values = NULL;
+    w->stamps = NULL;
+    w->min_pos = NULL;
+    w->max_pos = NULL;
+    w->first = w->next = 0;
+    w->min_head = w->min_tail = w->max_head = w->max_tail = 0;
+}
+
+// Double the rings. Every ring is indexed by a counter masked with the
+// capacity, so each live entry moves to its counter masked with the new one
+static int window_grow(struct window_queue* w) {
+    long old_mask = w->capacity - 1, mask = 2 * w->capacity - 1, i;
+    int* values;
+    long *stamps, *min_pos, *max_pos;
+    if (w->capacity > LONG_MAX / 2 / (long)sizeof(long) ||
+        window_alloc(w, 2 * w->capacity, &values, &stamps, &min_pos, &max_pos) != DS_OK) {
+        return DS_NO_MEMORY;
+    }
+    for (i = w->first; i < w->next; i++) {
+        values[i & mask] = w->values[i & old_mask];
+        if (stamps != NULL) {
+            stamps[i & mask] = w->stamps[i & old_mask];
+        }
+    }
+    for (i = w->min_head; i < w->min_tail; i++) {
+        min_pos[i & mask] = w->min_pos[i & old_mask];
+    }
+    for (i = w->max_head; i < w->max_tail; i++) {
+        max_pos[i & mask] = w->max_pos[i & old_mask];
+    }
+    free(w->values);
+    free(w->stamps);
+    free(w->min_pos);
+    free(w->max_pos);
+    DS_FREE(window_queue_stats);
+    w->values = values;
+    w->stamps = stamps;
+    w->min_pos = min_pos;
+    w->max_pos = max_pos;
+    w->capacity *= 2;
+    return DS_OK;
+}
+
+// Drop the oldest value, and its position from the front of a deque that holds it
+static void window_evict(struct window_queue* w) {
+    long mask = w->capacity - 1;
+    DS_VISIT(window_queue_stats);
+    if (w->min_head != w->min_tail && w->min_pos[w->min_head & mask] == w->first) {
+        w->min_head++;
+    }
+    if (w->max_head != w->max_tail && w->max_pos[w->max_head & mask] == w->first) {
+        w->max_head++;
+    }
+    w->first++;
+}
+
+// Enqueue operation: a new value makes every older value that is not
+// smaller (not larger) useless as a minimum (maximum) for as long as the new
+// one stays, so those positions leave the back of the deque for good. Each
+// position enters and leaves a deque once, hence amortized O(1)
+int window_queue_insertion(struct window_queue* w, int x, long stamp) {
+    long mask, pos;
+    DS_OP_BEGIN(window_queue_stats);
+    if (w->limit > 0 && window_queue_count(w) >= w->limit) {
+        window_evict(w);
+    }
+    if (w->span > 0) {
+        while (w->first < w->next && w->stamps[w->first & (w->capacity - 1)] <= stamp - w->span) {
+            window_evict(w);
+        }
+    }
+    if (window_queue_count(w) == w->capacity && window_grow(w) != DS_OK) {
+        DS_OP_END(window_queue_stats);
+        return DS_NO_MEMORY;
+    }
+    mask = w->capacity - 1;
+    pos = w->next++;
+    w->values[pos & mask] = x;
+    if (w->stamps != NULL) {
+        w->stamps[pos & mask] = stamp;
+    }
+    while (w->min_tail != w->min_head && w->values[w->min_pos[(w->min_tail - 1) & mask] & mask] >= x) {
+        DS_VISIT(window_queue_stats);
+        w->min_tail--;
+    }
+    w->min_pos[w->min_tail++ & mask] = pos;
+    while (w->max_tail != w->max_head && w->values[w->max_pos[(w->max_tail - 1) & mask] & mask] <= x) {
+        DS_VISIT(window_queue_stats);
+        w->max_tail--;
+    }
+    w->max_pos[w->max_tail++ & mask] = pos;
+    DS_OP_END(window_queue_stats);
+    return DS_OK;
+}
+
+int window_queue_supression(struct window_queue* w, int* x) {
+    DS_OP_BEGIN(window_queue_stats);
+    if (w->first == w->next) {
+        DS_OP_END(window_queue_stats);
+        return DS_EMPTY;
+    }
+    if (x != NULL) {
+        *x = w->values[w->first & (w->capacity - 1)];
+    }
+    window_evict(w);
+    DS_OP_END(window_queue_stats);
+    return DS_OK;
+}
+
+long window_queue_expire(struct window_queue* w, long now) {
+    long evicted = 0;
+    DS_OP_BEGIN(window_queue_stats);
+    if (w->span > 0) {
+        while (w->first < w->next && w->stamps[w->first & (w->capacity - 1)] <= now - w->span) {
+            window_evict(w);
+            evicted++;
+        }
+    }
+    DS_OP_END(window_queue_stats);
+    return evicted;
+}
+
+// Snapshot file layout: magic, element count, then the values from front to rear
+static const char QUEUE_MAGIC[4] = {'Q', 'U', 'E', '1'};
+
+// Write the queue to a binary snapshot file, returns 0 on success
+int queue_save(const struct queue* q, const char* path) {
+    uint32_t count = 0, i = 0;
+    struct queue_node* n;
+    int32_t* values;
+    FILE* fp;
+    int status = -1;
+
+    for (n = q->front; n != NULL; n = n->next) {
+        count++;
+    }
+    values = (int32_t*)malloc((count ? count : 1) * sizeof(int32_t));
+    if (values == NULL) {
+        return -1;
+    }
+    for (n = q->front; n != NULL; n = n->next) {
+        values[i++] = n->data;
+    }
+
+    fp = fopen(path, "wb");
+    if (fp != NULL) {
+        if (fwrite(QUEUE_MAGIC, sizeof(QUEUE_MAGIC), 1, fp) == 1 &&
+            fwrite(&count, sizeof(count), 1, fp) == 1 &&
+            fwrite(values, sizeof(int32_t), count, fp) == count) {
+            status = 0;
+        }
+        if (fclose(fp) != 0) {
+            status = -1;
+        }
+    }
+    free(values);
+    return status;
+}
+
+// Replace the queue with the content of a snapshot file, returns 0 on success
+int queue_load(struct queue* q, const char* path) {
+    char magic[4];
+    uint32_t count, i;
+    int32_t* values;
+    struct queue_node *head = NULL, *tail = NULL;
+    FILE* fp = fopen(path, "rb");
+
+    if (fp == NULL) {
+        return -1;
+    }
+    if (fread(magic, sizeof(magic), 1, fp) != 1 || memcmp(magic, QUEUE_MAGIC, sizeof(magic)) != 0 ||
+        fread(&count, sizeof(count), 1, fp) != 1) {
+        fclose(fp);
+        return -1;
+    }
+
+    // One sequential read of the whole value array
+    values = (int32_t*)malloc((count ? count : 1) * sizeof(int32_t));
+    if (values == NULL || fread(values, sizeof(int32_t), count, fp) != count) {
+        free(values);
+        fclose(fp);
+        return -1;
+    }
+    fclose(fp);
+
+    // Link the nodes through a tail pointer; they stay individually freeable for queue_supression()
+    for (i = 0; i < count; i++) {
+        struct queue_node* new_node = (struct queue_node*)malloc(sizeof(struct queue_node));
+        if (new_node == NULL) {
+            release_nodes(head);
+            free(values);
+            return -1;
+        }
+        DS_ALLOC(queue_stats);
+        new_node->data = values[i];
+        new_node->next = NULL;
+        if (tail == NULL) {
+            head = new_node;
+        } else {
+            tail->next = new_node;
+        }
+        tail = new_node;
+    }
+    free(values);
+
+    release_nodes(q->front);
+    q->front = head;
+    q->rear = tail;
+    return 0;
+}
@@ -0,0 +1,246 @@
+#ifndef DS_QUEUE_H
+#define DS_QUEUE_H
+
+#include <stdlib.h>
+#include "ds_stats.h"
+#include "ds_status.h"
+
+// Node structure
+struct queue_node {
+    int data;
+    struct queue_node* next;
+};
+
+// Queue structure
+struct queue {
+    struct queue_node* front;
+    struct queue_node* rear;
+};
+
+// Counters, only compiled in with -DDS_INSTRUMENT
+DS_STATS_DECLARE(queue_stats);
+
+// Initialize the queue
+static inline void queue_init(struct queue* q) {
+    q->front = NULL;
+    q->rear = NULL;
+}
+
+// Enqueue, dequeue and peek live in the header so callers can inline them;
+// they never print, the caller reports the returned status
+
+// Enqueue operation, returns DS_OK or DS_NO_MEMORY
+static inline int queue_insertion(struct queue* q, int x) {
+    DS_OP_BEGIN(queue_stats);
+    struct queue_node* new_node = (struct queue_node*)malloc(sizeof(struct queue_node));
+    if (new_node == NULL) {
+        DS_OP_END(queue_stats);
+        return DS_NO_MEMORY;
+    }
+    DS_ALLOC(queue_stats);
+    new_node->data = x;
+    new_node->next = NULL;
+
+    if (q->rear == NULL) {
+        q->front = new_node;
+        q->rear = new_node;
+    } else {
+        q->rear->next = new_node;
+        q->rear = new_node;
+    }
+    DS_OP_END(queue_stats);
+    return DS_OK;
+}
+
+// Dequeue operation, stores the removed value in *x (may be NULL), returns DS_OK or DS_EMPTY
+static inline int queue_supression(struct queue* q, int* x) {
+    DS_OP_BEGIN(queue_stats);
+    if (q->front == NULL) {
+        DS_OP_END(queue_stats);
+        return DS_EMPTY;
+    }
+
+    struct queue_node* temp = q->front;
+    DS_VISIT(queue_stats);
+    if (x != NULL) {
+        *x = temp->data;
+    }
+    q->front = q->front->next;
+
+    if (q->front == NULL) {
+        q->rear = NULL; // Queue is empty
+    }
+    free(temp);
+    DS_FREE(queue_stats);
+    DS_OP_END(queue_stats);
+    return DS_OK;
+}
+
+// Peek operation, stores the front value in *x, returns DS_OK or DS_EMPTY
+static inline int queue_peek(const struct queue* q, int* x) {
+    if (q->front == NULL) {
+        return DS_EMPTY;
+    }
+    *x = q->front->data;
+    return DS_OK;
+}
+
+// IsEmpty operation
+static inline int queue_is_empty(const struct queue* q) {
+    return q->front == NULL;
+}
+
+// Function to free the queue
+void queue_free(struct queue* q);
+
+// Small queue: a ring buffer whose first SMALL_QUEUE_INLINE slots live in the
+// handle itself, so a short-lived queue that stays that small never calls
+// malloc. When it fills up the elements move, in order, to a heap ring twice
+// as large. Capacities are powers of two so the ring wraps with a mask.
+#define SMALL_QUEUE_INLINE 16
+
+struct small_queue {
+    int head;       // slot of the front element
+    int count;
+    int capacity;   // SMALL_QUEUE_INLINE while the slots are inline
+    union {
+        int items[SMALL_QUEUE_INLINE];
+        int* heap;
+    } buf;
+};
+
+// Counters, only compiled in with -DDS_INSTRUMENT; allocations count heap spills
+DS_STATS_DECLARE(small_queue_stats);
+
+// Initialize the small queue, no allocation
+static inline void small_queue_init(struct small_queue* q) {
+    q->head = 0;
+    q->count = 0;
+    q->capacity = SMALL_QUEUE_INLINE;
+}
+
+// Slot array, inline or on the heap
+static inline int* small_queue_items(struct small_queue* q) {
+    return q->capacity == SMALL_QUEUE_INLINE ? q->buf.items : q->buf.heap;
+}
+
+// Double the capacity, moving the elements to the heap, returns DS_OK or DS_NO_MEMORY
+int small_queue_grow(struct small_queue* q);
+
+// Enqueue operation, returns DS_OK or DS_NO_MEMORY
+static inline int small_queue_insertion(struct small_queue* q, int x) {
+    DS_OP_BEGIN(small_queue_stats);
+    if (q->count == q->capacity && small_queue_grow(q) != DS_OK) {
+        DS_OP_END(small_queue_stats);
+        return DS_NO_MEMORY;
+    }
+    small_queue_items(q)[(q->head + q->count) & (q->capacity - 1)] = x;
+    q->count++;
+    DS_OP_END(small_queue_stats);
+    return DS_OK;
+}
+
+// Dequeue operation, stores the removed value in *x (may be NULL), returns DS_OK or DS_EMPTY
+static inline int small_queue_supression(struct small_queue* q, int* x) {
+    DS_OP_BEGIN(small_queue_stats);
+    if (q->count == 0) {
+        DS_OP_END(small_queue_stats);
+        return DS_EMPTY;
+    }
+    DS_VISIT(small_queue_stats);
+    if (x != NULL) {
+        *x = small_queue_items(q)[q->head];
+    }
+    q->head = (q->head + 1) & (q->capacity - 1);
+    q->count--;
+    DS_OP_END(small_queue_stats);
+    return DS_OK;
+}
+
+// Peek operation, stores the front value in *x, returns DS_OK or DS_EMPTY
+static inline int small_queue_peek(struct small_queue* q, int* x) {
+    if (q->count == 0) {
+        return DS_EMPTY;
+    }
+    *x = small_queue_items(q)[q->head];
+    return DS_OK;
+}
+
+// IsEmpty operation
+static inline int small_queue_is_empty(const struct small_queue* q) {
+    return q->count == 0;
+}
+
+// Empty the small queue, freeing the heap ring if it spilled
+void small_queue_free(struct small_queue* q);
+
+// Window queue: keeps the last values pushed and their minimum and maximum
+// The window is bounded by count (at most limit values) and/or by time (only
+// values stamped within span of the newest stamp); older values leave it as
+// new ones arrive. Two monotonic deques of positions track the candidates for
+// minimum and maximum, so insertion, supression, min and max are amortized
+// O(1) instead of a rescan of the window per value.
+struct window_queue {
+    long limit;         // most values kept, 0 for no count bound
+    long span;          // a value leaves once the newest stamp is span past its own, 0 for no time bound
+    long first;         // position of the oldest value; positions count every value ever pushed
+    long next;          // position the next value gets
+    long capacity;      // slots of every ring, a power of two
+    int* values;        // ring of the values, indexed by position
+    long* stamps;       // ring of their stamps, NULL for a count window
+    long* min_pos;      // positions with increasing values, front is the minimum
+    long min_head, min_tail;
+    long* max_pos;      // positions with decreasing values, front is the maximum
+    long max_head, max_tail;
+};
+
+// Counters, only compiled in with -DDS_INSTRUMENT; visits count values evicted or dropped from the deques
+DS_STATS_DECLARE(window_queue_stats);
+
+// Create an empty window of at most limit values and/or span time units (0 for no bound), returns DS_OK or DS_NO_MEMORY
+int window_queue_init(struct window_queue* w, long limit, long span);
+
+// Free the rings
+void window_queue_free(struct window_queue* w);
+
+// Enqueue operation: pushes x stamped with stamp (non-decreasing, ignored
+// without a time bound) and evicts the values that fall out of the window,
+// returns DS_OK or DS_NO_MEMORY
+int window_queue_insertion(struct window_queue* w, int x, long stamp);
+
+// Dequeue operation, removes the oldest value into *x (may be NULL), returns DS_OK or DS_EMPTY
+int window_queue_supression(struct window_queue* w, int* x);
+
+// Evict the values that are span older than now without pushing, returns how many left
+long window_queue_expire(struct window_queue* w, long now);
+
+// Number of values in the window
+static inline long window_queue_count(const struct window_queue* w) {
+    return w->next - w->first;
+}
+
+// Smallest value in the window into *x, returns DS_OK or DS_EMPTY
+static inline int window_queue_min(const struct window_queue* w, int* x) {
+    if (w->min_head == w->min_tail) {
+        return DS_EMPTY;
+    }
+    *x = w->values[w->min_pos[w->min_head & (w->capacity - 1)] & (w->capacity - 1)];
+    return DS_OK;
+}
+
+// Largest value in the window into *x, returns DS_OK or DS_EMPTY
+static inline int window_queue_max(const struct window_queue* w, int* x) {
+    if (w->max_head == w->max_tail) {
+        return DS_EMPTY;
+    }
+    *x = w->values[w->max_pos[w->max_head & (w->capacity - 1)] & (w->capacity - 1)];
+    return DS_OK;
+}
+
+// Write the queue to a binary snapshot file, returns 0 on success
+int queue_save(const struct queue* q, const char* path);
+
+// Replace the queue with the content of a snapshot file, returns 0 on success
+int queue_load(struct queue* q, const char* path);
+
+#endif
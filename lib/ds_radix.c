@@ -0,0 +1,547 @@
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ds_radix.h"
+
+DS_STATS_DEFINE(radix_stats, "radix");
+
+// Levels 0 to 2 are inner nodes, the byte of level 3 is a bit in a leaf
+#define RADIX_LEAF_LEVEL 3
+
+// Flipping the sign bit makes unsigned byte order match the int order
+static uint32_t to_key(int val) {
+    return (uint32_t)val ^ 0x80000000u;
+}
+
+static int from_key(uint32_t key) {
+    return (int)(key ^ 0x80000000u);
+}
+
+static uint8_t key_byte(uint32_t key, int level) {
+    return (uint8_t)(key >> (24 - 8 * level));
+}
+
+static int leaf_has(const struct radix_leaf* leaf, uint8_t b) {
+    return (int)((leaf->bits[b >> 6] >> (b & 63)) & 1);
+}
+
+// Function to find the first bit >= b in a leaf, returns -1 if there is none
+static int leaf_next(const struct radix_leaf* leaf, int b) {
+    int word = b >> 6;
+    uint64_t bits = leaf->bits[word] & (~0ULL << (b & 63));
+    for (;;) {
+        if (bits != 0) {
+            return word * 64 + __builtin_ctzll(bits);
+        }
+        if (++word == 4) {
+            return -1;
+        }
+        bits = leaf->bits[word];
+    }
+}
+
+static struct radix_node* new_node(uint8_t type) {
+    static const size_t sizes[] = {sizeof(struct radix_node4), sizeof(struct radix_node16),
+                                   sizeof(struct radix_node48), sizeof(struct radix_node256)};
+    struct radix_node* node = (struct radix_node*)calloc(1, sizes[type]);
+    if (node != NULL) {
+        DS_ALLOC(radix_stats);
+        node->type = type;
+    }
+    return node;
+}
+
+static void free_node(void* node) {
+    DS_FREE(radix_stats);
+    free(node);
+}
+
+// Function to find the child slot for byte b, NULL if there is no child
+static void** find_child(void* node_, uint8_t b) {
+    struct radix_node* node = (struct radix_node*)node_;
+    int i;
+    switch (node->type) {
+    case RADIX_NODE4: {
+        struct radix_node4* n = (struct radix_node4*)node;
+        for (i = 0; i < node->count; i++) {
+            if (n->keys[i] == b) {
+                return &n->child[i];
+            }
+        }
+        return NULL;
+    }
+    case RADIX_NODE16: {
+        struct radix_node16* n = (struct radix_node16*)node;
+        for (i = 0; i < node->count; i++) {
+            if (n->keys[i] == b) {
+                return &n->child[i];
+            }
+        }
+        return NULL;
+    }
+    case RADIX_NODE48: {
+        struct radix_node48* n = (struct radix_node48*)node;
+        return n->index[b] != 0 ? &n->child[n->index[b] - 1] : NULL;
+    }
+    default: {
+        struct radix_node256* n = (struct radix_node256*)node;
+        return n->child[b] != NULL ? &n->child[b] : NULL;
+    }
+    }
+}
+
+// Function to find the child with the smallest byte >= b, stored in *found
+static void* next_child(const struct radix_node* node, int b, uint8_t* found) {
+    int i;
+    switch (node->type) {
+    case RADIX_NODE4: {
+        const struct radix_node4* n = (const struct radix_node4*)node;
+        for (i = 0; i < node->count; i++) {
+            if (n->keys[i] >= b) {
+                *found = n->keys[i];
+                return n->child[i];
+            }
+        }
+        return NULL;
+    }
+    case RADIX_NODE16: {
+        const struct radix_node16* n = (const struct radix_node16*)node;
+        for (i = 0; i < node->count; i++) {
+            if (n->keys[i] >= b) {
+                *found = n->keys[i];
+                return n->child[i];
+            }
+        }
+        return NULL;
+    }
+    case RADIX_NODE48: {
+        const struct radix_node48* n = (const struct radix_node48*)node;
+        for (i = b; i < 256; i++) {
+            if (n->index[i] != 0) {
+                *found = (uint8_t)i;
+                return n->child[n->index[i] - 1];
+            }
+        }
+        return NULL;
+    }
+    default: {
+        const struct radix_node256* n = (const struct radix_node256*)node;
+        for (i = b; i < 256; i++) {
+            if (n->child[i] != NULL) {
+                *found = (uint8_t)i;
+                return n->child[i];
+            }
+        }
+        return NULL;
+    }
+    }
+}
+
+// Function to add a child to a sorted node4 / node16
+static void add_sorted(uint8_t* keys, void** child, int count, uint8_t b, void* node) {
+    int i = count;
+    while (i > 0 && keys[i - 1] > b) {
+        keys[i] = keys[i - 1];
+        child[i] = child[i - 1];
+        i--;
+    }
+    keys[i] = b;
+    child[i] = node;
+}
+
+// Function to move the children of a full node into the next bigger type
+static struct radix_node* grow(struct radix_node* node) {
+    struct radix_node* bigger = new_node((uint8_t)(node->type + 1));
+    int i;
+    if (bigger == NULL) {
+        return NULL;
+    }
+    bigger->count = node->count;
+    switch (node->type) {
+    case RADIX_NODE4: {
+        struct radix_node4* n = (struct radix_node4*)node;
+        struct radix_node16* b = (struct radix_node16*)bigger;
+        memcpy(b->keys, n->keys, sizeof(n->keys));
+        memcpy(b->child, n->child, sizeof(n->child));
+        break;
+    }
+    case RADIX_NODE16: {
+        struct radix_node16* n = (struct radix_node16*)node;
+        struct radix_node48* b = (struct radix_node48*)bigger;
+        for (i = 0; i < 16; i++) {
+            b->index[n->keys[i]] = (uint8_t)(i + 1);
+            b->child[i] = n->child[i];
+        }
+        break;
+    }
+    default: {
+        struct radix_node48* n = (struct radix_node48*)node;
+        struct radix_node256* b = (struct radix_node256*)bigger;
+        for (i = 0; i < 256; i++) {
+            if (n->index[i] != 0) {
+                b->child[i] = n->child[n->index[i] - 1];
+            }
+        }
+        break;
+    }
+    }
+    free_node(node);
+    return bigger;
+}
+
+// Function to add a child for byte b, growing the node when it is full
+static int add_child(void** ref, uint8_t b, void* child) {
+    static const int capacity[] = {4, 16, 48, 256};
+    struct radix_node* node = (struct radix_node*)*ref;
+    int i;
+    if (node->count == capacity[node->type]) {
+        node = grow(node);
+        if (node == NULL) {
+            return DS_NO_MEMORY;
+        }
+        *ref = node;
+    }
+    switch (node->type) {
+    case RADIX_NODE4: {
+        struct radix_node4* n = (struct radix_node4*)node;
+        add_sorted(n->keys, n->child, node->count, b, child);
+        break;
+    }
+    case RADIX_NODE16: {
+        struct radix_node16* n = (struct radix_node16*)node;
+        add_sorted(n->keys, n->child, node->count, b, child);
+        break;
+    }
+    case RADIX_NODE48: {
+        struct radix_node48* n = (struct radix_node48*)node;
+        for (i = 0; n->child[i] != NULL; i++) {
+        }
+        n->child[i] = child;
+        n->index[b] = (uint8_t)(i + 1);
+        break;
+    }
+    default:
+        ((struct radix_node256*)node)->child[b] = child;
+        break;
+    }
+    node->count++;
+    return DS_OK;
+}
+
+// Function to move the children of a node into the next smaller type
+// Shrinking leaves some slack below the capacity so that a key inserted and
+// deleted at the boundary does not copy the node every time
+static void shrink(void** ref) {
+    struct radix_node* node = (struct radix_node*)*ref;
+    struct radix_node* smaller = new_node((uint8_t)(node->type - 1));
+    int i, j = 0;
+    if (smaller == NULL) {
+        return;  // the bigger node still works
+    }
+    smaller->count = node->count;
+    switch (node->type) {
+    case RADIX_NODE16: {
+        struct radix_node16* n = (struct radix_node16*)node;
+        struct radix_node4* s = (struct radix_node4*)smaller;
+        memcpy(s->keys, n->keys, node->count);
+        memcpy(s->child, n->child, node->count * sizeof(void*));
+        break;
+    }
+    case RADIX_NODE48: {
+        struct radix_node48* n = (struct radix_node48*)node;
+        struct radix_node16* s = (struct radix_node16*)smaller;
+        for (i = 0; i < 256; i++) {
+            if (n->index[i] != 0) {
+                s->keys[j] = (uint8_t)i;
+                s->child[j++] = n->child[n->index[i] - 1];
+            }
+        }
+        break;
+    }
+    default: {
+        struct radix_node256* n = (struct radix_node256*)node;
+        struct radix_node48* s = (struct radix_node48*)smaller;
+        for (i = 0; i < 256; i++) {
+            if (n->child[i] != NULL) {
+                s->index[i] = (uint8_t)(j + 1);
+                s->child[j++] = n->child[i];
+            }
+        }
+        break;
+    }
+    }
+    free_node(node);
+    *ref = smaller;
+}
+
+// Function to remove the child for byte b, freeing the node when it empties
+static void remove_child(void** ref, uint8_t b) {
+    static const int shrink_below[] = {0, 3, 12, 37};
+    struct radix_node* node = (struct radix_node*)*ref;
+    int i;
+    switch (node->type) {
+    case RADIX_NODE4:
+    case RADIX_NODE16: {
+        uint8_t* keys;
+        void** child;
+        if (node->type == RADIX_NODE4) {
+            keys = ((struct radix_node4*)node)->keys;
+            child = ((struct radix_node4*)node)->child;
+        } else {
+            keys = ((struct radix_node16*)node)->keys;
+            child = ((struct radix_node16*)node)->child;
+        }
+        for (i = 0; keys[i] != b; i++) {
+        }
+        for (; i + 1 < node->count; i++) {
+            keys[i] = keys[i + 1];
+            child[i] = child[i + 1];
+        }
+        break;
+    }
+    case RADIX_NODE48: {
+        struct radix_node48* n = (struct radix_node48*)node;
+        n->child[n->index[b] - 1] = NULL;
+        n->index[b] = 0;
+        break;
+    }
+    default:
+        ((struct radix_node256*)node)->child[b] = NULL;
+        break;
+    }
+    node->count--;
+    if (node->count == 0) {
+        free_node(node);
+        *ref = NULL;
+    } else if (node->count <= shrink_below[node->type]) {
+        shrink(ref);
+    }
+}
+
+// Function to free a subtree rooted at the given level
+static void free_path(void* node, int level) {
+    uint8_t b;
+    int next = 0;
+    void* child;
+    if (level < RADIX_LEAF_LEVEL) {
+        while (next < 256 && (child = next_child((struct radix_node*)node, next, &b)) != NULL) {
+            free_path(child, level + 1);
+            next = b + 1;
+        }
+    }
+    free_node(node);
+}
+
+// Function to build the missing path below level for a key: one node4 per
+// level and the leaf, returns NULL if an allocation fails
+static void* new_path(uint32_t key, int level) {
+    struct radix_leaf* leaf;
+    void* below;
+    struct radix_node4* node;
+    if (level == RADIX_LEAF_LEVEL) {
+        leaf = (struct radix_leaf*)calloc(1, sizeof(struct radix_leaf));
+        if (leaf != NULL) {
+            DS_ALLOC(radix_stats);
+            leaf->bits[key_byte(key, level) >> 6] = 1ULL << (key_byte(key, level) & 63);
+            leaf->count = 1;
+        }
+        return leaf;
+    }
+    below = new_path(key, level + 1);
+    if (below == NULL) {
+        return NULL;
+    }
+    node = (struct radix_node4*)new_node(RADIX_NODE4);
+    if (node == NULL) {
+        free_path(below, level + 1);
+        return NULL;
+    }
+    node->keys[0] = key_byte(key, level);
+    node->child[0] = below;
+    node->n.count = 1;
+    return node;
+}
+
+void radix_free(struct radix_tree* t) {
+    if (t->root != NULL) {
+        free_path(t->root, 0);
+    }
+    radix_init(t);
+}
+
+// Function to insert a key: walk down while the path exists, then build the
+// rest of it in one go so a failed allocation leaves the tree unchanged
+int radix_insert(struct radix_tree* t, int val) {
+    uint32_t key = to_key(val);
+    void** ref = &t->root;
+    void* path;
+    int level;
+    DS_OP_BEGIN(radix_stats);
+    for (level = 0; level < RADIX_LEAF_LEVEL && *ref != NULL; level++) {
+        void** child = find_child(*ref, key_byte(key, level));
+        DS_VISIT(radix_stats);
+        if (child == NULL) {
+            break;
+        }
+        ref = child;
+    }
+
+    if (level == RADIX_LEAF_LEVEL) {
+        struct radix_leaf* leaf = (struct radix_leaf*)*ref;
+        uint8_t b = key_byte(key, level);
+        DS_VISIT(radix_stats);
+        if (leaf_has(leaf, b)) {
+            DS_OP_END(radix_stats);
+            return DS_EXISTS;
+        }
+        leaf->bits[b >> 6] |= 1ULL << (b & 63);
+        leaf->count++;
+    } else if (*ref == NULL) {
+        path = new_path(key, 0);
+        if (path == NULL) {
+            DS_OP_END(radix_stats);
+            return DS_NO_MEMORY;
+        }
+        *ref = path;
+    } else {
+        path = new_path(key, level + 1);
+        if (path == NULL || add_child(ref, key_byte(key, level), path) != DS_OK) {
+            if (path != NULL) {
+                free_path(path, level + 1);
+            }
+            DS_OP_END(radix_stats);
+            return DS_NO_MEMORY;
+        }
+    }
+    t->count++;
+    DS_OP_END(radix_stats);
+    return DS_OK;
+}
+
+// Function to search for a key, returns 1 if found
+int radix_search(const struct radix_tree* t, int val) {
+    uint32_t key = to_key(val);
+    void* node = t->root;
+    int level, found;
+    DS_OP_BEGIN(radix_stats);
+    for (level = 0; level < RADIX_LEAF_LEVEL && node != NULL; level++) {
+        void** child = find_child(node, key_byte(key, level));
+        DS_VISIT(radix_stats);
+        node = child != NULL ? *child : NULL;
+    }
+    if (node != NULL) {
+        DS_VISIT(radix_stats);
+    }
+    found = node != NULL && leaf_has((const struct radix_leaf*)node, key_byte(key, RADIX_LEAF_LEVEL));
+    DS_OP_END(radix_stats);
+    return found;
+}
+
+// Function to delete a key; nodes left empty are freed on the way back up
+int radix_delete(struct radix_tree* t, int val) {
+    uint32_t key = to_key(val);
+    void** refs[RADIX_LEAF_LEVEL + 1];
+    struct radix_leaf* leaf;
+    uint8_t b = key_byte(key, RADIX_LEAF_LEVEL);
+    int level;
+    DS_OP_BEGIN(radix_stats);
+    refs[0] = &t->root;
+    for (level = 0; level < RADIX_LEAF_LEVEL; level++) {
+        if (*refs[level] == NULL || (refs[level + 1] = find_child(*refs[level], key_byte(key, level))) == NULL) {
+            DS_OP_END(radix_stats);
+            return DS_NOT_FOUND;
+        }
+        DS_VISIT(radix_stats);
+    }
+    leaf = (struct radix_leaf*)*refs[RADIX_LEAF_LEVEL];
+    DS_VISIT(radix_stats);
+    if (!leaf_has(leaf, b)) {
+        DS_OP_END(radix_stats);
+        return DS_NOT_FOUND;
+    }
+    leaf->bits[b >> 6] &= ~(1ULL << (b & 63));
+    if (--leaf->count == 0) {
+        free_node(leaf);
+        for (level = RADIX_LEAF_LEVEL - 1; level >= 0; level--) {
+            remove_child(refs[level], key_byte(key, level));
+            if (*refs[level] != NULL) {
+                break;
+            }
+        }
+    }
+    t->count--;
+    DS_OP_END(radix_stats);
+    return DS_OK;
+}
+
+// Function to find the smallest key >= key below node; prefix holds the bytes
+// of the levels above. When the child for the key's byte has nothing large
+// enough, the answer is the minimum of the next child, found with key 0
+static int lower_bound(void* node, int level, uint32_t key, uint32_t prefix, uint32_t* out) {
+    int shift = 24 - 8 * level;
+    uint8_t b = key_byte(key, level);
+    uint8_t found;
+    void** slot;
+    void* next;
+    DS_VISIT(radix_stats);
+    if (level == RADIX_LEAF_LEVEL) {
+        int bit = leaf_next((const struct radix_leaf*)node, b);
+        if (bit < 0) {
+            return 0;
+        }
+        *out = prefix | (uint32_t)bit;
+        return 1;
+    }
+    slot = find_child(node, b);
+    if (slot != NULL && lower_bound(*slot, level + 1, key, prefix | (uint32_t)b << shift, out)) {
+        return 1;
+    }
+    if (b == 255 || (next = next_child((const struct radix_node*)node, b + 1, &found)) == NULL) {
+        return 0;
+    }
+    return lower_bound(next, level + 1, 0, prefix | (uint32_t)found << shift, out);
+}
+
+int radix_lower_bound(const struct radix_tree* t, int val, int* out) {
+    uint32_t key;
+    int found;
+    DS_OP_BEGIN(radix_stats);
+    found = t->root != NULL && lower_bound(t->root, 0, to_key(val), 0, &key);
+    DS_OP_END(radix_stats);
+    if (!found) {
+        return DS_NOT_FOUND;
+    }
+    *out = from_key(key);
+    return DS_OK;
+}
+
+int radix_successor(const struct radix_tree* t, int val, int* out) {
+    if (val == INT_MAX) {
+        return DS_NOT_FOUND;
+    }
+    return radix_lower_bound(t, val + 1, out);
+}
+
+static void inorder(const void* node, int level, uint32_t prefix, void (*visit)(int val, void* ctx), void* ctx) {
+    uint8_t b;
+    int next = 0;
+    const void* child;
+    if (level == RADIX_LEAF_LEVEL) {
+        while (next < 256 && (next = leaf_next((const struct radix_leaf*)node, next)) >= 0) {
+            visit(from_key(prefix | (uint32_t)next), ctx);
+            next++;
+        }
+        return;
+    }
+    while (next < 256 && (child = next_child((const struct radix_node*)node, next, &b)) != NULL) {
+        inorder(child, level + 1, prefix | (uint32_t)b << (24 - 8 * level), visit, ctx);
+        next = b + 1;
+    }
+}
+
+// Inorder traversal function, keys come out sorted since children are visited by byte
+void radix_inorder(const struct radix_tree* t, void (*visit)(int val, void* ctx), void* ctx) {
+    if (t->root != NULL) {
+        inorder(t->root, 0, 0, visit, ctx);
+    }
+}
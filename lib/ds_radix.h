@@ -0,0 +1,99 @@
+#ifndef DS_RADIX_H
+#define DS_RADIX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ds_stats.h"
+#include "ds_status.h"
+
+// Ordered set of int keys stored as an adaptive radix tree. A key is split
+// into its 4 bytes, most significant first (with the sign bit flipped so the
+// byte order is the int order), and each byte picks a child at one level.
+// Every operation therefore touches exactly 4 nodes, whatever the keys and
+// the order they were inserted in. Inner nodes grow and shrink between 4,
+// 16, 48 and 256 children so sparse levels stay small; the last byte selects
+// a bit in a 256-bit leaf.
+
+// Node types, stored in the header of every inner node
+#define RADIX_NODE4 0
+#define RADIX_NODE16 1
+#define RADIX_NODE48 2
+#define RADIX_NODE256 3
+
+struct radix_node {
+    uint8_t type;
+    uint16_t count;  // children in use
+};
+
+// Up to 4 / 16 children, keys kept sorted so iteration follows them
+struct radix_node4 {
+    struct radix_node n;
+    uint8_t keys[4];
+    void* child[4];
+};
+
+struct radix_node16 {
+    struct radix_node n;
+    uint8_t keys[16];
+    void* child[16];
+};
+
+// Up to 48 children: index[byte] is the slot + 1, 0 for no child
+struct radix_node48 {
+    struct radix_node n;
+    uint8_t index[256];
+    void* child[48];
+};
+
+struct radix_node256 {
+    struct radix_node n;
+    void* child[256];
+};
+
+// Last level: one bit per value of the lowest byte
+struct radix_leaf {
+    uint64_t bits[4];
+    uint16_t count;
+};
+
+// Children are void* since those of level 2 are leaves
+struct radix_tree {
+    void* root;
+    long count;
+};
+
+// Counters, only compiled in with -DDS_INSTRUMENT
+DS_STATS_DECLARE(radix_stats);
+
+static inline void radix_init(struct radix_tree* t) {
+    t->root = NULL;
+    t->count = 0;
+}
+
+// Function to free every node of the tree
+void radix_free(struct radix_tree* t);
+
+// Function to insert a key, returns DS_OK, DS_EXISTS or DS_NO_MEMORY
+int radix_insert(struct radix_tree* t, int key);
+
+// Function to search for a key, returns 1 if found
+int radix_search(const struct radix_tree* t, int key);
+
+// Function to delete a key, returns DS_OK or DS_NOT_FOUND
+int radix_delete(struct radix_tree* t, int key);
+
+// Function to find the smallest key >= key, stored in *out; returns DS_OK or DS_NOT_FOUND
+int radix_lower_bound(const struct radix_tree* t, int key, int* out);
+
+// Function to find the smallest key > key, stored in *out; returns DS_OK or DS_NOT_FOUND
+int radix_successor(const struct radix_tree* t, int key, int* out);
+
+// Inorder traversal function, calls visit() on every key in ascending order
+void radix_inorder(const struct radix_tree* t, void (*visit)(int val, void* ctx), void* ctx);
+
+// Function to get the number of keys
+static inline long radix_count(const struct radix_tree* t) {
+    return t->count;
+}
+
+#endif
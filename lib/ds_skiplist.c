@@ -0,0 +1,609 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "ds_skiplist.h"
+
+/**
+ * @file ds_skiplist.c
+ */
+
+DS_STATS_DEFINE(skiplist_stats, "skip list");
+
+/**
+ --> Drawing the Level of a New Node
+ *
+ * @function random_level
+ * @description
+ * This function returns 1 with probability 1/2, 2 with probability 1/4 and
+ * so on, which gives every level half the nodes of the level below it and
+ * keeps the expected search path at O(log n). The generator is xorshift64*;
+ * a zero state is seeded from its own address so every thread-local state
+ * starts somewhere different.
+ *
+ * @param seed: The generator state, updated in place.
+ * @return A level between 1 and SKIPLIST_MAX_LEVEL.
+ */
+static int random_level(uint64_t *seed) {
+    uint64_t x = *seed ? *seed : (uint64_t)(uintptr_t)seed ^ 0x9E3779B97F4A7C15ULL;
+    uint64_t r;
+    int level = 1;
+
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *seed = x;
+    r = x * 2685821657736338717ULL;
+    while ((r & 1) && level < SKIPLIST_MAX_LEVEL) {
+        level++;
+        r >>= 1;
+    }
+    return level;
+}
+
+/**
+ --> Creating an Empty Skip List
+ *
+ * @function skiplist_init
+ * @description
+ * This function allocates the head sentinel with every level pointing to
+ * `NULL`, so the first search ends immediately.
+ *
+ * @param sl: The skip list to initialize.
+ * @return DS_OK, or DS_NO_MEMORY.
+ */
+int skiplist_init(struct skiplist *sl) {
+    int i;
+    sl->head = (struct skiplist_node *)malloc(sizeof(struct skiplist_node) +
+                                              SKIPLIST_MAX_LEVEL * sizeof(struct skiplist_node *));
+    if (sl->head == NULL) {
+        return DS_NO_MEMORY;
+    }
+    sl->head->level = SKIPLIST_MAX_LEVEL;
+    for (i = 0; i < SKIPLIST_MAX_LEVEL; i++) {
+        sl->head->next[i] = NULL;
+    }
+    sl->level = 1;
+    sl->count = 0;
+    sl->seed = 0x2545F4914F6CDD1DULL;
+    return DS_OK;
+}
+
+/**
+ * @function skiplist_free
+ * @description
+ * This function walks level 0, which links every node, and frees the nodes
+ * and the head sentinel.
+ *
+ * @param sl: The skip list to free.
+ */
+void skiplist_free(struct skiplist *sl) {
+    struct skiplist_node *node = sl->head->next[0];
+    while (node != NULL) {
+        struct skiplist_node *next = node->next[0];
+        free(node);
+        DS_FREE(skiplist_stats);
+        node = next;
+    }
+    free(sl->head);
+    sl->head = NULL;
+    sl->count = 0;
+}
+
+/**
+ --> Insertion into the Skip List
+ *
+ * @function skiplist_insert
+ * @description
+ * This function inserts a value while keeping every level sorted.
+ *
+ * The function performs the following steps:
+ * 1. Descends from the highest level in use, moving right while the next
+ *    value is smaller, and remembers the last node of each level in `update`.
+ * 2. If the node reached on level 0 already holds the value, returns `DS_EXISTS`.
+ * 3. Draws the level of the new node and links it after `update[i]` on each
+ *    of its levels.
+ *
+ * @param sl: The skip list.
+ * @param val: The value to insert.
+ * @return DS_OK, DS_EXISTS or DS_NO_MEMORY.
+ */
+int skiplist_insert(struct skiplist *sl, int val) {
+    struct skiplist_node *update[SKIPLIST_MAX_LEVEL];
+    struct skiplist_node *x = sl->head, *node;
+    int i, level;
+
+    DS_OP_BEGIN(skiplist_stats);
+    for (i = sl->level - 1; i >= 0; i--) {
+        while (x->next[i] != NULL && x->next[i]->data < val) {
+            x = x->next[i];
+            DS_VISIT(skiplist_stats);
+        }
+        update[i] = x;
+    }
+    x = x->next[0];
+    if (x != NULL && x->data == val) {
+        DS_OP_END(skiplist_stats);
+        return DS_EXISTS;
+    }
+
+    level = random_level(&sl->seed);
+    node = (struct skiplist_node *)malloc(sizeof(struct skiplist_node) + level * sizeof(struct skiplist_node *));
+    if (node == NULL) {
+        DS_OP_END(skiplist_stats);
+        return DS_NO_MEMORY;
+    }
+    DS_ALLOC(skiplist_stats);
+    node->data = val;
+    node->level = level;
+
+    // Levels above the current top start from the head
+    for (i = sl->level; i < level; i++) {
+        update[i] = sl->head;
+    }
+    if (level > sl->level) {
+        sl->level = level;
+    }
+    for (i = 0; i < level; i++) {
+        node->next[i] = update[i]->next[i];
+        update[i]->next[i] = node;
+    }
+    sl->count++;
+    DS_OP_END(skiplist_stats);
+    return DS_OK;
+}
+
+/**
+ --> Deletion from the Skip List
+ *
+ * @function skiplist_delete
+ * @description
+ * This function finds the predecessors of the value on every level like
+ * `skiplist_insert`, unlinks the node from each level it is on, frees it and
+ * lowers the level in use while the top levels are empty.
+ *
+ * @param sl: The skip list.
+ * @param val: The value to delete.
+ * @return DS_OK, or DS_NOT_FOUND.
+ */
+int skiplist_delete(struct skiplist *sl, int val) {
+    struct skiplist_node *update[SKIPLIST_MAX_LEVEL];
+    struct skiplist_node *x = sl->head;
+    int i;
+
+    DS_OP_BEGIN(skiplist_stats);
+    for (i = sl->level - 1; i >= 0; i--) {
+        while (x->next[i] != NULL && x->next[i]->data < val) {
+            x = x->next[i];
+            DS_VISIT(skiplist_stats);
+        }
+        update[i] = x;
+    }
+    x = x->next[0];
+    if (x == NULL || x->data != val) {
+        DS_OP_END(skiplist_stats);
+        return DS_NOT_FOUND;
+    }
+
+    for (i = 0; i < x->level; i++) {
+        update[i]->next[i] = x->next[i];
+    }
+    free(x);
+    DS_FREE(skiplist_stats);
+    while (sl->level > 1 && sl->head->next[sl->level - 1] == NULL) {
+        sl->level--;
+    }
+    sl->count--;
+    DS_OP_END(skiplist_stats);
+    return DS_OK;
+}
+
+/**
+ --> Searching the Skip List
+ *
+ * @function skiplist_search
+ * @description
+ * This function descends the levels like `skiplist_insert` without recording
+ * the path and checks the node reached on level 0.
+ *
+ * @param sl: The skip list.
+ * @param val: The value to search for.
+ * @return 1 if the value is present, 0 otherwise.
+ */
+int skiplist_search(const struct skiplist *sl, int val) {
+    const struct skiplist_node *x = sl->head;
+    int i;
+
+    DS_OP_BEGIN(skiplist_stats);
+    for (i = sl->level - 1; i >= 0; i--) {
+        while (x->next[i] != NULL && x->next[i]->data < val) {
+            x = x->next[i];
+            DS_VISIT(skiplist_stats);
+        }
+    }
+    x = x->next[0];
+    DS_OP_END(skiplist_stats);
+    return x != NULL && x->data == val;
+}
+
+/**
+ * @function skiplist_traverse
+ * @description
+ * This function follows level 0, the full sorted list, and calls `visit`
+ * with every value in ascending order.
+ *
+ * @param sl: The skip list.
+ * @param visit: The function called with every value.
+ * @param ctx: An opaque pointer passed through to `visit`.
+ */
+void skiplist_traverse(const struct skiplist *sl, void (*visit)(int val, void *ctx), void *ctx) {
+    const struct skiplist_node *x;
+    DS_OP_BEGIN(skiplist_stats);
+    for (x = sl->head->next[0]; x != NULL; x = x->next[0]) {
+        DS_VISIT(skiplist_stats);
+        visit(x->data, ctx);
+    }
+    DS_OP_END(skiplist_stats);
+}
+
+/**
+ --> Lock-free Skip List
+ *
+ * The concurrent variant follows the Herlihy-Shavit lock-free skip list.
+ * A node is deleted by setting the lowest bit of its own `next` links, top
+ * level first; level 0 decides which thread deleted it. Any thread that later
+ * walks past a marked node unlinks it with a compare-and-swap on its
+ * predecessor, and a compare-and-swap that expects an unmarked link fails if
+ * the predecessor itself got marked, so no update is ever lost.
+ *
+ * Every operation runs inside an epoch (ds_epoch.h) on the thread's slot. A
+ * deleted node is retired once it is unlinked from every level, and freed
+ * when no operation that could still be reading it is left.
+ * The DS_* counters are plain integers and are not updated here.
+ */
+
+#define CSL_MARK(p) ((struct cskiplist_node *)((uintptr_t)(p) | 1u))
+#define CSL_UNMARK(p) ((struct cskiplist_node *)((uintptr_t)(p) & ~(uintptr_t)1u))
+#define CSL_IS_MARKED(p) (((uintptr_t)(p) & 1u) != 0)
+
+static __thread uint64_t cskiplist_seed;
+
+static inline struct cskiplist_node *load_next(struct cskiplist_node *node, int level) {
+    return __atomic_load_n(&node->next[level], __ATOMIC_ACQUIRE);
+}
+
+static inline int cas_next(struct cskiplist_node *node, int level, struct cskiplist_node *expected,
+                           struct cskiplist_node *desired) {
+    return __atomic_compare_exchange_n(&node->next[level], &expected, desired, 0,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @function cskiplist_init
+ * @description
+ * This function allocates the head sentinel with every level pointing to `NULL`.
+ *
+ * @param sl: The skip list to initialize.
+ * @return DS_OK, or DS_NO_MEMORY.
+ */
+int cskiplist_init(struct cskiplist *sl) {
+    int i;
+    sl->head = (struct cskiplist_node *)malloc(sizeof(struct cskiplist_node) +
+                                               SKIPLIST_MAX_LEVEL * sizeof(struct cskiplist_node *));
+    if (sl->head == NULL) {
+        return DS_NO_MEMORY;
+    }
+    sl->head->level = SKIPLIST_MAX_LEVEL;
+    sl->head->owners = 0;
+    sl->head->retired = NULL;
+    for (i = 0; i < SKIPLIST_MAX_LEVEL; i++) {
+        sl->head->next[i] = NULL;
+    }
+    sl->count = 0;
+    ds_epoch_init(&sl->reclaim, offsetof(struct cskiplist_node, retired));
+    return DS_OK;
+}
+
+/**
+ * @function cskiplist_free
+ * @description
+ * This function frees the live nodes (the unmarked ones on level 0), every
+ * retired node not freed yet and the head sentinel. It must run once all
+ * threads are done.
+ *
+ * @param sl: The skip list to free.
+ */
+void cskiplist_free(struct cskiplist *sl) {
+    struct cskiplist_node *node = CSL_UNMARK(sl->head->next[0]);
+    while (node != NULL) {
+        struct cskiplist_node *next = node->next[0];
+        if (!CSL_IS_MARKED(next)) {
+            free(node);  // Marked nodes are retired
+        }
+        node = CSL_UNMARK(next);
+    }
+    ds_epoch_free(&sl->reclaim);
+    free(sl->head);
+    sl->head = NULL;
+    sl->count = 0;
+}
+
+/**
+ * @function cskiplist_register
+ * @description
+ * This function hands out one of the CSKIPLIST_MAX_THREADS thread slots.
+ *
+ * @param sl: The skip list.
+ * @return The slot, or DS_NO_MEMORY if every slot is taken.
+ */
+int cskiplist_register(struct cskiplist *sl) {
+    return ds_epoch_register(&sl->reclaim);
+}
+
+/**
+ * @function cskiplist_unregister
+ * @description
+ * This function gives a slot back; the thread must not use the list afterwards.
+ *
+ * @param sl: The skip list.
+ * @param slot: The slot from `cskiplist_register`.
+ */
+void cskiplist_unregister(struct cskiplist *sl, int slot) {
+    ds_epoch_unregister(&sl->reclaim, slot);
+}
+
+/**
+ --> Finding the Position of a Value
+ *
+ * @function cskiplist_find
+ * @description
+ * This function fills `preds[i]` with the last node holding a smaller value
+ * on level `i` and `succs[i]` with the node after it, unlinking every marked
+ * node it meets on the way. If an unlink fails, the predecessor changed under
+ * us and the walk restarts from the head.
+ *
+ * @param sl: The skip list.
+ * @param val: The value to look for.
+ * @param preds: Receives the predecessor on every level.
+ * @param succs: Receives the successor on every level.
+ * @return 1 if `succs[0]` holds `val`, 0 otherwise.
+ */
+static int cskiplist_find(struct cskiplist *sl, int val, struct cskiplist_node **preds,
+                          struct cskiplist_node **succs) {
+    struct cskiplist_node *pred, *curr, *succ;
+    int level;
+
+retry:
+    pred = sl->head;
+    curr = NULL;
+    for (level = SKIPLIST_MAX_LEVEL - 1; level >= 0; level--) {
+        curr = CSL_UNMARK(load_next(pred, level));
+        while (curr != NULL) {
+            succ = load_next(curr, level);
+            if (CSL_IS_MARKED(succ)) {
+                // curr is deleted: unlink it from this level and look at what follows
+                if (!cas_next(pred, level, curr, CSL_UNMARK(succ))) {
+                    goto retry;
+                }
+                curr = CSL_UNMARK(succ);
+            } else if (curr->data < val) {
+                pred = curr;
+                curr = succ;
+            } else {
+                break;
+            }
+        }
+        preds[level] = pred;
+        succs[level] = curr;
+    }
+    return curr != NULL && curr->data == val;
+}
+
+/**
+ * @function cskiplist_release
+ * @description
+ * This function is called by the inserting thread once it stops linking the
+ * node and by the thread that deleted it. The last of the two runs one more
+ * find, which unlinks the node from every level it got linked on: after
+ * that nothing links to it again, so it is retired.
+ *
+ * @param sl: The skip list.
+ * @param node: The deleted or inserted node.
+ */
+static void cskiplist_release(struct cskiplist *sl, struct cskiplist_node *node) {
+    struct cskiplist_node *preds[SKIPLIST_MAX_LEVEL], *succs[SKIPLIST_MAX_LEVEL];
+    if (__atomic_sub_fetch(&node->owners, 1, __ATOMIC_ACQ_REL) == 0) {
+        cskiplist_find(sl, node->data, preds, succs);
+        ds_epoch_retire(&sl->reclaim, node);
+    }
+}
+
+/**
+ * @function cskiplist_insert
+ * @description
+ * This function inserts a value from any thread.
+ *
+ * The function performs the following steps:
+ * 1. Finds the predecessors and successors of the value; returns `DS_EXISTS`
+ *    if the value is already present.
+ * 2. Points every level of the new node at its successor and publishes it
+ *    with one compare-and-swap on level 0, which is the moment the value
+ *    becomes part of the set. On failure it finds the position again.
+ * 3. Links the upper levels one by one the same way. If the node gets deleted
+ *    meanwhile (its own link is marked) the remaining levels are skipped.
+ * 4. Releases its hold on the node: a thread that deleted the node while it
+ *    was being linked leaves the final unlinking to the last of the two.
+ *
+ * @param sl: The skip list.
+ * @param slot: The calling thread's slot.
+ * @param val: The value to insert.
+ * @return DS_OK, DS_EXISTS or DS_NO_MEMORY.
+ */
+int cskiplist_insert(struct cskiplist *sl, int slot, int val) {
+    struct cskiplist_node *preds[SKIPLIST_MAX_LEVEL], *succs[SKIPLIST_MAX_LEVEL];
+    struct cskiplist_node *node = NULL, *succ;
+    int level, top = random_level(&cskiplist_seed);
+
+    ds_epoch_enter(&sl->reclaim, slot);
+    for (;;) {
+        if (cskiplist_find(sl, val, preds, succs)) {
+            ds_epoch_exit(&sl->reclaim, slot);
+            free(node);
+            return DS_EXISTS;
+        }
+        if (node == NULL) {
+            node = (struct cskiplist_node *)malloc(sizeof(struct cskiplist_node) +
+                                                   top * sizeof(struct cskiplist_node *));
+            if (node == NULL) {
+                ds_epoch_exit(&sl->reclaim, slot);
+                return DS_NO_MEMORY;
+            }
+            node->data = val;
+            node->level = top;
+            node->owners = 2;
+            node->retired = NULL;
+        }
+        for (level = 0; level < top; level++) {
+            node->next[level] = succs[level];
+        }
+        if (cas_next(preds[0], 0, succs[0], node)) {
+            break;
+        }
+    }
+    __atomic_fetch_add(&sl->count, 1, __ATOMIC_RELAXED);
+
+    for (level = 1; level < top; level++) {
+        for (;;) {
+            succ = load_next(node, level);
+            if (CSL_IS_MARKED(succ)) {
+                goto linked;  // Deleted while we were linking it
+            }
+            if (succ != succs[level] && !cas_next(node, level, succ, succs[level])) {
+                continue;
+            }
+            if (cas_next(preds[level], level, succs[level], node)) {
+                break;
+            }
+            cskiplist_find(sl, val, preds, succs);
+        }
+    }
+linked:
+    cskiplist_release(sl, node);
+    ds_epoch_exit(&sl->reclaim, slot);
+    return DS_OK;
+}
+
+/**
+ * @function cskiplist_delete
+ * @description
+ * This function deletes a value from any thread.
+ *
+ * The function performs the following steps:
+ * 1. Finds the node; returns `DS_NOT_FOUND` if the value is absent.
+ * 2. Marks the links of the node from its top level down to level 1, so no
+ *    node can be inserted after it any more.
+ * 3. Marks level 0. The thread whose compare-and-swap succeeds owns the
+ *    deletion; a thread that finds it already marked lost the race and
+ *    reports `DS_NOT_FOUND`.
+ * 4. Releases its hold on the node: unless the inserting thread is still
+ *    linking it, it runs one more find, which unlinks the node from every
+ *    level, and retires it.
+ *
+ * @param sl: The skip list.
+ * @param slot: The calling thread's slot.
+ * @param val: The value to delete.
+ * @return DS_OK, or DS_NOT_FOUND.
+ */
+int cskiplist_delete(struct cskiplist *sl, int slot, int val) {
+    struct cskiplist_node *preds[SKIPLIST_MAX_LEVEL], *succs[SKIPLIST_MAX_LEVEL];
+    struct cskiplist_node *node, *succ;
+    int level;
+
+    ds_epoch_enter(&sl->reclaim, slot);
+    if (!cskiplist_find(sl, val, preds, succs)) {
+        ds_epoch_exit(&sl->reclaim, slot);
+        return DS_NOT_FOUND;
+    }
+    node = succs[0];
+    for (level = node->level - 1; level > 0; level--) {
+        succ = load_next(node, level);
+        while (!CSL_IS_MARKED(succ)) {
+            cas_next(node, level, succ, CSL_MARK(succ));
+            succ = load_next(node, level);
+        }
+    }
+    succ = load_next(node, 0);
+    for (;;) {
+        if (CSL_IS_MARKED(succ)) {
+            ds_epoch_exit(&sl->reclaim, slot);
+            return DS_NOT_FOUND;
+        }
+        if (cas_next(node, 0, succ, CSL_MARK(succ))) {
+            break;
+        }
+        succ = load_next(node, 0);
+    }
+    __atomic_fetch_sub(&sl->count, 1, __ATOMIC_RELAXED);
+    cskiplist_release(sl, node);
+    ds_epoch_exit(&sl->reclaim, slot);
+    return DS_OK;
+}
+
+/**
+ * @function cskiplist_search
+ * @description
+ * This function descends like `cskiplist_find` but steps over marked nodes
+ * instead of unlinking them, so it never writes and never restarts.
+ *
+ * @param sl: The skip list.
+ * @param slot: The calling thread's slot.
+ * @param val: The value to search for.
+ * @return 1 if the value is present, 0 otherwise.
+ */
+int cskiplist_search(struct cskiplist *sl, int slot, int val) {
+    struct cskiplist_node *pred = sl->head, *curr = NULL, *succ;
+    int level, found;
+
+    ds_epoch_enter(&sl->reclaim, slot);
+    for (level = SKIPLIST_MAX_LEVEL - 1; level >= 0; level--) {
+        curr = CSL_UNMARK(load_next(pred, level));
+        while (curr != NULL) {
+            succ = load_next(curr, level);
+            if (CSL_IS_MARKED(succ)) {
+                curr = CSL_UNMARK(succ);
+            } else if (curr->data < val) {
+                pred = curr;
+                curr = succ;
+            } else {
+                break;
+            }
+        }
+    }
+    found = curr != NULL && curr->data == val;
+    ds_epoch_exit(&sl->reclaim, slot);
+    return found;
+}
+
+/**
+ * @function cskiplist_traverse
+ * @description
+ * This function follows level 0 and calls `visit` with the value of every
+ * node that is not marked as deleted.
+ *
+ * @param sl: The skip list.
+ * @param slot: The calling thread's slot.
+ * @param visit: The function called with every value, in ascending order.
+ * @param ctx: An opaque pointer passed through to `visit`.
+ */
+void cskiplist_traverse(struct cskiplist *sl, int slot, void (*visit)(int val, void *ctx), void *ctx) {
+    struct cskiplist_node *node;
+    ds_epoch_enter(&sl->reclaim, slot);
+    node = CSL_UNMARK(load_next(sl->head, 0));
+    while (node != NULL) {
+        struct cskiplist_node *next = load_next(node, 0);
+        if (!CSL_IS_MARKED(next)) {
+            visit(node->data, ctx);
+        }
+        node = CSL_UNMARK(next);
+    }
+    ds_epoch_exit(&sl->reclaim, slot);
+}
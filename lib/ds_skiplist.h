@@ -0,0 +1,160 @@
+#ifndef DS_SKIPLIST_H
+#define DS_SKIPLIST_H
+
+#include <stdint.h>
+#include "ds_epoch.h"
+#include "ds_stats.h"
+#include "ds_status.h"
+
+/**
+ * @file ds_skiplist.h
+ * Sorted sets of integers kept in a skip list: a sorted linked list with
+ * extra express links on top, so search, insertion and deletion cost
+ * O(log n) expected instead of the O(n) walk of `slist_search_list`.
+ *
+ * Two flavours share the layout:
+ * - `skiplist_*`  single-threaded, counted by the DS_* instrumentation.
+ * - `cskiplist_*` lock-free, up to CSKIPLIST_MAX_THREADS registered threads
+ *                 may insert, delete and search at the same time
+ *                 (compare-and-swap on marked links).
+ */
+
+/** Highest number of levels a node can have; 2^32 elements before it matters. */
+#define SKIPLIST_MAX_LEVEL 32
+
+/**
+ --> Creating the Node of a skip list
+ *
+ * @struct skiplist_node
+ * @description
+ * Each node stores:
+ * - `data`: The integer value of the node.
+ * - `level`: How many levels the node is linked on (1 to SKIPLIST_MAX_LEVEL).
+ * - `next`: `next[i]` is the following node on level `i`, level 0 being the
+ *           plain sorted list. The array is allocated with the node.
+ */
+struct skiplist_node {
+    int data;
+    int level;
+    struct skiplist_node *next[];
+};
+
+/**
+ * @struct skiplist
+ * @description
+ * A skip list is a handle on a sentinel head node that has every level.
+ * - `level`: The number of levels currently in use.
+ * - `count`: The number of values in the set.
+ * - `seed`: State of the generator that draws the level of new nodes.
+ */
+struct skiplist {
+    struct skiplist_node *head;
+    int level;
+    int count;
+    uint64_t seed;
+};
+
+/**
+ * Counters for the skip list operations, only compiled in with -DDS_INSTRUMENT
+ * (see ds_stats.h). `max_visited` is the longest search path of one operation.
+ */
+DS_STATS_DECLARE(skiplist_stats);
+
+/** Creates an empty skip list, returns DS_OK or DS_NO_MEMORY. */
+int skiplist_init(struct skiplist *sl);
+
+/** Frees every node, the skip list must be initialized again before reuse. */
+void skiplist_free(struct skiplist *sl);
+
+/** Inserts `val`, returns DS_OK, DS_EXISTS or DS_NO_MEMORY. */
+int skiplist_insert(struct skiplist *sl, int val);
+
+/** Deletes `val`, returns DS_OK or DS_NOT_FOUND. */
+int skiplist_delete(struct skiplist *sl, int val);
+
+/** Returns 1 if `val` is in the skip list. */
+int skiplist_search(const struct skiplist *sl, int val);
+
+/** Calls `visit` with every value in ascending order. */
+void skiplist_traverse(const struct skiplist *sl, void (*visit)(int val, void *ctx), void *ctx);
+
+/** Returns the number of values in the skip list. */
+static inline int skiplist_count(const struct skiplist *sl) {
+    return sl->count;
+}
+
+/**
+ --> Lock-free Skip List
+ *
+ * @struct cskiplist_node
+ * @description
+ * Same layout as `skiplist_node`, but the links are only touched through
+ * atomic operations and the lowest bit of `next[i]` marks the node as deleted
+ * on level `i`.
+ * - `owners`: The inserting and the deleting thread; whichever of them is
+ *             done with the node last unlinks it for good and retires it.
+ * - `retired`: Next node on a reclamation list.
+ */
+struct cskiplist_node {
+    int data;
+    int level;
+    int owners;
+    struct cskiplist_node *retired;
+    struct cskiplist_node *next[];
+};
+
+/**
+ * @struct cskiplist
+ * @description
+ * - `head`: Sentinel with every level, never deleted.
+ * - `count`: Number of values, exact whenever no operation is in flight.
+ * - `reclaim`: Thread slots and deleted nodes. A thread may still be standing
+ *              on a deleted node, so deleted nodes are freed by epoch-based
+ *              reclamation (see ds_epoch.h) once no operation can hold them;
+ *              under insert/delete churn memory stays bounded.
+ */
+struct cskiplist {
+    struct cskiplist_node *head;
+    long count;
+    struct ds_epoch reclaim;
+};
+
+/** Most threads that can use one lock-free skip list at the same time. */
+#define CSKIPLIST_MAX_THREADS DS_EPOCH_MAX_THREADS
+
+/** Creates an empty lock-free skip list, returns DS_OK or DS_NO_MEMORY. */
+int cskiplist_init(struct cskiplist *sl);
+
+/** Frees every node, including deleted ones; no thread may use the list during the call. */
+void cskiplist_free(struct cskiplist *sl);
+
+/**
+ * Gets a slot for the calling thread, which it passes to every operation;
+ * returns it, or DS_NO_MEMORY if CSKIPLIST_MAX_THREADS threads hold one.
+ */
+int cskiplist_register(struct cskiplist *sl);
+
+/** Gives the slot back when the thread is done with the list. */
+void cskiplist_unregister(struct cskiplist *sl, int slot);
+
+/** Inserts `val`, returns DS_OK, DS_EXISTS or DS_NO_MEMORY; safe from any thread. */
+int cskiplist_insert(struct cskiplist *sl, int slot, int val);
+
+/** Deletes `val`, returns DS_OK or DS_NOT_FOUND; safe from any thread. */
+int cskiplist_delete(struct cskiplist *sl, int slot, int val);
+
+/** Returns 1 if `val` is in the skip list; wait-free, never writes to the list. */
+int cskiplist_search(struct cskiplist *sl, int slot, int val);
+
+/**
+ * Calls `visit` with every value in ascending order. Safe while other threads
+ * modify the list: values present for the whole walk are always visited.
+ */
+void cskiplist_traverse(struct cskiplist *sl, int slot, void (*visit)(int val, void *ctx), void *ctx);
+
+/** Returns the number of values in the skip list. */
+static inline long cskiplist_count(struct cskiplist *sl) {
+    return __atomic_load_n(&sl->count, __ATOMIC_RELAXED);
+}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef DS_SLAB_H
+#define DS_SLAB_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// One block of memory holding a run of list nodes, so that the nodes of a
+// compacted list sit one after the other in list order whatever the allocator
+// does with single nodes. The nodes are still unlinked and freed one by one:
+// each records its 1-based slot in the block (0 for a node malloc'ed on its
+// own), which is how the free path gets from a node back to the header in
+// front of the block, and the block itself is freed with its last node.
+// Space of nodes freed early is only returned with the whole block.
+
+struct ds_slab {
+    size_t live;    // nodes of the block not freed yet; the nodes follow
+};
+
+// Function to allocate a block for count nodes of node_size bytes each,
+// returns the first node or NULL. Nodes are aligned like a size_t, enough for
+// nodes made of ints and pointers
+static inline void* ds_slab_alloc(size_t count, size_t node_size) {
+    struct ds_slab* slab;
+    if (count == 0 || count > UINT32_MAX || count > (SIZE_MAX - sizeof(struct ds_slab)) / node_size) {
+        return NULL;
+    }
+    slab = (struct ds_slab*)malloc(sizeof(struct ds_slab) + count * node_size);
+    if (slab == NULL) {
+        return NULL;
+    }
+    slab->live = count;
+    return slab + 1;
+}
+
+// Function to free the node in the given slot of its block, and the block
+// with its last node
+static inline void ds_slab_put(void* node, uint32_t slot, size_t node_size) {
+    struct ds_slab* slab = (struct ds_slab*)((char*)node - (size_t)(slot - 1) * node_size) - 1;
+    if (--slab->live == 0) {
+        free(slab);
+    }
+}
+
+#endif
@@ -0,0 +1,1062 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "ds_slist.h"
+#include "ds_intset.h"
+#include "ds_slab.h"
+
+/**
+ * @file ds_slist.c
+ */
+
+DS_STATS_DEFINE(slist_stats, "single linked list");
+
+/**
+ * Frees a node: on its own, or back into the block slist_compact() carved
+ * it from, which goes with its last node.
+ */
+static void free_node(struct slist_node *node) {
+    if (node->slot != 0) {
+        ds_slab_put(node, node->slot, sizeof(*node));
+    } else {
+        free(node);
+    }
+}
+
+/*Traversing a Single Linked List */
+
+    /**
+     --> Method 1: By Counting the number of Nodes
+
+      * @function slist_count_of_nodes
+      * @description
+      * This function counts the number of nodes in a singly linked list.
+      * It starts from the head node and traverses the list, incrementing
+      * a counter for each node, and returns the total (0 for an empty list).
+      *
+      * @param head: A pointer to the head node of the linked list.
+      * @return The number of nodes in the list.
+    */
+
+     int slist_count_of_nodes(struct slist_node *head){
+         int count = 0;
+         DS_OP_BEGIN(slist_stats);
+         struct slist_node *ptr = head;
+         while (ptr != NULL) {
+             DS_VISIT(slist_stats);
+             count++;
+             ptr = ptr->link;
+         }
+         DS_OP_END(slist_stats);
+         return count;
+     }
+   /**
+    -->Method 2: By Visiting the Data
+
+      * @function slist_traverse
+      * @description
+      * This function hands the data stored in each node of a singly linked list
+      * to a callback. It starts from the head node and calls `visit` with the
+      * `data` field of each node, then moves to the next node by following the
+      * `link` pointer until it reaches the end of the list. The list itself
+      * never prints: the menu passes a callback that does.
+      *
+      * @param head: A pointer to the head node of the linked list.
+      * @param visit: The function called with every value, in list order.
+      * @param ctx: An opaque pointer passed through to `visit`.
+    */
+
+     void slist_traverse(struct slist_node *head, void (*visit)(int val, void *ctx), void *ctx){
+         DS_OP_BEGIN(slist_stats);
+         struct slist_node *ptr = head;
+         while (ptr != NULL) {
+             DS_VISIT(slist_stats);
+             // Ask for the node after next while visit() runs
+             if (ptr->link != NULL) {
+                 __builtin_prefetch(ptr->link->link);
+             }
+             visit(ptr->data, ctx);
+             ptr = ptr->link;
+         }
+         DS_OP_END(slist_stats);
+     }
+
+     /**
+ -->Insertion at the Beginning of the list
+
+  * @function slist_add_beg
+  * @description
+  * This function inserts a new node at the beginning of a singly linked list.
+  * The new node is created dynamically with the specified data, and it is
+  * linked as the first node in the list by updating the `link` pointer of the
+  * original head node. If the memory allocation for the new node fails,
+  * the list is left unchanged and `DS_NO_MEMORY` is returned.
+  *
+  * @param head: A pointer to the head node of the linked list.
+  * @param x: The integer value to be stored in the new node.
+  * @return DS_OK, or DS_NO_MEMORY.
+*/
+int slist_add_beg(struct slist_node** head, int x) {
+    DS_OP_BEGIN(slist_stats);
+    struct slist_node* new_node = malloc(sizeof(struct slist_node));
+    if (new_node == NULL) {
+        DS_OP_END(slist_stats);
+        return DS_NO_MEMORY;
+    }
+    DS_ALLOC(slist_stats);
+    new_node-> data= x;
+    new_node->slot = 0;
+     new_node->link = NULL;
+
+    new_node->link = *head;  // Link new node to the current head
+    *head = new_node;        // Update the original head
+    DS_OP_END(slist_stats);
+    return DS_OK;
+}
+
+
+/**
+ -->Insertion at the End of the list
+
+  * @function slist_add_at_end
+  * @description
+  * This function inserts a new node at the end of a singly linked list.
+  * The new node is created dynamically with the specified data, and it is
+  * linked as the last node in the list by updating the `link` pointer of
+  * the current last node. If the memory allocation for the new node fails,
+  * the list is left unchanged and `DS_NO_MEMORY` is returned.
+  *
+  * @param head: A pointer to the head node of the linked list.
+  * @param x: The integer value to be stored in the new node.
+  * @return DS_OK, or DS_NO_MEMORY.
+*/
+
+int slist_add_at_end(struct slist_node **head, int x) {
+    DS_OP_BEGIN(slist_stats);
+    struct slist_node *new_node = malloc(sizeof(struct slist_node));
+    if (new_node == NULL) {
+        DS_OP_END(slist_stats);
+        return DS_NO_MEMORY;
+    }
+    DS_ALLOC(slist_stats);
+    new_node->data = x;
+    new_node->slot = 0;
+    new_node->link = NULL;
+
+    if (*head == NULL) {
+        *head = new_node;
+        DS_OP_END(slist_stats);
+        return DS_OK;
+    }
+
+    struct slist_node *ptr = *head;
+    while (ptr->link != NULL) {
+        DS_VISIT(slist_stats);
+        ptr = ptr->link;
+    }
+    ptr->link = new_node;
+    DS_OP_END(slist_stats);
+    return DS_OK;
+}
+
+/**
+ --> Function to insert a node before a specific element
+ * @function slist_insert_before_element
+ * @description
+ * This function inserts a new node before a specific element in a singly linked list.
+ *
+ * The function performs the following steps:
+ * 1. Receives the data for the new node and the value before which it will be inserted
+ *    (the menu prompts for both, the batch mode reads them from the operation log).
+ * 2. Allocates memory for the new node and initializes its data field.
+ * 3. Checks if the list is empty. If it is, the function returns `DS_EMPTY`.
+ * 4. If the target value is the first node, the new node is inserted at the beginning.
+ * 5. Traverses the list to find the target value.
+ * 6. If the target value is not found, the function returns `DS_NOT_FOUND`.
+ * 7. Inserts the new node before the target value by adjusting the pointers.
+ *
+ * @param head: A double pointer to the head node of the linked list.
+ * @param num: The integer value to be stored in the new node.
+ * @param val: The value before which the new node is inserted.
+ * @return DS_OK, DS_EMPTY, DS_NOT_FOUND or DS_NO_MEMORY.
+ */
+int slist_insert_before_element(struct slist_node **head, int num, int val) {
+    DS_OP_BEGIN(slist_stats);
+    struct slist_node *new_node, *ptr, *preptr = NULL;
+
+    new_node = (struct slist_node *)malloc(sizeof(struct slist_node));
+    if (new_node == NULL) {
+        DS_OP_END(slist_stats);
+        return DS_NO_MEMORY;
+    }
+    DS_ALLOC(slist_stats);
+    new_node->data = num;
+    new_node->slot = 0;
+    new_node->link = NULL;
+
+    // Check if the list is empty
+    if (*head == NULL) {
+        free(new_node);
+        DS_FREE(slist_stats);
+        DS_OP_END(slist_stats);
+        return DS_EMPTY;
+    }
+
+    ptr = *head;
+    // Check if the value is the first node
+    if (ptr->data == val) {
+        new_node->link = *head;
+        *head = new_node;
+        DS_OP_END(slist_stats);
+        return DS_OK;
+    }
+
+    // Traverse the list to find the target value
+    while (ptr != NULL && ptr->data != val) {
+        preptr = ptr;
+        ptr = ptr->link;
+        DS_VISIT(slist_stats);
+    }
+
+    // If the target value is not found
+    if (ptr == NULL) {
+        free(new_node);
+        DS_FREE(slist_stats);
+        DS_OP_END(slist_stats);
+        return DS_NOT_FOUND;
+    }
+
+    // Insert the new node before the target value
+    preptr->link = new_node;
+    new_node->link = ptr;
+    DS_OP_END(slist_stats);
+    return DS_OK;
+}
+
+/**
+-->Insertion at any position of the list
+ * @function slist_insert_at_position
+ * @description
+ * This function inserts a new node at a specific position in a singly linked list.
+ * It starts from the head node and traverses the list until the desired position is reached.
+ * If the position is valid (1-based index), the new node is inserted at that position by adjusting the pointers.
+ * If the position is past the end of the list, the list is left unchanged and `DS_BAD_POSITION` is returned.
+ *
+ * @param head: A pointer to the head node of the linked list.
+ * @param x: The integer value to be stored in the new node.
+ * @param position: The position at which to insert the new node (1-based index).
+ * @return DS_OK, DS_BAD_POSITION or DS_NO_MEMORY.
+ */
+int slist_insert_at_position(struct slist_node** head, int x, int position) {
+    DS_OP_BEGIN(slist_stats);
+    // Create a new node
+    struct slist_node* new_node = malloc(sizeof(struct slist_node));
+    if (new_node == NULL) {
+        DS_OP_END(slist_stats);
+        return DS_NO_MEMORY;
+    }
+    DS_ALLOC(slist_stats);
+    new_node->data = x;
+    new_node->slot = 0;
+    new_node->link = NULL;
+
+    // If position is 1, insert at the beginning
+    if (position == 1) {
+        new_node->link = *head;
+        *head = new_node;
+        DS_OP_END(slist_stats);
+        return DS_OK;
+    }
+
+    // Traverse the list to find the node just before the specified position
+    struct slist_node* current = *head;
+    int count = 1;
+
+    while (current != NULL && count < position - 1) {
+        current = current->link;
+        DS_VISIT(slist_stats);
+        count++;
+    }
+
+    // If the position is invalid (greater than the number of nodes)
+    if (current == NULL) {
+        free(new_node); // Free memory if position is invalid
+        DS_FREE(slist_stats);
+        DS_OP_END(slist_stats);
+        return DS_BAD_POSITION;
+    }
+
+    // Insert the new node at the specified position
+    new_node->link = current->link;
+    current->link = new_node;
+    DS_OP_END(slist_stats);
+    return DS_OK;
+}
+
+
+/**
+--> Function to delete a node at the beginning
+ * @function slist_delete_beg
+ * @description
+ * This function deletes the first node of a singly linked list.
+ *
+ * The function performs the following steps:
+ * 1. Checks if the list is empty. If it is, the function returns `DS_EMPTY`.
+ * 2. If the list is not empty, it removes the head node:
+ *    - A temporary pointer is used to store the current head.
+ *    - The head pointer is updated to point to the second node in the list.
+ *    - The memory occupied by the original head node is freed.
+ *
+ * @param head: A double pointer to the head node of the linked list.
+ * @return DS_OK, or DS_EMPTY.
+ */
+int slist_delete_beg(struct slist_node **head) {
+    DS_OP_BEGIN(slist_stats);
+    if (*head == NULL) {
+        DS_OP_END(slist_stats);
+        return DS_EMPTY;
+    }
+    struct slist_node *temp = *head;
+    *head = (*head)->link;
+    free_node(temp);
+    DS_FREE(slist_stats);
+    DS_OP_END(slist_stats);
+    return DS_OK;
+}
+
+
+/**
+--> Function to delete a node at the end
+ * @function slist_delete_end
+ * @description
+ * This function deletes the last node of a singly linked list.
+ *
+ * The function performs the following steps:
+ * 1. Checks if the list is empty. If it is, the function returns `DS_EMPTY`.
+ * 2. If the list contains only one node, that node is deleted, and the head pointer is set to `NULL`.
+ * 3. For lists with more than one node:
+ *    - Traverses the list to find the second-to-last node.
+ *    - Frees the memory of the last node and sets the `link` of the second-to-last node to `NULL`.
+ *
+ * @param head: A double pointer to the head node of the linked list.
+ * @return DS_OK, or DS_EMPTY.
+ */
+int slist_delete_end(struct slist_node **head) {
+    DS_OP_BEGIN(slist_stats);
+    if (*head == NULL) {
+        DS_OP_END(slist_stats);
+        return DS_EMPTY;
+    }
+    struct slist_node *current = *head;
+    if (current->link == NULL) {
+        free_node(current);
+        DS_FREE(slist_stats);
+        *head = NULL;
+        DS_OP_END(slist_stats);
+        return DS_OK;
+    }
+    while (current->link->link != NULL) {
+        current = current->link;
+        DS_VISIT(slist_stats);
+    }
+    free_node(current->link);
+    DS_FREE(slist_stats);
+    current->link = NULL;
+    DS_OP_END(slist_stats);
+    return DS_OK;
+}
+
+/**
+--> Function to delete a specific element
+ * @function slist_delete_element
+ * @description
+ * This function deletes the first occurrence of a specific element in a singly linked list.
+ *
+ * The function performs the following steps:
+ * 1. Checks if the list is empty. If it is, the function returns `DS_EMPTY`.
+ * 2. If the element is in the head node, it updates the head pointer and frees the memory of the node.
+ * 3. For elements not at the head:
+ *    - It traverses the list to find the node with the specified element.
+ *    - If the element is not found, it returns `DS_NOT_FOUND`.
+ * 4. Deletes the node containing the specified element by adjusting the `link` of the previous node.
+ *
+ * @param head: A double pointer to the head node of the linked list.
+ * @param element: The element to delete from the list.
+ * @return DS_OK, DS_EMPTY or DS_NOT_FOUND.
+ */
+int slist_delete_element(struct slist_node **head, int element) {
+    DS_OP_BEGIN(slist_stats);
+    if (*head == NULL) {
+        DS_OP_END(slist_stats);
+        return DS_EMPTY;
+    }
+    struct slist_node *temp = *head;
+    struct slist_node *prev = NULL;
+
+    // If the element is in the head node
+    if (temp != NULL && temp->data == element) {
+        *head = temp->link;
+        free_node(temp);
+        DS_FREE(slist_stats);
+        DS_OP_END(slist_stats);
+        return DS_OK;
+    }
+
+    // Search for the element to be deleted
+    while (temp != NULL && temp->data != element) {
+        prev = temp;
+        temp = temp->link;
+        DS_VISIT(slist_stats);
+    }
+
+    // If the element was not present in the list
+    if (temp == NULL) {
+        DS_OP_END(slist_stats);
+        return DS_NOT_FOUND;
+    }
+
+    // Unlink the node from the linked list
+    prev->link = temp->link;
+    free_node(temp);
+    DS_FREE(slist_stats);
+    DS_OP_END(slist_stats);
+    return DS_OK;
+}
+
+/**
+--> Function to delete the entire linked list
+ * @function slist_delete_entire_list
+ * @description
+ * This function deletes all nodes in a singly linked list, effectively clearing the entire list.
+ *
+ * The function performs the following steps:
+ * 1. Initializes a pointer `current` to the head of the list and a `next` pointer to assist in node traversal.
+ * 2. Iterates through the list:
+ *    - For each node, it stores the pointer to the next node in `next`.
+ *    - Frees the memory occupied by the current node.
+ *    - Moves to the next node using the `next` pointer.
+ * 3. After the loop, the head pointer is set to `NULL` to indicate the list is empty.
+ *
+ * @param head: A double pointer to the head node of the linked list.
+ */
+void slist_delete_entire_list(struct slist_node **head) {
+    DS_OP_BEGIN(slist_stats);
+    struct slist_node *current = *head;
+    struct slist_node *next;
+
+    while (current != NULL) {
+        next = current->link;
+        free_node(current);
+        DS_FREE(slist_stats);
+        current = next;
+    }
+
+    *head = NULL;
+    DS_OP_END(slist_stats);
+}
+
+/**
+--> Function to reverse the linked list
+ * @function slist_arrange_list
+ * @description
+ * This function sorts a singly linked list in ascending order using the bubble sort algorithm.
+ *
+ * The function performs the following steps:
+ * 1. It checks if the list is empty or contains only one node. In these cases, the list is already "arranged" (sorted).
+ * 2. It uses two pointers, `i` and `j`, to traverse the list and compare the values of the nodes.
+ * 3. If `i->data` is greater than `j->data`, it swaps the values of the two nodes.
+ * 4. The list is repeatedly traversed to ensure that the smallest elements "bubble" to the beginning of the list.
+ *
+ * @pparam head: A pointer to the head node of the linked list.
+ */
+void slist_arrange_list(struct slist_node **head) {
+    DS_OP_BEGIN(slist_stats);
+    if (*head == NULL || (*head)->link == NULL) {
+        DS_OP_END(slist_stats);
+        return; // List is empty or has only one node
+    }
+
+    struct slist_node *i, *j;
+    int temp;
+
+    for (i = *head; i->link != NULL; i = i->link) {
+        for (j = i->link; j != NULL; j = j->link) {
+            DS_VISIT(slist_stats);
+            if (i->data > j->data) {
+                temp = i->data;
+                i->data = j->data;
+                j->data = temp;
+            }
+        }
+    }
+    DS_OP_END(slist_stats);
+}
+
+/**
+--> Function to search for an element in the list
+ * @function slist_search_list
+ * @description
+ * This function searches for a specific element (key) in a singly linked list.
+ *
+ * The function performs the following steps:
+ * 1. Initializes a pointer `current` to the head of the list and a variable `position` to track the position of the current node.
+ * 2. Iterates through the list:
+ *    - If the data in the current node matches the key, it returns the position where the element was found.
+ *    - If the data does not match, it moves to the next node and increments the position counter.
+ * 3. If the end of the list is reached without finding the key, it returns 0.
+ *
+ * @param head: A pointer to the head node of the linked list.
+ * @param key: The element to search for in the list.
+ * @return The 1-based position of the first node holding `key`, or 0 if there is none.
+ */
+int slist_search_list(struct slist_node *head, int key) {
+    DS_OP_BEGIN(slist_stats);
+    struct slist_node *current = head;
+    int position = 1;
+    while (current != NULL) {
+        if (current->data == key) {
+            DS_OP_END(slist_stats);
+            return position;
+        }
+        // One node of lookahead: the load after next is under way while next is compared
+        if (current->link != NULL) {
+            __builtin_prefetch(current->link->link);
+        }
+        current = current->link;
+        DS_VISIT(slist_stats);
+        position++;
+    }
+    DS_OP_END(slist_stats);
+    return 0;
+}
+
+/**
+--> Function to search for an element behind a filter
+ * @function slist_search_filtered
+ * @description
+ * This function asks the filter first: a value it rules out is certainly not
+ * in the list, and the scan is skipped. Otherwise the list is scanned as in
+ * slist_search_list(), and a miss is counted as a false positive of the filter.
+ *
+ * @param head: A pointer to the head node of the linked list.
+ * @param filter: A filter holding at least every value of the list.
+ * @param key: The element to search for in the list.
+ * @return The 1-based position of the first node holding `key`, or 0 if there is none.
+ */
+int slist_search_filtered(struct slist_node *head, struct ds_bloom *filter, int key) {
+    int position;
+    if (!ds_bloom_may_contain(filter, key)) {
+        return 0;
+    }
+    position = slist_search_list(head, key);
+    if (position == 0) {
+        filter->false_positives++;
+    }
+    return position;
+}
+
+/**
+--> Function to insert an element and add it to the filter
+ * @function slist_insert_filtered
+ * @description
+ * This function prepends `x` as slist_add_beg() does and adds it to the
+ * filter. A filter the list has outgrown is grown (ds_bloom_grow()) and
+ * filled again from the list.
+ *
+ * @param head: A double pointer to the head node of the linked list.
+ * @param filter: A filter holding at least every value of the list.
+ * @param x: The value to insert.
+ * @return DS_OK, or DS_NO_MEMORY (list and filter untouched).
+ */
+int slist_insert_filtered(struct slist_node **head, struct ds_bloom *filter, int x) {
+    int status = slist_add_beg(head, x);
+    if (status == DS_OK) {
+        ds_bloom_add(filter, x);
+        if (ds_bloom_grow(filter)) {
+            slist_fill_filter(*head, filter);
+        }
+    }
+    return status;
+}
+
+/**
+--> Function to delete an element and remove it from the filter
+ * @function slist_delete_filtered
+ * @description
+ * This function deletes the first node holding `element` as
+ * slist_delete_element() does, and removes the value from the filter only
+ * when a node was deleted: a value still in the list must stay in the filter.
+ *
+ * @param head: A double pointer to the head node of the linked list.
+ * @param filter: A filter holding at least every value of the list.
+ * @param element: The value to delete.
+ * @return What slist_delete_element() returns.
+ */
+int slist_delete_filtered(struct slist_node **head, struct ds_bloom *filter, int element) {
+    int status = slist_delete_element(head, element);
+    if (status == DS_OK) {
+        ds_bloom_remove(filter, element);
+    }
+    return status;
+}
+
+/**
+--> Function to rebuild a filter from the list
+ * @function slist_fill_filter
+ * @description
+ * This function empties the filter and adds the value of every node to it,
+ * dropping the stale values of deletions the filter was not told about. A
+ * filter the list has outgrown is grown (ds_bloom_grow()) and filled again.
+ *
+ * @param head: A pointer to the head node of the linked list.
+ * @param filter: The filter to rebuild.
+ */
+void slist_fill_filter(struct slist_node *head, struct ds_bloom *filter) {
+    struct slist_node *ptr;
+    do {
+        ds_bloom_reset(filter);
+        for (ptr = head; ptr != NULL; ptr = ptr->link) {
+            ds_bloom_add(filter, ptr->data);
+        }
+    } while (ds_bloom_grow(filter));
+}
+
+
+/**
+--> Function to reverse the list in place
+ * @function slist_reverse
+ * @description
+ * This function reverses a singly linked list by turning every `link`
+ * around in one pass. No node is allocated or freed and no data is copied.
+ *
+ * @param head: A double pointer to the head node of the linked list.
+ */
+void slist_reverse(struct slist_node **head) {
+    DS_OP_BEGIN(slist_stats);
+    struct slist_node *prev = NULL, *current = *head;
+    while (current != NULL) {
+        struct slist_node *next = current->link;
+        DS_VISIT(slist_stats);
+        current->link = prev;
+        prev = current;
+        current = next;
+    }
+    *head = prev;
+    DS_OP_END(slist_stats);
+}
+
+/**
+--> Function to append one list to another
+ * @function slist_concatenate
+ * @description
+ * This function moves every node of `other` to the end of `head` by linking
+ * the last node of `head` to the first node of `other`, then leaves `other`
+ * empty. Only `head` is walked.
+ *
+ * @param head: A double pointer to the head node of the list to extend.
+ * @param other: A double pointer to the head node of the list to move.
+ */
+void slist_concatenate(struct slist_node **head, struct slist_node **other) {
+    DS_OP_BEGIN(slist_stats);
+    struct slist_node **last_link = head;
+    if (head == other) {
+        DS_OP_END(slist_stats);
+        return;
+    }
+    while (*last_link != NULL) {
+        DS_VISIT(slist_stats);
+        last_link = &(*last_link)->link;
+    }
+    *last_link = *other;
+    *other = NULL;
+    DS_OP_END(slist_stats);
+}
+
+/**
+--> Function to split the list in two
+ * @function slist_split_at
+ * @description
+ * This function cuts the list in front of `position`: the nodes from
+ * `position` to the end move to `rest`, the nodes before it stay in `head`.
+ * `rest` must be an empty list, its nodes would otherwise be lost.
+ *
+ * @param head: A double pointer to the head node of the list to split.
+ * @param position: The first position that moves (1 to length + 1).
+ * @param rest: A double pointer that receives the moved nodes.
+ * @return DS_OK, or DS_BAD_POSITION.
+ */
+int slist_split_at(struct slist_node **head, int position, struct slist_node **rest) {
+    DS_OP_BEGIN(slist_stats);
+    struct slist_node **cut = head;
+    int i;
+    if (position < 1) {
+        DS_OP_END(slist_stats);
+        return DS_BAD_POSITION;
+    }
+    for (i = 1; i < position && *cut != NULL; i++) {
+        DS_VISIT(slist_stats);
+        cut = &(*cut)->link;
+    }
+    if (i < position) {
+        DS_OP_END(slist_stats);
+        return DS_BAD_POSITION;
+    }
+    *rest = *cut;
+    *cut = NULL;
+    DS_OP_END(slist_stats);
+    return DS_OK;
+}
+
+/**
+--> Function to move a range of nodes between lists
+ * @function slist_splice
+ * @description
+ * This function moves the nodes at positions `from` to `to` of `src` into
+ * `head`, so that the first of them ends up at `position`. The range is cut
+ * out and linked in with four pointer updates; nothing is allocated. Both
+ * lists are checked before anything moves, so a bad position changes nothing.
+ *
+ * @param head: A double pointer to the head node of the destination list.
+ * @param position: Where the range goes in `head` (1 to length + 1).
+ * @param src: A double pointer to the head node of the source list, not `head`.
+ * @param from: The first position of the range in `src`.
+ * @param to: The last position of the range in `src`.
+ * @return DS_OK, or DS_BAD_POSITION.
+ */
+int slist_splice(struct slist_node **head, int position, struct slist_node **src, int from, int to) {
+    DS_OP_BEGIN(slist_stats);
+    struct slist_node **first_link = src, **at = head;
+    struct slist_node *first, *last;
+    int i;
+    if (head == src || position < 1 || from < 1 || to < from) {
+        DS_OP_END(slist_stats);
+        return DS_BAD_POSITION;
+    }
+
+    // Find the link pointing at node `from`, then the last node of the range
+    for (i = 1; i < from && *first_link != NULL; i++) {
+        DS_VISIT(slist_stats);
+        first_link = &(*first_link)->link;
+    }
+    if (*first_link == NULL) {
+        DS_OP_END(slist_stats);
+        return DS_BAD_POSITION;
+    }
+    last = *first_link;
+    for (i = from; i < to && last->link != NULL; i++) {
+        DS_VISIT(slist_stats);
+        last = last->link;
+    }
+    if (i < to) {
+        DS_OP_END(slist_stats);
+        return DS_BAD_POSITION;
+    }
+
+    // Find the link the range goes behind in the destination
+    for (i = 1; i < position && *at != NULL; i++) {
+        DS_VISIT(slist_stats);
+        at = &(*at)->link;
+    }
+    if (i < position) {
+        DS_OP_END(slist_stats);
+        return DS_BAD_POSITION;
+    }
+
+    first = *first_link;
+    *first_link = last->link;
+    last->link = *at;
+    *at = first;
+    DS_OP_END(slist_stats);
+    return DS_OK;
+}
+
+/**
+--> Function to merge two sorted lists
+ * @function slist_merge_sorted
+ * @description
+ * This function merges `other` into `head`, both sorted in ascending order,
+ * by relinking their nodes in one pass; `other` is left empty. On equal
+ * values the node of `head` comes first, so the merge is stable.
+ *
+ * @param head: A double pointer to the head node of the first sorted list.
+ * @param other: A double pointer to the head node of the second sorted list.
+ */
+void slist_merge_sorted(struct slist_node **head, struct slist_node **other) {
+    DS_OP_BEGIN(slist_stats);
+    struct slist_node *a = *head, *b = *other;
+    struct slist_node **tail = head;
+    if (head == other) {
+        DS_OP_END(slist_stats);
+        return;
+    }
+    while (a != NULL && b != NULL) {
+        DS_VISIT(slist_stats);
+        if (b->data < a->data) {
+            *tail = b;
+            b = b->link;
+        } else {
+            *tail = a;
+            a = a->link;
+        }
+        tail = &(*tail)->link;
+    }
+    *tail = a != NULL ? a : b;
+    *other = NULL;
+    DS_OP_END(slist_stats);
+}
+
+/**
+--> Function to move the list into one block of nodes
+ * @function slist_compact
+ * @description
+ * After long churn the nodes of a list are scattered across the heap and a
+ * scan misses the cache on almost every node. This function counts the
+ * nodes, carves as many new ones out of a single block (see ds_slab.h),
+ * copies the values into them in list order and frees the old nodes, so a
+ * scan then sweeps the block forwards whatever the allocator does with
+ * single nodes. The new nodes are freed one by one like any other; the block
+ * goes with the last of them. The values and their order are unchanged, but
+ * every node gets a new address.
+ *
+ * @param head: A double pointer to the head node of the linked list.
+ * @return DS_OK, or DS_NO_MEMORY (list untouched) if the block cannot be allocated.
+ */
+int slist_compact(struct slist_node **head) {
+    DS_OP_BEGIN(slist_stats);
+    struct slist_node *block, *ptr, *next;
+    size_t count = 0, i;
+
+    for (ptr = *head; ptr != NULL; ptr = ptr->link) {
+        count++;
+    }
+    if (count == 0) {
+        DS_OP_END(slist_stats);
+        return DS_OK;
+    }
+    block = (struct slist_node *)ds_slab_alloc(count, sizeof(struct slist_node));
+    if (block == NULL) {
+        DS_OP_END(slist_stats);
+        return DS_NO_MEMORY;
+    }
+
+    // Nothing can fail from here on, so each old node goes as soon as it is copied
+    ptr = *head;
+    for (i = 0; i < count; i++) {
+        DS_VISIT(slist_stats);
+        DS_ALLOC(slist_stats);
+        block[i].data = ptr->data;
+        block[i].slot = (uint32_t)(i + 1);
+        block[i].link = i + 1 < count ? &block[i + 1] : NULL;
+        next = ptr->link;
+        free_node(ptr);
+        DS_FREE(slist_stats);
+        ptr = next;
+    }
+    *head = block;
+    DS_OP_END(slist_stats);
+    return DS_OK;
+}
+
+
+/**
+--> Function to delete every node matching a predicate
+ * @function slist_remove_if
+ * @description
+ * This function deletes, in a single pass, every node whose value `match`
+ * accepts. Matching nodes are unlinked onto a private chain during the walk
+ * and the whole chain is freed at the end in one tight loop, away from the
+ * list traversal.
+ *
+ * @param head: A double pointer to the head node of the linked list.
+ * @param match: Returns non-zero for the values to delete.
+ * @param ctx: An opaque pointer passed through to `match`.
+ * @return The number of nodes deleted.
+ */
+int slist_remove_if(struct slist_node **head, int (*match)(int val, void *ctx), void *ctx) {
+    DS_OP_BEGIN(slist_stats);
+    struct slist_node **link = head, *removed = NULL;
+    int count = 0;
+
+    while (*link != NULL) {
+        struct slist_node *current = *link;
+        DS_VISIT(slist_stats);
+        if (match(current->data, ctx)) {
+            *link = current->link;
+            current->link = removed;
+            removed = current;
+            count++;
+        } else {
+            link = &current->link;
+        }
+    }
+
+    while (removed != NULL) {
+        struct slist_node *next = removed->link;
+        free_node(removed);
+        DS_FREE(slist_stats);
+        removed = next;
+    }
+    DS_OP_END(slist_stats);
+    return count;
+}
+
+static int match_intset(int val, void *ctx) {
+    return ds_intset_contains((const struct ds_intset *)ctx, val);
+}
+
+/**
+--> Function to delete every occurrence of several values
+ * @function slist_remove_all
+ * @description
+ * This function deletes every node holding any of `values`. The values go
+ * into a small hash set first, so the list is walked once whatever the
+ * number of values, instead of once per value and per occurrence.
+ *
+ * @param head: A double pointer to the head node of the linked list.
+ * @param values: The values to delete.
+ * @param count: The number of values.
+ * @return The number of nodes deleted, or DS_NO_MEMORY.
+ */
+int slist_remove_all(struct slist_node **head, const int *values, int count) {
+    struct ds_intset set;
+    int removed;
+    if (ds_intset_init(&set, values, count) != DS_OK) {
+        return DS_NO_MEMORY;
+    }
+    removed = slist_remove_if(head, match_intset, &set);
+    ds_intset_free(&set);
+    return removed;
+}
+
+
+/**
+--> Binary snapshot of the list
+ * The file holds a 4-byte magic ("SLL1"), a `uint32_t` node count and then
+ * the `int32_t` values in list order, so a list can be restored with one
+ * sequential read instead of replaying `slist_add_at_end` calls.
+ */
+static const char LIST_MAGIC[4] = {'S', 'L', 'L', '1'};
+
+/**
+--> Function to save the list to a file
+ * @function slist_save
+ * @description
+ * This function writes the list to a binary snapshot file.
+ *
+ * The function performs the following steps:
+ * 1. Counts the nodes and copies their values into one contiguous buffer.
+ * 2. Writes the magic, the count and the buffer with a single `fwrite` each.
+ *
+ * @param head: A pointer to the head node of the linked list.
+ * @param path: The name of the file to write.
+ * @return 0 on success, -1 if the file could not be written.
+ */
+int slist_save(struct slist_node *head, const char *path) {
+    uint32_t count = 0, i = 0;
+    struct slist_node *ptr;
+    int32_t *values;
+    FILE *fp;
+    int status = -1;
+
+    for (ptr = head; ptr != NULL; ptr = ptr->link) {
+        count++;
+    }
+    values = (int32_t *)malloc((count ? count : 1) * sizeof(int32_t));
+    if (values == NULL) {
+        return -1;
+    }
+    for (ptr = head; ptr != NULL; ptr = ptr->link) {
+        values[i++] = ptr->data;
+    }
+
+    fp = fopen(path, "wb");
+    if (fp != NULL) {
+        if (fwrite(LIST_MAGIC, sizeof(LIST_MAGIC), 1, fp) == 1 &&
+            fwrite(&count, sizeof(count), 1, fp) == 1 &&
+            fwrite(values, sizeof(int32_t), count, fp) == count) {
+            status = 0;
+        }
+        if (fclose(fp) != 0) {
+            status = -1;
+        }
+    }
+    free(values);
+    return status;
+}
+
+/**
+--> Function to load the list from a file
+ * @function slist_load
+ * @description
+ * This function replaces the list with the content of a snapshot file.
+ *
+ * The function performs the following steps:
+ * 1. Checks the magic and reads the node count.
+ * 2. Reads every value with one `fread` into a single buffer.
+ * 3. Links the new nodes through a tail pointer, so building the list is O(n)
+ *    instead of the O(n^2) of repeated `slist_add_at_end` calls.
+ * 4. Frees the old nodes only once the new list is complete, so a failed load
+ *    leaves the list untouched.
+ *
+ * @param head: A double pointer to the head node of the linked list.
+ * @param path: The name of the file to read.
+ * @return 0 on success, -1 if the file is missing, malformed or memory ran out.
+ */
+int slist_load(struct slist_node **head, const char *path) {
+    char magic[4];
+    uint32_t count, i;
+    int32_t *values;
+    struct slist_node *new_head = NULL, *tail = NULL, *ptr;
+    FILE *fp = fopen(path, "rb");
+
+    if (fp == NULL) {
+        return -1;
+    }
+    if (fread(magic, sizeof(magic), 1, fp) != 1 || memcmp(magic, LIST_MAGIC, sizeof(magic)) != 0 ||
+        fread(&count, sizeof(count), 1, fp) != 1) {
+        fclose(fp);
+        return -1;
+    }
+    values = (int32_t *)malloc((count ? count : 1) * sizeof(int32_t));
+    if (values == NULL || fread(values, sizeof(int32_t), count, fp) != count) {
+        free(values);
+        fclose(fp);
+        return -1;
+    }
+    fclose(fp);
+
+    for (i = 0; i < count; i++) {
+        struct slist_node *new_node = (struct slist_node *)malloc(sizeof(struct slist_node));
+        if (new_node == NULL) {
+            while (new_head != NULL) {
+                ptr = new_head->link;
+                free_node(new_head);
+                DS_FREE(slist_stats);
+                new_head = ptr;
+            }
+            free(values);
+            return -1;
+        }
+        DS_ALLOC(slist_stats);
+        new_node->data = values[i];
+        new_node->slot = 0;
+        new_node->link = NULL;
+        if (tail == NULL) {
+            new_head = new_node;
+        } else {
+            tail->link = new_node;
+        }
+        tail = new_node;
+    }
+    free(values);
+
+    while (*head != NULL) {
+        ptr = (*head)->link;
+        free_node(*head);
+        DS_FREE(slist_stats);
+        *head = ptr;
+    }
+    *head = new_head;
+    return 0;
+}
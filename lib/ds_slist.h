@@ -0,0 +1,129 @@
+#ifndef DS_SLIST_H
+#define DS_SLIST_H
+
+#include <stdint.h>
+#include "ds_bloom.h"
+#include "ds_stats.h"
+#include "ds_status.h"
+
+/**
+ * @file ds_slist.h
+ * Singly linked list of integers. Every function takes the address of the
+ * head pointer (or the head itself when it only reads the list). Nothing
+ * here prints: operations return a ds_status (see ds_status.h) or a value.
+ */
+
+/**
+ --> Creating the Node of a single linked list
+ *
+ * @struct slist_node
+ * @description
+ * This structure represents a single node in a singly linked list.
+ * Each node stores:
+ * - `data`: An integer value that holds the data for the node.
+ * - `slot`: 0 for a node allocated on its own, otherwise its place in the
+ *           block slist_compact() carved it from (see ds_slab.h). Code that
+ *           mallocs a node itself must set it to 0, and only the list
+ *           functions may free a node.
+ * - `link`: A pointer to the next node in the linked list.
+ *           If the node is the last node, this pointer will be `NULL`.
+ */
+
+struct slist_node {
+    int data;
+    uint32_t slot;
+    struct slist_node *link;
+};
+
+/**
+ * Counters for the list operations, only compiled in with -DDS_INSTRUMENT
+ * (see ds_stats.h). `max_visited` is the longest walk of a single operation.
+ */
+DS_STATS_DECLARE(slist_stats);
+
+/** Returns the number of nodes in the list. */
+int slist_count_of_nodes(struct slist_node *head);
+
+/** Calls `visit` with the data of every node from head to end. */
+void slist_traverse(struct slist_node *head, void (*visit)(int val, void *ctx), void *ctx);
+
+/** Inserts a new node holding `x` at the beginning of the list, returns DS_OK or DS_NO_MEMORY. */
+int slist_add_beg(struct slist_node** head, int x);
+
+/** Inserts a new node holding `x` at the end of the list, returns DS_OK or DS_NO_MEMORY. */
+int slist_add_at_end(struct slist_node **head, int x);
+
+/** Inserts a new node holding `num` before the first node holding `val`, returns a ds_status. */
+int slist_insert_before_element(struct slist_node **head, int num, int val);
+
+/** Inserts a new node holding `x` at `position` (1-based), returns a ds_status. */
+int slist_insert_at_position(struct slist_node** head, int x, int position);
+
+/** Deletes the first node of the list, returns DS_OK or DS_EMPTY. */
+int slist_delete_beg(struct slist_node **head);
+
+/** Deletes the last node of the list, returns DS_OK or DS_EMPTY. */
+int slist_delete_end(struct slist_node **head);
+
+/** Deletes the first node holding `element`, returns DS_OK, DS_EMPTY or DS_NOT_FOUND. */
+int slist_delete_element(struct slist_node **head, int element);
+
+/** Deletes every node whose value `match` accepts in one pass, returns the number deleted. */
+int slist_remove_if(struct slist_node **head, int (*match)(int val, void *ctx), void *ctx);
+
+/** Deletes every node holding one of the `count` values in one pass, returns the number deleted or DS_NO_MEMORY. */
+int slist_remove_all(struct slist_node **head, const int *values, int count);
+
+/** Frees every node and leaves the list empty. */
+void slist_delete_entire_list(struct slist_node **head);
+
+/** Sorts the list in ascending order. */
+void slist_arrange_list(struct slist_node **head);
+
+/** Returns the 1-based position of the first node holding `key`, 0 if there is none. */
+int slist_search_list(struct slist_node *head, int key);
+
+/**
+ * Searches behind a filter: values the filter rules out are answered without
+ * scanning the list. Returns the 1-based position like slist_search_list().
+ * slist_insert_filtered() and slist_delete_filtered() keep the filter in step;
+ * after other changes, values added behind its back must be added with
+ * ds_bloom_add(), while deletions it is not told about only cost false
+ * positives until slist_fill_filter() rebuilds the filter.
+ */
+int slist_search_filtered(struct slist_node *head, struct ds_bloom *filter, int key);
+
+/** Prepends `x` like slist_add_beg() and adds it to the filter, growing and refilling a filter the list has outgrown. */
+int slist_insert_filtered(struct slist_node **head, struct ds_bloom *filter, int x);
+
+/** Deletes `element` like slist_delete_element() and removes it from the filter if it was deleted. */
+int slist_delete_filtered(struct slist_node **head, struct ds_bloom *filter, int element);
+
+/** Empties the filter and adds every value of the list to it, growing it if needed. */
+void slist_fill_filter(struct slist_node *head, struct ds_bloom *filter);
+
+/** Reverses the list in place by relinking its nodes. */
+void slist_reverse(struct slist_node **head);
+
+/** Moves every node of `other` to the end of `head`, leaving `other` empty. */
+void slist_concatenate(struct slist_node **head, struct slist_node **other);
+
+/** Moves the nodes from `position` (1 to length + 1) on to the empty list `rest`, returns DS_OK or DS_BAD_POSITION. */
+int slist_split_at(struct slist_node **head, int position, struct slist_node **rest);
+
+/** Moves positions `from`..`to` of `src` into `head` at `position`, returns DS_OK or DS_BAD_POSITION. */
+int slist_splice(struct slist_node **head, int position, struct slist_node **src, int from, int to);
+
+/** Merges the sorted list `other` into the sorted list `head` without allocating, leaving `other` empty. */
+void slist_merge_sorted(struct slist_node **head, struct slist_node **other);
+
+/** Moves the values into nodes carved in list order from one block, for faster scans; returns DS_OK or DS_NO_MEMORY. */
+int slist_compact(struct slist_node **head);
+
+/** Writes the list to a binary snapshot file, returns 0 on success. */
+int slist_save(struct slist_node *head, const char *path);
+
+/** Replaces the list with the content of a snapshot file, returns 0 on success. */
+int slist_load(struct slist_node **head, const char *path);
+
+#endif
@@ -0,0 +1,233 @@
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "ds_stack.h"
+
+DS_STATS_DEFINE(stack_stats, "stack");
+DS_STATS_DEFINE(small_stack_stats, "small_stack");
+DS_STATS_DEFINE(agg_stack_stats, "agg_stack");
+
+// Snapshot file layout: magic, element count, then the values from top to bottom
+static const char STACK_MAGIC[4] = {'S', 'T', 'K', '1'};
+
+// Function to free every node of the stack
+void stack_clear(struct stack *s) {
+    struct stack_node *ptr;
+    while (s->top != NULL) {
+        ptr = s->top;
+        s->top = ptr->next;
+        free(ptr);
+        DS_FREE(stack_stats);
+    }
+}
+
+// Function to double the capacity of a small stack; the first spill copies
+// the inline elements out, later ones realloc the heap array
+int small_stack_grow(struct small_stack *s) {
+    int *items;
+    if (s->capacity > INT_MAX / 2) {
+        return DS_NO_MEMORY;
+    }
+    if (s->capacity == SMALL_STACK_INLINE) {
+        items = (int *)malloc(2 * SMALL_STACK_INLINE * sizeof(int));
+        if (items == NULL) {
+            return DS_NO_MEMORY;
+        }
+        memcpy(items, s->buf.items, sizeof(s->buf.items));
+    } else {
+        items = (int *)realloc(s->buf.heap, 2 * (size_t)s->capacity * sizeof(int));
+        if (items == NULL) {
+            return DS_NO_MEMORY;
+        }
+        DS_FREE(small_stack_stats);
+    }
+    DS_ALLOC(small_stack_stats);
+    s->buf.heap = items;
+    s->capacity *= 2;
+    return DS_OK;
+}
+
+// Function to empty the small stack, freeing the heap array if it spilled
+void small_stack_clear(struct small_stack *s) {
+    if (s->capacity != SMALL_STACK_INLINE) {
+        free(s->buf.heap);
+        DS_FREE(small_stack_stats);
+    }
+    small_stack_init(s);
+}
+
+#define AGG_STACK_INITIAL 16
+
+// Function to double the capacity of an aggregate stack, starting at AGG_STACK_INITIAL levels
+// The limit is checked before doubling, so the int capacity never overflows
+int agg_stack_grow(struct agg_stack *s) {
+    struct agg_level *levels;
+    int capacity;
+    if (s->capacity > INT_MAX / 2) {
+        return DS_NO_MEMORY;
+    }
+    capacity = s->capacity == 0 ? AGG_STACK_INITIAL : 2 * s->capacity;
+    levels = (struct agg_level *)realloc(s->levels, (size_t)capacity * sizeof(struct agg_level));
+    if (levels == NULL) {
+        return DS_NO_MEMORY;
+    }
+    if (s->levels != NULL) {
+        DS_FREE(agg_stack_stats);
+    }
+    DS_ALLOC(agg_stack_stats);
+    s->levels = levels;
+    s->capacity = capacity;
+    return DS_OK;
+}
+
+// Function to empty the aggregate stack and free its array
+void agg_stack_clear(struct agg_stack *s) {
+    if (s->levels != NULL) {
+        free(s->levels);
+        DS_FREE(agg_stack_stats);
+    }
+    agg_stack_init(s);
+}
+
+// Function to write count values, top first, to a snapshot file, returns 0 on success
+static int write_snapshot(const char *path, const int32_t *values, uint32_t count) {
+    FILE *fp = fopen(path, "wb");
+    int status = -1;
+    if (fp != NULL) {
+        if (fwrite(STACK_MAGIC, sizeof(STACK_MAGIC), 1, fp) == 1 &&
+            fwrite(&count, sizeof(count), 1, fp) == 1 &&
+            fwrite(values, sizeof(int32_t), count, fp) == count) {
+            status = 0;
+        }
+        if (fclose(fp) != 0) {
+            status = -1;
+        }
+    }
+    return status;
+}
+
+// Function to read a snapshot file into a new array of *count values, top first, returns it or NULL
+static int32_t *read_snapshot(const char *path, uint32_t *count) {
+    char magic[4];
+    int32_t *values;
+    FILE *fp = fopen(path, "rb");
+
+    if (fp == NULL) {
+        return NULL;
+    }
+    if (fread(magic, sizeof(magic), 1, fp) != 1 || memcmp(magic, STACK_MAGIC, sizeof(magic)) != 0 ||
+        fread(count, sizeof(*count), 1, fp) != 1) {
+        fclose(fp);
+        return NULL;
+    }
+
+    // One sequential read of the whole value array
+    values = (int32_t *)malloc((*count ? *count : 1) * sizeof(int32_t));
+    if (values == NULL || fread(values, sizeof(int32_t), *count, fp) != *count) {
+        free(values);
+        fclose(fp);
+        return NULL;
+    }
+    fclose(fp);
+    return values;
+}
+
+// Function to write the stack to a binary snapshot file, returns 0 on success
+int stack_save(const struct stack *s, const char *path) {
+    struct stack_node *ptr;
+    uint32_t count = 0, i = 0;
+    int32_t *values;
+    int status;
+
+    for (ptr = s->top; ptr != NULL; ptr = ptr->next) {
+        count++;
+    }
+    values = (int32_t *)malloc((count ? count : 1) * sizeof(int32_t));
+    if (values == NULL) {
+        return -1;
+    }
+    for (ptr = s->top; ptr != NULL; ptr = ptr->next) {
+        values[i++] = ptr->data;
+    }
+    status = write_snapshot(path, values, count);
+    free(values);
+    return status;
+}
+
+// Function to replace the stack with the content of a snapshot file, returns 0 on success
+int stack_load(struct stack *s, const char *path) {
+    uint32_t count, i;
+    int32_t *values = read_snapshot(path, &count);
+    struct stack_node *nodes;
+
+    if (values == NULL) {
+        return -1;
+    }
+
+    // Nodes are still allocated one by one because stack_pop() frees them individually
+    nodes = NULL;
+    for (i = count; i > 0; i--) {
+        struct stack_node *ptr = (struct stack_node *)malloc(sizeof(struct stack_node));
+        if (ptr == NULL) {
+            while (nodes != NULL) {
+                ptr = nodes;
+                nodes = nodes->next;
+                free(ptr);
+                DS_FREE(stack_stats);
+            }
+            free(values);
+            return -1;
+        }
+        DS_ALLOC(stack_stats);
+        ptr->data = values[i - 1];
+        ptr->next = nodes;
+        nodes = ptr;
+    }
+    free(values);
+
+    stack_clear(s);
+    s->top = nodes;
+    return 0;
+}
+
+// Function to write the aggregate stack to a snapshot file in the same format, returns 0 on success
+int agg_stack_save(const struct agg_stack *s, const char *path) {
+    int32_t *values = (int32_t *)malloc((s->count ? (size_t)s->count : 1) * sizeof(int32_t));
+    int i, status;
+    if (values == NULL) {
+        return -1;
+    }
+    for (i = 0; i < s->count; i++) {
+        values[i] = s->levels[s->count - 1 - i].data;
+    }
+    status = write_snapshot(path, values, (uint32_t)s->count);
+    free(values);
+    return status;
+}
+
+// Function to replace the aggregate stack with the content of a snapshot file,
+// pushing from the bottom so every level gets its aggregates, returns 0 on success
+int agg_stack_load(struct agg_stack *s, const char *path) {
+    struct agg_stack loaded;
+    uint32_t count, i;
+    int32_t *values = read_snapshot(path, &count);
+
+    if (values == NULL) {
+        return -1;
+    }
+    agg_stack_init(&loaded);
+    for (i = count; i > 0; i--) {
+        if (agg_stack_push(&loaded, values[i - 1]) != DS_OK) {
+            agg_stack_clear(&loaded);
+            free(values);
+            return -1;
+        }
+    }
+    free(values);
+
+    agg_stack_clear(s);
+    *s = loaded;
+    return 0;
+}
@@ -0,0 +1,286 @@
+#ifndef DS_STACK_H
+#define DS_STACK_H
+
+#include <stdlib.h>
+#include "ds_stats.h"
+#include "ds_status.h"
+
+// Define the stack structure
+struct stack_node {
+    int data;
+    struct stack_node *next;
+};
+
+// A stack is a handle on its top node, so several stacks can coexist
+struct stack {
+    struct stack_node *top;
+};
+
+// Counters, only compiled in with -DDS_INSTRUMENT
+DS_STATS_DECLARE(stack_stats);
+
+// Function to initialize an empty stack
+static inline void stack_init(struct stack *s) {
+    s->top = NULL;
+}
+
+// push, pop and peek live in the header so callers can inline them; they never
+// print, the caller reports the returned status
+
+// Function to push an element onto the stack, returns DS_OK or DS_NO_MEMORY
+static inline int stack_push(struct stack *s, int val) {
+    struct stack_node *ptr;
+    DS_OP_BEGIN(stack_stats);
+    ptr = (struct stack_node *)malloc(sizeof(struct stack_node));
+    if (ptr == NULL) {
+        DS_OP_END(stack_stats);
+        return DS_NO_MEMORY;
+    }
+    DS_ALLOC(stack_stats);
+    ptr->data = val;
+    ptr->next = s->top;
+    s->top = ptr;
+    DS_OP_END(stack_stats);
+    return DS_OK;
+}
+
+// Function to pop an element from the stack into *val (may be NULL), returns DS_OK or DS_EMPTY
+static inline int stack_pop(struct stack *s, int *val) {
+    struct stack_node *ptr;
+    DS_OP_BEGIN(stack_stats);
+    if (s->top == NULL) {
+        DS_OP_END(stack_stats);
+        return DS_EMPTY;
+    }
+    ptr = s->top;
+    DS_VISIT(stack_stats);
+    if (val != NULL) {
+        *val = ptr->data;
+    }
+    s->top = ptr->next;
+    free(ptr);
+    DS_FREE(stack_stats);
+    DS_OP_END(stack_stats);
+    return DS_OK;
+}
+
+// Function to read the top element of the stack into *val, returns DS_OK or DS_EMPTY
+static inline int stack_peek(const struct stack *s, int *val) {
+    if (s->top == NULL) {
+        return DS_EMPTY;
+    }
+    DS_VISIT(stack_stats);
+    *val = s->top->data;
+    return DS_OK;
+}
+
+// Function to check whether the stack is empty
+static inline int stack_is_empty(const struct stack *s) {
+    return s->top == NULL;
+}
+
+// Function to free every node of the stack
+void stack_clear(struct stack *s);
+
+// Small stack: an array stack whose first SMALL_STACK_INLINE elements live in
+// the handle itself. A short-lived stack that stays that small never calls
+// malloc; past that the elements move to a heap array that doubles as needed.
+// The handle holds no pointer into itself, so it may be copied or moved.
+#define SMALL_STACK_INLINE 16
+
+struct small_stack {
+    int count;
+    int capacity;   // SMALL_STACK_INLINE while the elements are inline
+    union {
+        int items[SMALL_STACK_INLINE];
+        int *heap;
+    } buf;
+};
+
+// Counters, only compiled in with -DDS_INSTRUMENT; allocations count heap spills
+DS_STATS_DECLARE(small_stack_stats);
+
+// Function to initialize an empty small stack, no allocation
+static inline void small_stack_init(struct small_stack *s) {
+    s->count = 0;
+    s->capacity = SMALL_STACK_INLINE;
+}
+
+// Function to get the element array, inline or on the heap
+static inline int *small_stack_items(struct small_stack *s) {
+    return s->capacity == SMALL_STACK_INLINE ? s->buf.items : s->buf.heap;
+}
+
+// Function to double the capacity, moving the elements to the heap, returns DS_OK or DS_NO_MEMORY
+int small_stack_grow(struct small_stack *s);
+
+// Function to push an element onto the small stack, returns DS_OK or DS_NO_MEMORY
+static inline int small_stack_push(struct small_stack *s, int val) {
+    DS_OP_BEGIN(small_stack_stats);
+    if (s->count == s->capacity && small_stack_grow(s) != DS_OK) {
+        DS_OP_END(small_stack_stats);
+        return DS_NO_MEMORY;
+    }
+    small_stack_items(s)[s->count++] = val;
+    DS_OP_END(small_stack_stats);
+    return DS_OK;
+}
+
+// Function to pop an element from the small stack into *val (may be NULL), returns DS_OK or DS_EMPTY
+static inline int small_stack_pop(struct small_stack *s, int *val) {
+    DS_OP_BEGIN(small_stack_stats);
+    if (s->count == 0) {
+        DS_OP_END(small_stack_stats);
+        return DS_EMPTY;
+    }
+    s->count--;
+    DS_VISIT(small_stack_stats);
+    if (val != NULL) {
+        *val = small_stack_items(s)[s->count];
+    }
+    DS_OP_END(small_stack_stats);
+    return DS_OK;
+}
+
+// Function to read the top element of the small stack into *val, returns DS_OK or DS_EMPTY
+static inline int small_stack_peek(struct small_stack *s, int *val) {
+    if (s->count == 0) {
+        return DS_EMPTY;
+    }
+    DS_VISIT(small_stack_stats);
+    *val = small_stack_items(s)[s->count - 1];
+    return DS_OK;
+}
+
+// Function to check whether the small stack is empty
+static inline int small_stack_is_empty(const struct small_stack *s) {
+    return s->count == 0;
+}
+
+// Function to empty the small stack, freeing the heap array if it spilled
+void small_stack_clear(struct small_stack *s);
+
+// Aggregate stack: an array stack whose every level also holds the minimum,
+// maximum and sum of the elements from the bottom up to it. A push computes
+// its level from the one below and a pop just drops the top level, so the
+// min, max and sum of the whole stack are read from the top in O(1) after
+// any push or pop.
+struct agg_level {
+    long long sum;  // of the elements up to this level
+    int data;
+    int min;        // of the elements up to this level
+    int max;
+};
+
+struct agg_stack {
+    int count;
+    int capacity;
+    struct agg_level *levels;
+};
+
+// Counters, only compiled in with -DDS_INSTRUMENT
+DS_STATS_DECLARE(agg_stack_stats);
+
+// Function to initialize an empty aggregate stack, no allocation
+static inline void agg_stack_init(struct agg_stack *s) {
+    s->count = 0;
+    s->capacity = 0;
+    s->levels = NULL;
+}
+
+// Function to double the capacity, returns DS_OK or DS_NO_MEMORY
+int agg_stack_grow(struct agg_stack *s);
+
+// Function to push an element onto the aggregate stack, returns DS_OK or DS_NO_MEMORY
+static inline int agg_stack_push(struct agg_stack *s, int val) {
+    struct agg_level *level;
+    DS_OP_BEGIN(agg_stack_stats);
+    if (s->count == s->capacity && agg_stack_grow(s) != DS_OK) {
+        DS_OP_END(agg_stack_stats);
+        return DS_NO_MEMORY;
+    }
+    level = &s->levels[s->count];
+    level->data = val;
+    if (s->count == 0) {
+        level->min = val;
+        level->max = val;
+        level->sum = val;
+    } else {
+        level->min = val < level[-1].min ? val : level[-1].min;
+        level->max = val > level[-1].max ? val : level[-1].max;
+        level->sum = level[-1].sum + val;
+    }
+    s->count++;
+    DS_OP_END(agg_stack_stats);
+    return DS_OK;
+}
+
+// Function to pop an element from the aggregate stack into *val (may be NULL), returns DS_OK or DS_EMPTY
+static inline int agg_stack_pop(struct agg_stack *s, int *val) {
+    DS_OP_BEGIN(agg_stack_stats);
+    if (s->count == 0) {
+        DS_OP_END(agg_stack_stats);
+        return DS_EMPTY;
+    }
+    s->count--;
+    DS_VISIT(agg_stack_stats);
+    if (val != NULL) {
+        *val = s->levels[s->count].data;
+    }
+    DS_OP_END(agg_stack_stats);
+    return DS_OK;
+}
+
+// Function to read the top element of the aggregate stack into *val, returns DS_OK or DS_EMPTY
+static inline int agg_stack_peek(const struct agg_stack *s, int *val) {
+    if (s->count == 0) {
+        return DS_EMPTY;
+    }
+    *val = s->levels[s->count - 1].data;
+    return DS_OK;
+}
+
+// Function to read the smallest element on the stack into *val, returns DS_OK or DS_EMPTY
+static inline int agg_stack_min(const struct agg_stack *s, int *val) {
+    if (s->count == 0) {
+        return DS_EMPTY;
+    }
+    *val = s->levels[s->count - 1].min;
+    return DS_OK;
+}
+
+// Function to read the largest element on the stack into *val, returns DS_OK or DS_EMPTY
+static inline int agg_stack_max(const struct agg_stack *s, int *val) {
+    if (s->count == 0) {
+        return DS_EMPTY;
+    }
+    *val = s->levels[s->count - 1].max;
+    return DS_OK;
+}
+
+// Function to get the sum of the elements on the stack, 0 when it is empty
+static inline long long agg_stack_sum(const struct agg_stack *s) {
+    return s->count == 0 ? 0 : s->levels[s->count - 1].sum;
+}
+
+// Function to check whether the aggregate stack is empty
+static inline int agg_stack_is_empty(const struct agg_stack *s) {
+    return s->count == 0;
+}
+
+// Function to empty the aggregate stack and free its array
+void agg_stack_clear(struct agg_stack *s);
+
+// Function to write the stack to a binary snapshot file, returns 0 on success
+int stack_save(const struct stack *s, const char *path);
+
+// Function to replace the stack with the content of a snapshot file, returns 0 on success
+int stack_load(struct stack *s, const char *path);
+
+// Function to write the aggregate stack to a snapshot file in the same format, returns 0 on success
+int agg_stack_save(const struct agg_stack *s, const char *path);
+
+// Function to replace the aggregate stack with the content of a snapshot file, returns 0 on success
+int agg_stack_load(struct agg_stack *s, const char *path);
+
+#endif
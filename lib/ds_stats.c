@@ -0,0 +1,37 @@
+#include "ds_stats.h"
+
+#ifdef DS_INSTRUMENT
+
+#include <stdio.h>
+
+static ds_stats_hook ds_hook_fn;
+static void* ds_hook_ctx;
+
+void ds_stats_set_hook(ds_stats_hook fn, void* ctx) {
+    ds_hook_fn = fn;
+    ds_hook_ctx = ctx;
+}
+
+void ds_stats_export(const struct ds_stats* s) {
+    int b;
+    if (ds_hook_fn != NULL) {
+        ds_hook_fn(s, ds_hook_ctx);
+        return;
+    }
+    fprintf(stderr, "[%s] ops=%llu visited=%llu allocs=%llu frees=%llu max_visited=%llu max_live=%llu\n",
+            s->name, (unsigned long long)s->operations, (unsigned long long)s->nodes_visited,
+            (unsigned long long)s->allocations, (unsigned long long)s->frees,
+            (unsigned long long)s->max_visited, (unsigned long long)s->max_live);
+    for (b = 0; b < DS_LATENCY_BUCKETS; b++) {
+        if (s->latency[b] != 0) {
+            fprintf(stderr, "[%s]   %10llu ns+ : %llu\n", s->name, 1ULL << b, (unsigned long long)s->latency[b]);
+        }
+    }
+}
+
+#else
+
+// Nothing to compile without DS_INSTRUMENT; keeps the translation unit non-empty
+typedef int ds_stats_disabled;
+
+#endif
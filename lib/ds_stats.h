@@ -0,0 +1,94 @@
+#ifndef DS_STATS_H
+#define DS_STATS_H
+
+// Optional hot-path instrumentation, compiled in with -DDS_INSTRUMENT.
+// Each structure owns one struct ds_stats; the DS_* macros below update it and
+// expand to nothing when DS_INSTRUMENT is not defined, so the release build
+// carries no counters, no clock reads and no branches.
+//
+//   DS_STATS_DECLARE(s)        in a header: makes the counters visible
+//   DS_STATS_DEFINE(s, label)  in exactly one .c file: the counters themselves
+//   DS_OP_BEGIN(s)             start of an operation: counts it and starts its timer
+//   DS_OP_END(s)               end of the operation: latency histogram and max visited
+//   DS_VISIT(s)                one node touched by the current operation
+//   DS_ALLOC(s)                one malloc() of a node, also tracks the largest size reached
+//   DS_FREE(s)                 one free() of a node
+//   DS_EXPORT(s)               hand the counters to the export hook (stderr by default)
+
+#ifdef DS_INSTRUMENT
+
+#include <stdint.h>
+#include <time.h>
+
+// Latency histogram bucket b counts operations that took [2^b, 2^(b+1)) ns
+#define DS_LATENCY_BUCKETS 32
+
+struct ds_stats {
+    const char* name;
+    uint64_t operations;
+    uint64_t nodes_visited;
+    uint64_t allocations;
+    uint64_t frees;
+    uint64_t max_visited;   // deepest search / longest walk of a single operation
+    uint64_t max_live;      // most nodes allocated at once (allocations - frees)
+    uint64_t latency[DS_LATENCY_BUCKETS];
+};
+
+typedef void (*ds_stats_hook)(const struct ds_stats* stats, void* ctx);
+
+// Install the callback that receives the counters, NULL restores the stderr dump
+void ds_stats_set_hook(ds_stats_hook fn, void* ctx);
+
+// Hand the counters to the hook
+void ds_stats_export(const struct ds_stats* s);
+
+static inline uint64_t ds_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static inline void ds_stats_end(struct ds_stats* s, uint64_t t0, uint64_t visited0) {
+    uint64_t ns = ds_now_ns() - t0;
+    uint64_t visited = s->nodes_visited - visited0;
+    int bucket = 0;
+    while (ns > 1 && bucket < DS_LATENCY_BUCKETS - 1) {
+        ns >>= 1;
+        bucket++;
+    }
+    s->latency[bucket]++;
+    if (visited > s->max_visited) {
+        s->max_visited = visited;
+    }
+}
+
+static inline void ds_stats_alloc(struct ds_stats* s) {
+    s->allocations++;
+    if (s->allocations - s->frees > s->max_live) {
+        s->max_live = s->allocations - s->frees;
+    }
+}
+
+#define DS_STATS_DECLARE(var) extern struct ds_stats var
+#define DS_STATS_DEFINE(var, label) struct ds_stats var = {label, 0, 0, 0, 0, 0, 0, {0}}
+#define DS_OP_BEGIN(s) uint64_t ds_t0_ = ds_now_ns(), ds_v0_ = ((s).operations++, (s).nodes_visited)
+#define DS_OP_END(s) ds_stats_end(&(s), ds_t0_, ds_v0_)
+#define DS_VISIT(s) ((s).nodes_visited++)
+#define DS_ALLOC(s) ds_stats_alloc(&(s))
+#define DS_FREE(s) ((s).frees++)
+#define DS_EXPORT(s) ds_stats_export(&(s))
+
+#else
+
+#define DS_STATS_DECLARE(var) struct ds_stats
+#define DS_STATS_DEFINE(var, label) struct ds_stats
+#define DS_OP_BEGIN(s) ((void)0)
+#define DS_OP_END(s) ((void)0)
+#define DS_VISIT(s) ((void)0)
+#define DS_ALLOC(s) ((void)0)
+#define DS_FREE(s) ((void)0)
+#define DS_EXPORT(s) ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef DS_STATUS_H
+#define DS_STATUS_H
+
+// Status codes returned by the structure operations. The operations never
+// print: they report what happened and the menus turn it into a message.
+// Success is 0 and every failure is negative, so "if (op(...) != DS_OK)" works
+// everywhere; the file operations only use DS_OK and -1.
+enum ds_status {
+    DS_OK = 0,
+    DS_EMPTY = -1,        // the structure holds no element
+    DS_NOT_FOUND = -2,    // no node holds the requested value
+    DS_BAD_POSITION = -3, // the position is outside the structure
+    DS_NO_MEMORY = -4,    // malloc failed, the structure is unchanged
+    DS_EXISTS = -5        // the value is already in a structure that holds each value once
+};
+
+#endif
@@ -0,0 +1,534 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "ds_tree.h"
+
+DS_STATS_DEFINE(tree_stats, "tree");
+
+// Traversals hand every value to visit() instead of printing it
+
+// Preorder traversal function NLR
+void tree_preorder(struct tree_node* root, void (*visit)(int val, void* ctx), void* ctx) {
+    if (root != NULL) {
+        visit(root->data, ctx);                     // Visit the root
+        tree_preorder(root->left, visit, ctx);      // Traverse the left subtree
+        tree_preorder(root->right, visit, ctx);     // Traverse the right subtree
+    }
+}
+
+// Inorder traversal function LNR
+void tree_inorder(struct tree_node* root, void (*visit)(int val, void* ctx), void* ctx) {
+    if (root != NULL) {
+        tree_inorder(root->left, visit, ctx);       // Traverse the left subtree
+        visit(root->data, ctx);                     // Visit the root
+        tree_inorder(root->right, visit, ctx);      // Traverse the right subtree
+    }
+}
+
+// Postorder traversal function LRN
+void tree_postorder(struct tree_node* root, void (*visit)(int val, void* ctx), void* ctx) {
+    if (root != NULL) {
+        tree_postorder(root->left, visit, ctx);     // Traverse the left subtree
+        tree_postorder(root->right, visit, ctx);    // Traverse the right subtree
+        visit(root->data, ctx);                     // Visit the root
+    }
+}
+
+// Function to search for a value in a binary search tree, returns 1 if found
+// Written as a loop so every level can be counted as one visited node
+int tree_search(struct tree_node* root, int val) {
+    DS_OP_BEGIN(tree_stats);
+    while (root != NULL && root->data != val) {
+        DS_VISIT(tree_stats);
+        if (val < root->data) {
+            root = root->left;  // Continue searching in the left subtree
+        } else {
+            root = root->right;  // Continue searching in the right subtree
+        }
+    }
+    if (root != NULL) {
+        DS_VISIT(tree_stats);
+    }
+    DS_OP_END(tree_stats);
+    return root != NULL;
+}
+
+// Searches in flight at once in tree_search_batch(): enough that the node a
+// search moves to has arrived by the time its turn comes again
+#define TREE_BATCH_GROUP 16
+
+// Function to search for many values, interleaved: each search in the group
+// takes one step down and prefetches the node it moves to, then the next
+// search in the group gets a turn. A search that ends hands its slot to the
+// next key, so the group stays full until the keys run out
+long tree_search_batch(struct tree_node* root, const int* keys, long count, uint8_t* found) {
+    struct tree_node* node[TREE_BATCH_GROUP];
+    long key_of[TREE_BATCH_GROUP];
+    long next = 0, hits = 0;
+    int slot, active = 0;
+    DS_OP_BEGIN(tree_stats);
+    for (slot = 0; slot < TREE_BATCH_GROUP; slot++) {
+        if (next < count) {
+            node[slot] = root;
+            key_of[slot] = next++;
+            active++;
+        } else {
+            key_of[slot] = -1;  // Fewer keys than slots: this one stays empty
+        }
+    }
+    while (active > 0) {
+        for (slot = 0; slot < TREE_BATCH_GROUP; slot++) {
+            struct tree_node* cur = node[slot];
+            int val;
+            if (key_of[slot] < 0) {
+                continue;
+            }
+            val = keys[key_of[slot]];
+            if (cur != NULL) {
+                DS_VISIT(tree_stats);
+                if (cur->data != val) {
+                    cur = val < cur->data ? cur->left : cur->right;
+                    __builtin_prefetch(cur);
+                    node[slot] = cur;
+                    continue;
+                }
+            }
+            // This search has ended: record it and start the next key here
+            found[key_of[slot]] = cur != NULL;
+            hits += cur != NULL;
+            if (next < count) {
+                node[slot] = root;
+                key_of[slot] = next++;
+            } else {
+                key_of[slot] = -1;
+                active--;
+            }
+        }
+    }
+    DS_OP_END(tree_stats);
+    return hits;
+}
+
+// Chunks hold their nodes right after the header; the first one holds
+// TREE_CHUNK_FIRST nodes and each new one twice as many as the last
+#define TREE_CHUNK_FIRST 64
+
+struct tree_chunk {
+    struct tree_chunk* next;
+    size_t count;
+    struct tree_node nodes[];
+};
+
+// Function to add a chunk of count nodes to the arena, returns DS_OK or DS_NO_MEMORY
+static int arena_grow(struct tree_arena* arena, size_t count) {
+    struct tree_chunk* chunk;
+    if (count > (SIZE_MAX - sizeof(struct tree_chunk)) / sizeof(struct tree_node)) {
+        return DS_NO_MEMORY;
+    }
+    chunk = (struct tree_chunk*)malloc(sizeof(struct tree_chunk) + count * sizeof(struct tree_node));
+    if (chunk == NULL) {
+        return DS_NO_MEMORY;
+    }
+    DS_ALLOC(tree_stats);
+    // A chunk loaded into an arena in use may leave nodes of the previous
+    // one unused; they go on the free list instead of being abandoned
+    while (arena->left > 0) {
+        struct tree_node* node = &arena->chunks->nodes[arena->chunks->count - arena->left--];
+        node->right = arena->free_list;
+        arena->free_list = node;
+    }
+    chunk->next = arena->chunks;
+    chunk->count = count;
+    arena->chunks = chunk;
+    arena->left = count;
+    return DS_OK;
+}
+
+// Function to get a node: a recycled one, the next one of the newest chunk,
+// or one from malloc when arena is NULL; returns NULL when out of memory
+static struct tree_node* node_alloc(struct tree_arena* arena) {
+    struct tree_node* node;
+    if (arena == NULL) {
+        node = (struct tree_node*)malloc(sizeof(struct tree_node));
+        if (node != NULL) {
+            DS_ALLOC(tree_stats);
+        }
+        return node;
+    }
+    if (arena->free_list != NULL) {
+        node = arena->free_list;
+        arena->free_list = node->right;
+        return node;
+    }
+    if (arena->left == 0 &&
+        arena_grow(arena, arena->chunks != NULL ? 2 * arena->chunks->count : TREE_CHUNK_FIRST) != DS_OK) {
+        return NULL;
+    }
+    return &arena->chunks->nodes[arena->chunks->count - arena->left--];
+}
+
+// Function to give a node back to the arena, or to free() when arena is NULL
+static void node_release(struct tree_arena* arena, struct tree_node* node) {
+    if (arena == NULL) {
+        free(node);
+        DS_FREE(tree_stats);
+    } else {
+        node->right = arena->free_list;
+        arena->free_list = node;
+    }
+}
+
+void tree_arena_destroy(struct tree_arena* arena) {
+    while (arena->chunks != NULL) {
+        struct tree_chunk* next = arena->chunks->next;
+        free(arena->chunks);
+        DS_FREE(tree_stats);
+        arena->chunks = next;
+    }
+    tree_arena_init(arena);
+}
+
+// Function to insert a value in a binary search tree
+static struct tree_node* insert(struct tree_node* root, struct tree_arena* arena, int val) {
+    struct tree_node** link = &root;
+    DS_OP_BEGIN(tree_stats);
+    while (*link != NULL) {
+        DS_VISIT(tree_stats);
+        if (val < (*link)->data) {
+            link = &(*link)->left;  // Descend into the left subtree
+        } else {
+            link = &(*link)->right;  // Descend into the right subtree
+        }
+    }
+    *link = node_alloc(arena);
+    if (*link == NULL) {
+        DS_OP_END(tree_stats);
+        return root;  // Out of memory: the tree is left unchanged
+    }
+    (*link)->data = val;
+    (*link)->left = NULL;
+    (*link)->right = NULL;
+    DS_OP_END(tree_stats);
+    return root;
+}
+
+struct tree_node* tree_insert(struct tree_node* root, int val) {
+    return insert(root, NULL, val);
+}
+
+struct tree_node* tree_arena_insert(struct tree_node* root, struct tree_arena* arena, int val) {
+    return insert(root, arena, val);
+}
+
+// Function to delete one occurrence of a value
+// The successor is the leftmost node of the right subtree: the smallest value
+// that is >= val, so moving it up keeps every smaller value on the left and
+// every value >= it on the right, duplicates included
+int tree_delete(struct tree_node** root, struct tree_arena* arena, int val) {
+    struct tree_node** link = root;
+    struct tree_node* node;
+    DS_OP_BEGIN(tree_stats);
+    while (*link != NULL && (*link)->data != val) {
+        DS_VISIT(tree_stats);
+        if (val < (*link)->data) {
+            link = &(*link)->left;
+        } else {
+            link = &(*link)->right;
+        }
+    }
+    if (*link == NULL) {
+        DS_OP_END(tree_stats);
+        return DS_NOT_FOUND;
+    }
+    node = *link;
+    DS_VISIT(tree_stats);
+    if (node->left != NULL && node->right != NULL) {
+        link = &node->right;
+        while ((*link)->left != NULL) {
+            DS_VISIT(tree_stats);
+            link = &(*link)->left;
+        }
+        node->data = (*link)->data;
+        node = *link;
+        *link = node->right;  // The successor has no left child
+    } else {
+        *link = node->left != NULL ? node->left : node->right;
+    }
+    node_release(arena, node);
+    DS_OP_END(tree_stats);
+    return DS_OK;
+}
+
+// Function to free every node of a tree built with tree_insert()
+// A node with a left child is rotated right until the root has none, then
+// the root is freed and its right subtree is next, so no stack is needed
+void tree_free(struct tree_node* root) {
+    while (root != NULL) {
+        if (root->left != NULL) {
+            struct tree_node* left = root->left;
+            root->left = left->right;
+            left->right = root;
+            root = left;
+        } else {
+            struct tree_node* right = root->right;
+            free(root);
+            DS_FREE(tree_stats);
+            root = right;
+        }
+    }
+}
+
+// Snapshot file layout: magic, node count, then the values in preorder (NLR)
+static const char TREE_MAGIC[4] = {'B', 'S', 'T', '1'};
+
+// Function to search behind a filter, returns 1 if found
+int tree_search_filtered(struct tree_node* root, struct ds_bloom* filter, int val) {
+    if (!ds_bloom_may_contain(filter, val)) {
+        return 0;
+    }
+    if (tree_search(root, val)) {
+        return 1;
+    }
+    filter->false_positives++;
+    return 0;
+}
+
+// Morris traversal: threads through empty right links instead of a stack, so
+// a degenerate tree needs no deep recursion, and every link is restored
+static void fill_filter(struct tree_node* root, struct ds_bloom* filter) {
+    ds_bloom_reset(filter);
+    while (root != NULL) {
+        if (root->left == NULL) {
+            ds_bloom_add(filter, root->data);
+            root = root->right;
+        } else {
+            struct tree_node* pred = root->left;
+            while (pred->right != NULL && pred->right != root) {
+                pred = pred->right;
+            }
+            if (pred->right == NULL) {
+                pred->right = root;       // Thread back to root, then go left
+                root = root->left;
+            } else {
+                pred->right = NULL;       // Left subtree done, remove the thread
+                ds_bloom_add(filter, root->data);
+                root = root->right;
+            }
+        }
+    }
+}
+
+// Function to insert a value and add it to the filter
+// If the insert drops the value the filter only gains a false positive
+struct tree_node* tree_insert_filtered(struct tree_node* root, struct tree_arena* arena, struct ds_bloom* filter, int val) {
+    root = insert(root, arena, val);
+    ds_bloom_add(filter, val);
+    if (ds_bloom_grow(filter)) {
+        fill_filter(root, filter);
+    }
+    return root;
+}
+
+// Function to empty the filter and add every value of the tree to it
+void tree_fill_filter(struct tree_node* root, struct ds_bloom* filter) {
+    fill_filter(root, filter);
+    if (ds_bloom_grow(filter)) {
+        fill_filter(root, filter);
+    }
+}
+
+// Function to count the nodes of a tree
+// Morris traversal: a node's predecessor temporarily links back to it instead
+// of the node being kept on a stack, so degenerate trees do not exhaust the
+// call stack and no memory is allocated; every link is restored on the way
+uint32_t tree_count_nodes(struct tree_node* root) {
+    struct tree_node* node = root;
+    struct tree_node* pred;
+    uint32_t count = 0;
+
+    while (node != NULL) {
+        if (node->left == NULL) {
+            count++;
+            node = node->right;
+            continue;
+        }
+        pred = node->left;
+        while (pred->right != NULL && pred->right != node) {
+            pred = pred->right;
+        }
+        if (pred->right == NULL) {
+            pred->right = node;     // Thread back to node, then go down the left subtree
+            node = node->left;
+        } else {
+            pred->right = NULL;     // Left subtree done, remove the thread
+            count++;
+            node = node->right;
+        }
+    }
+    return count;
+}
+
+// Function to write the tree to a binary snapshot file in preorder, returns 0 on success
+int tree_save(struct tree_node* root, const char* path) {
+    uint32_t count = tree_count_nodes(root), n = 0, sp = 0;
+    int32_t* values = (int32_t*)malloc((count ? count : 1) * sizeof(int32_t));
+    struct tree_node** stack = (struct tree_node**)malloc((count ? count : 1) * sizeof(struct tree_node*));
+    FILE* fp;
+    int status = -1;
+
+    if (values == NULL || stack == NULL) {
+        free(values);
+        free(stack);
+        return -1;
+    }
+
+    // Iterative preorder so degenerate trees do not exhaust the call stack
+    if (root != NULL) {
+        stack[sp++] = root;
+    }
+    while (sp > 0) {
+        struct tree_node* node = stack[--sp];
+        values[n++] = node->data;
+        if (node->right != NULL) {
+            stack[sp++] = node->right;
+        }
+        if (node->left != NULL) {
+            stack[sp++] = node->left;
+        }
+    }
+    free(stack);
+
+    fp = fopen(path, "wb");
+    if (fp != NULL) {
+        if (fwrite(TREE_MAGIC, sizeof(TREE_MAGIC), 1, fp) == 1 &&
+            fwrite(&count, sizeof(count), 1, fp) == 1 &&
+            fwrite(values, sizeof(int32_t), count, fp) == count) {
+            status = 0;
+        }
+        if (fclose(fp) != 0) {
+            status = -1;
+        }
+    }
+    free(values);
+    return status;
+}
+
+// Function to read a snapshot file into a new array of *count values, returns it or NULL
+static int32_t* read_snapshot(const char* path, uint32_t* count) {
+    char magic[4];
+    int32_t* values;
+    FILE* fp = fopen(path, "rb");
+
+    if (fp == NULL) {
+        return NULL;
+    }
+    if (fread(magic, sizeof(magic), 1, fp) != 1 || memcmp(magic, TREE_MAGIC, sizeof(magic)) != 0 ||
+        fread(count, sizeof(*count), 1, fp) != 1) {
+        fclose(fp);
+        return NULL;
+    }
+
+    // One sequential read of the value array
+    values = (int32_t*)malloc((*count ? *count : 1) * sizeof(int32_t));
+    if (values == NULL || fread(values, sizeof(int32_t), *count, fp) != *count) {
+        free(values);
+        fclose(fp);
+        return NULL;
+    }
+    fclose(fp);
+    return values;
+}
+
+// Function to link count nodes holding the preorder values into a tree rooted
+// at nodes[0], returns 0 or -1 if the scratch stack cannot be allocated
+// Rebuilds in O(n): a value goes right of the last ancestor it is >= to, like insert()
+static int rebuild(const int32_t* values, uint32_t count, struct tree_node* nodes) {
+    struct tree_node** stack = (struct tree_node**)malloc((count ? count : 1) * sizeof(struct tree_node*));
+    uint32_t i, sp = 0;
+
+    if (stack == NULL) {
+        return -1;
+    }
+    for (i = 0; i < count; i++) {
+        struct tree_node* node = &nodes[i];
+        struct tree_node* last = NULL;
+        node->data = values[i];
+        node->left = NULL;
+        node->right = NULL;
+        while (sp > 0 && node->data >= stack[sp - 1]->data) {
+            last = stack[--sp];
+        }
+        if (last != NULL) {
+            last->right = node;
+        } else if (sp > 0) {
+            stack[sp - 1]->left = node;
+        }
+        stack[sp++] = node;
+    }
+    free(stack);
+    return 0;
+}
+
+// Function to rebuild a tree from a preorder snapshot file
+// All nodes come from one block, so *block must be kept and freed as a whole
+int tree_load(const char* path, struct tree_node** root, struct tree_node** block) {
+    uint32_t count;
+    int32_t* values = read_snapshot(path, &count);
+    struct tree_node* nodes;
+
+    if (values == NULL) {
+        return -1;
+    }
+    if (count == 0) {
+        free(values);
+        *root = NULL;
+        *block = NULL;
+        return 0;
+    }
+
+    // One allocation for every node
+    nodes = (struct tree_node*)malloc(count * sizeof(struct tree_node));
+    if (nodes == NULL || rebuild(values, count, nodes) != 0) {
+        free(values);
+        free(nodes);
+        return -1;
+    }
+    free(values);
+    DS_ALLOC(tree_stats);  // the whole tree is a single malloc
+
+    *root = &nodes[0];
+    *block = nodes;
+    return 0;
+}
+
+// Function to rebuild a tree from a snapshot file into the arena
+// The nodes get a chunk of their own, sized for them, so they stay contiguous
+int tree_arena_load(const char* path, struct tree_arena* arena, struct tree_node** root) {
+    uint32_t count;
+    int32_t* values = read_snapshot(path, &count);
+    struct tree_node* nodes;
+
+    if (values == NULL) {
+        return -1;
+    }
+    if (count == 0) {
+        free(values);
+        *root = NULL;
+        return 0;
+    }
+    if (arena_grow(arena, count) != DS_OK) {
+        free(values);
+        return -1;
+    }
+    nodes = arena->chunks->nodes;
+    if (rebuild(values, count, nodes) != 0) {
+        arena->left = count;  // Nothing was handed out, the chunk stays for later inserts
+        free(values);
+        return -1;
+    }
+    arena->left = 0;
+    free(values);
+    *root = &nodes[0];
+    return 0;
+}
@@ -0,0 +1,103 @@
+#ifndef DS_TREE_H
+#define DS_TREE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ds_bloom.h"
+#include "ds_stats.h"
+
+// Define a structure for a tree node
+struct tree_node {
+    int data;
+    struct tree_node* left;
+    struct tree_node* right;
+};
+
+// Node arena: nodes are carved out of chunks that double in size, and nodes
+// deleted from the tree go on a free list that insertions use first. A tree
+// built in an arena is torn down by freeing its chunks, a few dozen frees for
+// millions of nodes, instead of walking every node.
+struct tree_chunk;
+
+struct tree_arena {
+    struct tree_chunk* chunks;      // newest first
+    size_t left;                    // nodes not yet handed out in the newest chunk
+    struct tree_node* free_list;    // deleted nodes, linked through right
+};
+
+// Counters, only compiled in with -DDS_INSTRUMENT; an arena counts one allocation per chunk
+DS_STATS_DECLARE(tree_stats);
+
+// Function to initialize an empty arena, no allocation
+static inline void tree_arena_init(struct tree_arena* arena) {
+    arena->chunks = NULL;
+    arena->left = 0;
+    arena->free_list = NULL;
+}
+
+// Function to free every node of the arena at once, one free per chunk
+// Every tree built in it is gone; the arena is left empty and can be reused
+void tree_arena_destroy(struct tree_arena* arena);
+
+// Preorder traversal function NLR, calls visit() on every value
+void tree_preorder(struct tree_node* root, void (*visit)(int val, void* ctx), void* ctx);
+
+// Inorder traversal function LNR, calls visit() on every value
+void tree_inorder(struct tree_node* root, void (*visit)(int val, void* ctx), void* ctx);
+
+// Postorder traversal function LRN, calls visit() on every value
+void tree_postorder(struct tree_node* root, void (*visit)(int val, void* ctx), void* ctx);
+
+// Function to search for a value in a binary search tree, returns 1 if found
+int tree_search(struct tree_node* root, int val);
+
+// Function to search for count values at once, found[i] is set to 1 if keys[i]
+// is in the tree and 0 if not; returns the number found. The searches advance
+// in lockstep, one level each in turn, so the cache misses of a whole group
+// overlap instead of following one another
+long tree_search_batch(struct tree_node* root, const int* keys, long count, uint8_t* found);
+
+// Function to insert a value in a binary search tree
+// If malloc fails the value is dropped and the tree is returned unchanged
+struct tree_node* tree_insert(struct tree_node* root, int val);
+
+// Function to insert a value with its node taken from the arena, recycled
+// nodes first; if the arena cannot grow the value is dropped as above
+struct tree_node* tree_arena_insert(struct tree_node* root, struct tree_arena* arena, int val);
+
+// Function to delete one occurrence of a value, returns DS_OK or DS_NOT_FOUND
+// A node with two children takes the value of its successor, whose node is
+// removed instead. The node goes back to the arena for reuse, or to free()
+// when arena is NULL (nodes from tree_insert())
+int tree_delete(struct tree_node** root, struct tree_arena* arena, int val);
+
+// Function to free every node of a tree built with tree_insert(), in O(n) without recursion
+void tree_free(struct tree_node* root);
+
+// Function to search behind a filter: values the filter rules out are answered
+// without walking the tree, a filter "maybe" that misses counts as a false positive
+int tree_search_filtered(struct tree_node* root, struct ds_bloom* filter, int val);
+
+// Function to insert a value and add it to the filter, which is grown and
+// refilled from the tree when it outgrows its capacity; the node comes from
+// the arena, or from malloc when arena is NULL
+struct tree_node* tree_insert_filtered(struct tree_node* root, struct tree_arena* arena, struct ds_bloom* filter, int val);
+
+// Function to empty the filter and add every value of the tree to it, growing it if needed
+void tree_fill_filter(struct tree_node* root, struct ds_bloom* filter);
+
+// Function to count the nodes of a tree
+uint32_t tree_count_nodes(struct tree_node* root);
+
+// Function to write the tree to a binary snapshot file in preorder, returns 0 on success
+int tree_save(struct tree_node* root, const char* path);
+
+// Function to rebuild a tree from a preorder snapshot file
+// All nodes come from one block, so *block must be kept and freed as a whole
+int tree_load(const char* path, struct tree_node** root, struct tree_node** block);
+
+// Function to rebuild a tree from a preorder snapshot file with its nodes in
+// the arena, all in one chunk; returns 0 on success
+int tree_arena_load(const char* path, struct tree_arena* arena, struct tree_node** root);
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef DS_WALK_H
+#define DS_WALK_H
+
+#include <stdlib.h>
+#include "ds_status.h"
+
+// Explicit stack of nodes for walking trees that must not be modified while
+// they are walked (shared versions of ptree, concurrently read ctree), so the
+// walk cannot thread links the way a Morris traversal does. Recursion would
+// go as deep as the tree, and unbalanced trees can be as deep as they are
+// long; this stack keeps its first DS_WALK_INLINE entries inside the struct
+// and doubles on the heap beyond that.
+
+#define DS_WALK_INLINE 64
+
+struct ds_walk {
+    const void** items;
+    size_t count;
+    size_t capacity;
+    const void* inline_items[DS_WALK_INLINE];
+};
+
+static inline void ds_walk_init(struct ds_walk* w) {
+    w->items = w->inline_items;
+    w->count = 0;
+    w->capacity = DS_WALK_INLINE;
+}
+
+static inline void ds_walk_free(struct ds_walk* w) {
+    if (w->items != w->inline_items) {
+        free((void*)w->items);
+    }
+    ds_walk_init(w);
+}
+
+// Function to push a node, returns DS_OK or DS_NO_MEMORY (stack unchanged)
+static inline int ds_walk_push(struct ds_walk* w, const void* node) {
+    if (w->count == w->capacity) {
+        const void** items;
+        if (w->capacity > (size_t)-1 / 2 / sizeof(*items)) {
+            return DS_NO_MEMORY;
+        }
+        if (w->items == w->inline_items) {
+            items = (const void**)malloc(2 * w->capacity * sizeof(*items));
+            if (items != NULL) {
+                size_t i;
+                for (i = 0; i < w->count; i++) {
+                    items[i] = w->items[i];
+                }
+            }
+        } else {
+            items = (const void**)realloc((void*)w->items, 2 * w->capacity * sizeof(*items));
+        }
+        if (items == NULL) {
+            return DS_NO_MEMORY;
+        }
+        w->items = items;
+        w->capacity *= 2;
+    }
+    w->items[w->count++] = node;
+    return DS_OK;
+}
+
+// Function to pop the last node pushed, NULL when the stack is empty
+static inline const void* ds_walk_pop(struct ds_walk* w) {
+    return w->count > 0 ? w->items[--w->count] : NULL;
+}
+
+#endif
@@ -1,133 +1,136 @@
-#include <stdio.h>
-#include <stdlib.h>
-
-// Node structure
-struct node {
-    int data;
-    struct node* next;
-};
-
-// Queue structure
-struct queue {
-    struct node* front;
-    struct node* rear;
-};
-
-// Initialize the queue
-void creation_file(struct queue* q) {
-    q->front = NULL;
-    q->rear = NULL;
-}
-
-// Enqueue operation
-void insertion(struct queue* q, int x) {
-    struct node* new_node = (struct node*)malloc(sizeof(struct node));
-    new_node->data = x;
-    new_node->next = NULL;
-
-    if (q->rear == NULL) {
-        q->front = new_node;
-        q->rear = new_node;
-    } else {
-        q->rear->next = new_node;
-        q->rear = new_node;
-    }
-    printf("Enqueued %d to the queue\n", x);
-}
-
-// Dequeue operation
-void supression(struct queue* q) {
-    if (q->front == NULL) {
-        printf("Queue is empty, nothing to dequeue\n");
-        return;
-    }
-
-    struct node* temp = q->front;
-    printf("Dequeued %d from the queue\n", temp->data);
-    q->front = q->front->next;
-
-    if (q->front == NULL) {
-        q->rear = NULL; // Queue is empty
-    }
-    free(temp);
-}
-
-// Front operation
-void front(struct queue* q) {
-    if (q->front == NULL) {
-        printf("Queue is empty\n");
-        return;
-    }
-    printf("Front element is %d\n", q->front->data);
-}
-
-// Peek operation
-int peek(struct queue* q) {
-    if (q->front == NULL) {
-        return -1;
-    }
-    return q->front->data;
-}
-
-// IsEmpty operation
-int is_queue_empty(struct queue* q) {
-    return q->front == NULL;
-}
-
-// Function to free the queue
-void free_queue(struct queue* q) {
-    while (q->front != NULL) {
-        supression(q); // Free each node
-    }
-}
-
-int main() {
-    // Declare and initialize the queue
-    struct queue* q = (struct queue*)malloc(sizeof(struct queue));
-    creation_file(q);
-    
-    int val, option;
-    do {
-        printf("\n***** MAIN MENU *****");
-        printf("\n1. INSERTION");
-        printf("\n2. SUPPRESSION");
-        printf("\n3. PEEK");
-        printf("\n4. VIDER (Clear Queue)");
-        printf("\n5. Exit");
-        printf("\nEnter your option: ");
-        scanf("%d", &option);
-
-        switch(option) {
-            case 1:
-                printf("\nEnter the number to insert into the queue: ");
-                scanf("%d", &val);
-                insertion(q, val);
-                break;
-
-            case 2:
-                supression(q);
-                break;
-
-            case 3:
-                val = peek(q);
-                if (val != -1)
-                    printf("\nThe front element of the queue is: %d\n", val);
-                else
-                    printf("\nQueue is empty\n");
-                break;
-
-            case 4:
-                free_queue(q);
-                printf("\nQueue has been cleared\n");
-                break;
-
-            case 5:
-                printf("\nExiting...\n");
-                break;
-
-            default:
-                printf("\nInvalid option!\n");
-        }
-    } while(option != 5);
-    return 0;
-}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ds_queue.h"
+#include "batch_io.h"
+
+// Run an operation log without prompts, options use the menu numbers
+int run_batch(struct queue* q, const char* log) {
+    struct batch_in in;
+    int option, val, status = 0;
+    long n = 0;
+    char path[256];
+
+    if (batch_open(&in, log) != 0) {
+        fprintf(stderr, "Cannot open %s\n", log);
+        return 1;
+    }
+    while (status == 0 && batch_next_int(&in, &option) == 1 && option != 7) {
+        n++;
+        switch (option) {
+            case 1:
+                if (batch_next_int(&in, &val) != 1)
+                    status = 1;
+                else if (queue_insertion(q, val) != DS_OK) {
+                    fprintf(stderr, "Out of memory\n");
+                    status = 1;
+                }
+                break;
+            case 2:
+            case 3:
+                if ((option == 2 ? queue_supression(q, &val) : queue_peek(q, &val)) == DS_OK)
+                    batch_put_int(val);
+                else
+                    fputs("empty\n", stdout);
+                break;
+            case 4:
+                queue_free(q);
+                break;
+            case 5:
+            case 6:
+                if (batch_next_word(&in, path, sizeof(path)) != 1)
+                    status = 1;
+                else if ((option == 5 ? queue_save(q, path) : queue_load(q, path)) != 0)
+                    fprintf(stderr, "File error: %s\n", path);
+                break;
+            default:
+                status = 1;
+        }
+    }
+    if (status != 0)
+        fprintf(stderr, "Invalid operation %ld\n", n);
+    batch_close(&in);
+    DS_EXPORT(queue_stats);
+    return status;
+}
+
+int main(int argc, char* argv[]) {
+    // Declare and initialize the queue
+    struct queue* q = (struct queue*)malloc(sizeof(struct queue));
+    queue_init(q);
+
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0)
+        return run_batch(q, argc > 2 ? argv[2] : NULL);
+
+    int val, option;
+    char path[256];
+    do {
+        printf("\n***** MAIN MENU *****");
+        printf("\n1. INSERTION");
+        printf("\n2. SUPPRESSION");
+        printf("\n3. PEEK");
+        printf("\n4. VIDER (Clear Queue)");
+        printf("\n5. SAVE");
+        printf("\n6. LOAD");
+        printf("\n7. Exit");
+        printf("\nEnter your option: ");
+        scanf("%d", &option);
+
+        switch(option) {
+            case 1:
+                printf("\nEnter the number to insert into the queue: ");
+                scanf("%d", &val);
+                if (queue_insertion(q, val) == DS_OK)
+                    printf("Enqueued %d to the queue\n", val);
+                else
+                    printf("Out of memory\n");
+                break;
+
+            case 2:
+                if (queue_supression(q, &val) == DS_OK)
+                    printf("Dequeued %d from the queue\n", val);
+                else
+                    printf("Queue is empty, nothing to dequeue\n");
+                break;
+
+            case 3:
+                if (queue_peek(q, &val) == DS_OK)
+                    printf("\nThe front element of the queue is: %d\n", val);
+                else
+                    printf("\nQueue is empty\n");
+                break;
+
+            case 4:
+                queue_free(q);
+                printf("\nQueue has been cleared\n");
+                break;
+
+            case 5:
+                printf("\nEnter the file name: ");
+                scanf("%255s", path);
+                if (queue_save(q, path) == 0)
+                    printf("\nQueue saved to %s\n", path);
+                else
+                    printf("\nCould not save the queue\n");
+                break;
+
+            case 6:
+                printf("\nEnter the file name: ");
+                scanf("%255s", path);
+                if (queue_load(q, path) == 0)
+                    printf("\nQueue loaded from %s\n", path);
+                else
+                    printf("\nCould not load the queue\n");
+                break;
+
+            case 7:
+                printf("\nExiting...\n");
+                DS_EXPORT(queue_stats);
+                break;
+
+            default:
+                printf("\nInvalid option!\n");
+        }
+    } while(option != 7);
+    return 0;
+}
@@ -1,86 +1,156 @@
-#include <stdio.h>
-#include <stdlib.h>
-
-// Define the stack structure
-struct stack {
-    int data;
-    struct stack *next;
-};
-
-// Global stack pointer
-struct stack *top = NULL;
-
-// Function to push an element onto the stack
-void push(int val) {
-    struct stack *ptr;
-    ptr = (struct stack *)malloc(sizeof(struct stack));
-    ptr->data = val;
-    ptr->next = top;
-    top = ptr;
-}
-
-// Function to pop an element from the stack
-void pop() {
-    struct stack *ptr;
-    if (top == NULL) {
-        printf("\nPILE VIDE\n");
-    } else {
-        ptr = top;
-        printf("\nLa valeur qui sera supprimée est : %d\n", ptr->data);
-        top = top->next;
-        free(ptr);
-    }
-}
-
-// Function to view the top element of the stack
-int peek() {
-    if (top == NULL) {
-        printf("\nPILE VIDE\n");
-        return -1;
-    } else {
-        return top->data;
-    }
-}
-
-// Main function
-int main() {
-    int val, option;
-
-    do {
-        printf("\n***** MENU PRINCIPAL *****");
-        printf("\n1. PUSH");
-        printf("\n2. POP");
-        printf("\n3. PEEK");
-        printf("\n4. EXIT");
-        printf("\nEntrer votre option: ");
-        scanf("%d", &option);
-
-        switch (option) {
-            case 1:
-                printf("\nEntrer le nombre à empiler dans la pile : ");
-                scanf("%d", &val);
-                push(val);  // No need to return top
-                break;
-
-            case 2:
-                pop();  // No need to return top
-                break;
-
-            case 3:
-                val = peek();
-                if (val != -1) {
-                    printf("\nLa valeur au sommet de la pile est : %d\n", val);
-                }
-                break;
-
-            case 4:
-                printf("\nSortie du programme.\n");
-                break;
-
-            default:
-                printf("\nOption invalide! Veuillez réessayer.\n");
-        }
-    } while (option != 4);
-
-    return 0;
-}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ds_stack.h"
+#include "batch_io.h"
+
+// The stack driven by the menu; it keeps its minimum, maximum and sum up to date
+struct agg_stack pile = {0, 0, NULL};
+
+// Function to run an operation log without prompts, options use the menu numbers
+// Exit keeps the number it had when logs were introduced and later options
+// come after it, so existing logs keep meaning the same thing
+int run_batch(const char *log) {
+    struct batch_in in;
+    int option, val, lo, hi, status = 0;
+    long n = 0;
+    char path[256];
+
+    if (batch_open(&in, log) != 0) {
+        fprintf(stderr, "Impossible d'ouvrir %s\n", log);
+        return 1;
+    }
+    while (status == 0 && batch_next_int(&in, &option) == 1 && option != 6) {
+        n++;
+        switch (option) {
+            case 1:
+                if (batch_next_int(&in, &val) != 1) {
+                    status = 1;
+                } else if (agg_stack_push(&pile, val) != DS_OK) {
+                    fprintf(stderr, "Mémoire insuffisante\n");
+                    status = 1;
+                }
+                break;
+            case 2:
+            case 3:
+                if ((option == 2 ? agg_stack_pop(&pile, &val) : agg_stack_peek(&pile, &val)) == DS_OK) {
+                    batch_put_int(val);
+                } else {
+                    fputs("empty\n", stdout);
+                }
+                break;
+            case 4:
+            case 5:
+                if (batch_next_word(&in, path, sizeof(path)) != 1) {
+                    status = 1;
+                } else if ((option == 4 ? agg_stack_save(&pile, path) : agg_stack_load(&pile, path)) != 0) {
+                    fprintf(stderr, "Erreur de fichier : %s\n", path);
+                }
+                break;
+            case 7:
+                if (agg_stack_min(&pile, &lo) == DS_OK && agg_stack_max(&pile, &hi) == DS_OK) {
+                    printf("%d %d %lld\n", lo, hi, agg_stack_sum(&pile));
+                } else {
+                    fputs("empty\n", stdout);
+                }
+                break;
+            default:
+                status = 1;
+        }
+    }
+    if (status != 0) {
+        fprintf(stderr, "Operation %ld invalide\n", n);
+    }
+    batch_close(&in);
+    DS_EXPORT(agg_stack_stats);
+    return status;
+}
+
+// Main function
+int main(int argc, char *argv[]) {
+    int val, lo, hi, option;
+    char path[256];
+
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0) {
+        return run_batch(argc > 2 ? argv[2] : NULL);
+    }
+
+    do {
+        printf("\n***** MENU PRINCIPAL *****");
+        printf("\n1. PUSH");
+        printf("\n2. POP");
+        printf("\n3. PEEK");
+        printf("\n4. SAUVEGARDER");
+        printf("\n5. CHARGER");
+        printf("\n6. EXIT");
+        printf("\n7. MIN / MAX / SOMME");
+        printf("\nEntrer votre option: ");
+        scanf("%d", &option);
+
+        switch (option) {
+            case 1:
+                printf("\nEntrer le nombre à empiler dans la pile : ");
+                scanf("%d", &val);
+                if (agg_stack_push(&pile, val) != DS_OK) {
+                    printf("\nMémoire insuffisante\n");
+                }
+                break;
+
+            case 2:
+                if (agg_stack_pop(&pile, &val) == DS_OK) {
+                    printf("\nLa valeur qui sera supprimée est : %d\n", val);
+                } else {
+                    printf("\nPILE VIDE\n");
+                }
+                break;
+
+            case 3:
+                if (agg_stack_peek(&pile, &val) == DS_OK) {
+                    printf("\nLa valeur au sommet de la pile est : %d\n", val);
+                } else {
+                    printf("\nPILE VIDE\n");
+                }
+                break;
+
+            case 4:
+                printf("\nEntrer le nom du fichier : ");
+                scanf("%255s", path);
+                if (agg_stack_save(&pile, path) == 0) {
+                    printf("\nPile sauvegardée dans %s\n", path);
+                } else {
+                    printf("\nErreur lors de la sauvegarde\n");
+                }
+                break;
+
+            case 5:
+                printf("\nEntrer le nom du fichier : ");
+                scanf("%255s", path);
+                if (agg_stack_load(&pile, path) == 0) {
+                    printf("\nPile chargée depuis %s\n", path);
+                } else {
+                    printf("\nErreur lors du chargement\n");
+                }
+                break;
+
+            case 7:
+                if (agg_stack_min(&pile, &lo) == DS_OK && agg_stack_max(&pile, &hi) == DS_OK) {
+                    printf("\nMinimum de la pile : %d\n", lo);
+                    printf("Maximum de la pile : %d\n", hi);
+                    printf("Somme de la pile : %lld\n", agg_stack_sum(&pile));
+                } else {
+                    printf("\nPILE VIDE\n");
+                }
+                break;
+
+            case 6:
+                printf("\nSortie du programme.\n");
+                DS_EXPORT(agg_stack_stats);
+                break;
+
+            default:
+                printf("\nOption invalide! Veuillez réessayer.\n");
+        }
+    } while (option != 6);
+
+    return 0;
+}
@@ -0,0 +1,39 @@
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// Minimal checks shared by the test_* programs, which ctest runs.
+// A test is a program that returns 0 when every CHECK held; a failed CHECK
+// prints where it was and the test goes on, so one run shows every failure.
+// CHECK may be used from several threads at once.
+
+static int test_failures;
+
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        if (!(cond)) {                                                        \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            __atomic_add_fetch(&test_failures, 1, __ATOMIC_RELAXED);          \
+        }                                                                     \
+    } while (0)
+
+// xorshift64*, so every run sees the same sequence for a given seed
+static inline unsigned long long test_rand(unsigned long long* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 2685821657736338717ULL;
+}
+
+static inline int test_done(const char* name) {
+    if (test_failures != 0) {
+        fprintf(stderr, "%s: %d checks failed\n", name, test_failures);
+        return 1;
+    }
+    printf("%s: ok\n", name);
+    return 0;
+}
+
+#endif
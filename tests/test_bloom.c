@@ -0,0 +1,142 @@
+// Model test for the counting Bloom filter: random adds and removes,
+// duplicates included, are checked against a count of every candidate value.
+// A value with a count must never be reported absent, the false-positive rate
+// at capacity must be near the one the filter was sized for, a filter that is
+// outgrown must resize and work again once refilled, and removing every value
+// must leave every counter back at zero.
+#include "ds_bloom.h"
+
+#include "test.h"
+
+#define TEST_CANDIDATES 3000    // values that may be added
+#define TEST_ABSENT 20000       // values that never are, for the false-positive rate
+#define TEST_CAPACITY 1000
+#define TEST_FPR 0.01
+#define TEST_OPS 100000
+
+static int counts[TEST_CANDIDATES];
+
+// Spread the candidates over the whole int range, absent values after them
+static int value_of(int i) {
+    return (int)((unsigned)i * 2654435761u);
+}
+
+static long model_items(void) {
+    long items = 0;
+    int i;
+    for (i = 0; i < TEST_CANDIDATES; i++) {
+        items += counts[i];
+    }
+    return items;
+}
+
+// Every value the model holds must be reported as maybe present
+static void check_no_false_negatives(struct ds_bloom* f) {
+    int i;
+    for (i = 0; i < TEST_CANDIDATES; i++) {
+        if (counts[i] > 0) {
+            CHECK(ds_bloom_may_contain(f, value_of(i)));
+        }
+    }
+    CHECK(f->items == model_items());
+}
+
+// Share of the values never added that are reported as maybe present
+static double false_positive_rate(struct ds_bloom* f) {
+    long hits = 0;
+    int i;
+    for (i = 0; i < TEST_ABSENT; i++) {
+        hits += ds_bloom_may_contain(f, value_of(TEST_CANDIDATES + i));
+    }
+    return (double)hits / TEST_ABSENT;
+}
+
+int main(void) {
+    struct ds_bloom f;
+    unsigned long long seed = 42;
+    uint64_t queries;
+    long i;
+    int c, k;
+
+    CHECK(ds_bloom_init(&f, TEST_CAPACITY, TEST_FPR) == DS_OK);
+    for (i = 0; i < TEST_OPS; i++) {
+        unsigned long long r = test_rand(&seed);
+        c = (int)((r >> 8) % (TEST_CANDIDATES / 2));
+        if (r % 3 == 0) {
+            if (counts[c] > 0) {
+                ds_bloom_remove(&f, value_of(c));
+                counts[c]--;
+            }
+        } else if (f.items < TEST_CAPACITY) {
+            ds_bloom_add(&f, value_of(c));
+            counts[c]++;
+        }
+        if (i % 1000 == 0) {
+            check_no_false_negatives(&f);
+        }
+    }
+    check_no_false_negatives(&f);
+    CHECK(ds_bloom_grow(&f) == 0);
+
+    // Filled to capacity with distinct values, the rate is near the one asked for
+    for (c = 0; c < TEST_CANDIDATES; c++) {
+        while (counts[c] > 0) {
+            ds_bloom_remove(&f, value_of(c));
+            counts[c]--;
+        }
+    }
+    for (c = 0; c < TEST_CAPACITY; c++) {
+        ds_bloom_add(&f, value_of(c));
+        counts[c]++;
+    }
+    check_no_false_negatives(&f);
+    CHECK(false_positive_rate(&f) < 2 * TEST_FPR);
+    CHECK(f.rejected <= f.queries);
+
+    // Outgrown: the resized filter starts empty, keeps the effectiveness
+    // counters, and holds its new capacity at the same rate once refilled
+    for (c = TEST_CAPACITY; c < TEST_CANDIDATES; c++) {
+        ds_bloom_add(&f, value_of(c));
+        counts[c]++;
+    }
+    check_no_false_negatives(&f);
+    queries = f.queries;
+    CHECK(ds_bloom_grow(&f) == 1);
+    CHECK(f.items == 0);
+    CHECK(f.capacity == 2 * TEST_CANDIDATES);
+    CHECK(f.queries == queries);
+    for (c = 0; c < TEST_CANDIDATES; c++) {
+        ds_bloom_add(&f, value_of(c));
+    }
+    check_no_false_negatives(&f);
+    CHECK(false_positive_rate(&f) < TEST_FPR);
+    CHECK(ds_bloom_grow(&f) == 0);
+
+    // A value added several times stays until it is removed as many times
+    for (k = 0; k < 3; k++) {
+        ds_bloom_add(&f, value_of(0));
+        counts[0]++;
+    }
+    for (k = 0; k < 3; k++) {
+        ds_bloom_remove(&f, value_of(0));
+        counts[0]--;
+        check_no_false_negatives(&f);
+    }
+
+    // Everything removed: no counter may be left set
+    for (c = 0; c < TEST_CANDIDATES; c++) {
+        while (counts[c] > 0) {
+            ds_bloom_remove(&f, value_of(c));
+            counts[c]--;
+        }
+    }
+    CHECK(f.items == 0);
+    for (c = 0; c < TEST_CANDIDATES; c++) {
+        CHECK(!ds_bloom_may_contain(&f, value_of(c)));
+    }
+    CHECK(false_positive_rate(&f) == 0.0);
+
+    ds_bloom_reset(&f);
+    ds_bloom_free(&f);
+    return test_done("test_bloom");
+}
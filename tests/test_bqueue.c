@@ -0,0 +1,156 @@
+// Stress test for the blocking queue: producers push numbered values in
+// bursts with pauses between them, so consumers keep going to sleep and being
+// woken, while consumers take them by waiting without a timeout, by waiting
+// with a short timeout, and from an event loop on the eventfd. Every value
+// must be taken exactly once, each consumer must see the values of a producer
+// in the order they were pushed, and closing the queue must let every
+// consumer finish once it is drained.
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include "ds_bqueue.h"
+
+#include "test.h"
+
+#define TEST_PRODUCERS 4
+#define TEST_ITEMS 100000   // per producer
+#define TEST_WAITING 2      // consumers waiting without a timeout
+
+enum consumer_kind { CONSUMER_WAIT, CONSUMER_TIMEOUT, CONSUMER_EVENT };
+
+static struct bqueue queue;
+static unsigned char taken[TEST_PRODUCERS * TEST_ITEMS];
+
+struct producer {
+    pthread_t thread;
+    int index;
+};
+
+struct consumer {
+    pthread_t thread;
+    enum consumer_kind kind;
+    long count;
+    long long sum;
+    int last[TEST_PRODUCERS];
+};
+
+static void* producer_run(void* arg) {
+    struct producer* p = (struct producer*)arg;
+    unsigned long long seed = 0x9E3779B97F4A7C15ULL * (unsigned long long)(p->index + 1);
+    struct timespec pause = {0, 50000};
+    int i;
+    for (i = 0; i < TEST_ITEMS; i++) {
+        CHECK(bqueue_push(&queue, p->index * TEST_ITEMS + i) == DS_OK);
+        if (i % 1000 == 999 && test_rand(&seed) % 4 == 0) {
+            nanosleep(&pause, NULL);
+        }
+    }
+    return NULL;
+}
+
+// Record a value taken by consumer c
+static void take(struct consumer* c, int x) {
+    int producer = x / TEST_ITEMS, i = x % TEST_ITEMS;
+    CHECK(x >= 0 && producer < TEST_PRODUCERS);
+    if (x < 0 || producer >= TEST_PRODUCERS) {
+        return;
+    }
+    CHECK(__atomic_add_fetch(&taken[x], 1, __ATOMIC_RELAXED) == 1);
+    CHECK(i > c->last[producer]);
+    c->last[producer] = i;
+    c->count++;
+    c->sum += x;
+}
+
+// Take what is left without waiting
+static void drain(struct consumer* c) {
+    int x;
+    while (bqueue_pop(&queue, &x, 0) == DS_OK) {
+        take(c, x);
+    }
+}
+
+static void* consumer_run(void* arg) {
+    struct consumer* c = (struct consumer*)arg;
+    struct pollfd pfd;
+    int x;
+
+    switch (c->kind) {
+    case CONSUMER_WAIT:
+        // Only returns DS_EMPTY once the queue is closed and drained
+        while (bqueue_pop(&queue, &x, -1) == DS_OK) {
+            take(c, x);
+        }
+        break;
+    case CONSUMER_TIMEOUT:
+        for (;;) {
+            if (bqueue_pop(&queue, &x, 1000000) == DS_OK) {
+                take(c, x);
+            } else if (__atomic_load_n(&queue.closed, __ATOMIC_ACQUIRE)) {
+                drain(c);
+                break;
+            }
+        }
+        break;
+    default:
+        pfd.fd = bqueue_event_fd(&queue);
+        pfd.events = POLLIN;
+        for (;;) {
+            int closed;
+            CHECK(poll(&pfd, 1, 1000) >= 0);
+            closed = __atomic_load_n(&queue.closed, __ATOMIC_ACQUIRE);
+            bqueue_ack_event(&queue);
+            drain(c);
+            if (closed) {
+                break;
+            }
+        }
+        break;
+    }
+    return NULL;
+}
+
+int main(void) {
+    struct producer producers[TEST_PRODUCERS];
+    struct consumer consumers[TEST_WAITING + 2];
+    long long sum = 0, expected_sum = 0;
+    long count = 0;
+    int i, p;
+
+    bqueue_init(&queue);
+    CHECK(bqueue_open_eventfd(&queue) == DS_OK);
+    for (i = 0; i < TEST_WAITING + 2; i++) {
+        consumers[i].kind = i < TEST_WAITING ? CONSUMER_WAIT : i == TEST_WAITING ? CONSUMER_TIMEOUT : CONSUMER_EVENT;
+        consumers[i].count = 0;
+        consumers[i].sum = 0;
+        for (p = 0; p < TEST_PRODUCERS; p++) {
+            consumers[i].last[p] = -1;
+        }
+        pthread_create(&consumers[i].thread, NULL, consumer_run, &consumers[i]);
+    }
+    for (p = 0; p < TEST_PRODUCERS; p++) {
+        producers[p].index = p;
+        pthread_create(&producers[p].thread, NULL, producer_run, &producers[p]);
+    }
+    for (p = 0; p < TEST_PRODUCERS; p++) {
+        pthread_join(producers[p].thread, NULL);
+    }
+    bqueue_close(&queue);
+    for (i = 0; i < TEST_WAITING + 2; i++) {
+        pthread_join(consumers[i].thread, NULL);
+        count += consumers[i].count;
+        sum += consumers[i].sum;
+    }
+
+    for (i = 0; i < TEST_PRODUCERS * TEST_ITEMS; i++) {
+        CHECK(taken[i] == 1);
+        expected_sum += i;
+    }
+    CHECK(count == TEST_PRODUCERS * TEST_ITEMS);
+    CHECK(sum == expected_sum);
+    CHECK(bqueue_count(&queue) == 0);
+    CHECK(bqueue_pop(&queue, NULL, -1) == DS_EMPTY);
+
+    bqueue_free(&queue);
+    return test_done("test_bqueue");
+}
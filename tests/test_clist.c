@@ -0,0 +1,141 @@
+// Model test for the compact list: random insertions and deletions at both
+// ends, at positions and by value are checked against a plain array, walked
+// in both directions. The list grows past several pool doublings, shrinks so
+// that freed slots are reused, and is cleared and filled again in between.
+#include <string.h>
+#include "ds_clist.h"
+
+#include "test.h"
+
+#define TEST_MAX 5000
+#define TEST_VALUES 200
+#define TEST_OPS 200000
+
+static int model[TEST_MAX];
+static int model_count;
+
+struct walk {
+    long count;
+    int step;       // 1 from head to tail, -1 back
+    int matches;
+};
+
+static void visit(int val, void* ctx) {
+    struct walk* walk = (struct walk*)ctx;
+    long i = walk->step > 0 ? walk->count : model_count - 1 - walk->count;
+    if (i < 0 || i >= model_count || model[i] != val) {
+        walk->matches = 0;
+    }
+    walk->count++;
+}
+
+static void check_list(const struct clist* list) {
+    struct walk forward = {0, 1, 1}, backward = {0, -1, 1};
+    CHECK(clist_count_of_nodes(list) == model_count);
+    clist_traverse(list, visit, &forward);
+    CHECK(forward.matches && forward.count == model_count);
+    clist_traverse_reverse(list, visit, &backward);
+    CHECK(backward.matches && backward.count == model_count);
+    CHECK(list->used <= list->capacity);
+}
+
+// Model of an insertion before index i (0-based)
+static void model_insert(int i, int val) {
+    memmove(&model[i + 1], &model[i], (size_t)(model_count - i) * sizeof(int));
+    model[i] = val;
+    model_count++;
+}
+
+static void model_delete(int i) {
+    memmove(&model[i], &model[i + 1], (size_t)(model_count - i - 1) * sizeof(int));
+    model_count--;
+}
+
+int main(void) {
+    struct clist list;
+    unsigned long long seed = 42;
+    long i;
+    int k;
+
+    clist_init(&list);
+    for (i = 0; i < TEST_OPS; i++) {
+        unsigned long long r = test_rand(&seed);
+        int val = (int)((r >> 8) % TEST_VALUES);
+        int position = model_count > 0 ? (int)((r >> 24) % (unsigned)(model_count + 2)) : (int)((r >> 24) % 3);
+        // Grow for the first half, then mostly shrink
+        int grow = i < TEST_OPS / 2 ? (r >> 40) % 8 < 5 : (r >> 40) % 8 < 3;
+        if (model_count >= TEST_MAX - 1) {
+            grow = 0;
+        }
+        switch ((r % 3) + (grow ? 0 : 3)) {
+        case 0:
+            CHECK(clist_add_beg(&list, val) == DS_OK);
+            model_insert(0, val);
+            break;
+        case 1:
+            CHECK(clist_add_at_end(&list, val) == DS_OK);
+            model_insert(model_count, val);
+            break;
+        case 2:
+            // Positions 0 and past length + 1 are refused
+            if (position >= 1 && position <= model_count + 1) {
+                CHECK(clist_insert_at_position(&list, val, position) == DS_OK);
+                model_insert(position - 1, val);
+            } else {
+                CHECK(clist_insert_at_position(&list, val, position == 0 ? 0 : model_count + 2) == DS_BAD_POSITION);
+            }
+            break;
+        case 3:
+            for (k = 0; k < model_count && model[k] != val; k++) {
+            }
+            CHECK(clist_delete_by_value(&list, val) == (model_count == 0 ? DS_EMPTY : k < model_count ? DS_OK : DS_NOT_FOUND));
+            if (k < model_count) {
+                model_delete(k);
+            }
+            break;
+        case 4:
+            if (r % 2 == 0) {
+                CHECK(clist_delete_beg(&list) == (model_count > 0 ? DS_OK : DS_EMPTY));
+                if (model_count > 0) {
+                    model_delete(0);
+                }
+            } else {
+                CHECK(clist_delete_end(&list) == (model_count > 0 ? DS_OK : DS_EMPTY));
+                if (model_count > 0) {
+                    model_delete(model_count - 1);
+                }
+            }
+            break;
+        default:
+            if (model_count == 0) {
+                CHECK(clist_delete_at_position(&list, 1) == DS_EMPTY);
+            } else if (position >= 1 && position <= model_count) {
+                CHECK(clist_delete_at_position(&list, position) == DS_OK);
+                model_delete(position - 1);
+            } else {
+                CHECK(clist_delete_at_position(&list, position == 0 ? 0 : model_count + 1) == DS_BAD_POSITION);
+            }
+            break;
+        }
+        if (i % 1000 == 0 || model_count < 3) {
+            check_list(&list);
+        }
+        // Now and then start over in the same pool
+        if (i % 50000 == 25000) {
+            clist_clear_list(&list);
+            model_count = 0;
+            check_list(&list);
+        }
+    }
+    check_list(&list);
+
+    clist_free(&list);
+    model_count = 0;
+    check_list(&list);
+    CHECK(clist_delete_beg(&list) == DS_EMPTY);
+    CHECK(clist_add_at_end(&list, 7) == DS_OK);
+    model[model_count++] = 7;
+    check_list(&list);
+    clist_free(&list);
+    return test_done("test_clist");
+}
@@ -0,0 +1,141 @@
+// Stress test for the lock-free skip list and its reclamation.
+// Every thread owns the keys equal to its index modulo TEST_THREADS and keeps
+// track of which of them it inserted, so membership can be checked exactly,
+// while all threads also churn a small range of shared keys (so deletions of
+// nodes still being linked happen) and search everywhere. At the end the list
+// must hold exactly the owned keys each thread left in, in ascending order, and
+// every deleted node must be freed once no other thread is left.
+#include <pthread.h>
+#include "ds_skiplist.h"
+
+#include "test.h"
+
+#define TEST_THREADS 4
+#define TEST_KEYS 4096      // owned keys, TEST_KEYS / TEST_THREADS per thread
+#define TEST_SHARED 32      // shared keys, above the owned ones
+#define TEST_OPS 200000     // per thread
+
+static struct cskiplist list;
+
+struct worker {
+    pthread_t thread;
+    int index;
+    long deletes;
+    unsigned char present[TEST_KEYS];
+};
+
+static void* worker_run(void* arg) {
+    struct worker* w = (struct worker*)arg;
+    unsigned long long seed = 0x9E3779B97F4A7C15ULL * (unsigned long long)(w->index + 1);
+    int slot = cskiplist_register(&list);
+    long i;
+
+    CHECK(slot >= 0);
+    if (slot < 0) {
+        return NULL;
+    }
+    for (i = 0; i < TEST_OPS; i++) {
+        unsigned long long r = test_rand(&seed);
+        int key = (int)((r >> 8) % (TEST_KEYS / TEST_THREADS)) * TEST_THREADS + w->index;
+        int shared = TEST_KEYS + (int)((r >> 24) % TEST_SHARED);
+        switch (r % 8) {
+        case 0:
+        case 1:
+            CHECK(cskiplist_insert(&list, slot, key) == (w->present[key] ? DS_EXISTS : DS_OK));
+            w->present[key] = 1;
+            break;
+        case 2:
+        case 3:
+            CHECK(cskiplist_delete(&list, slot, key) == (w->present[key] ? DS_OK : DS_NOT_FOUND));
+            w->deletes += w->present[key];
+            w->present[key] = 0;
+            break;
+        case 4:
+            CHECK(cskiplist_search(&list, slot, key) == w->present[key]);
+            break;
+        case 5:
+            cskiplist_insert(&list, slot, shared);
+            break;
+        case 6:
+            if (cskiplist_delete(&list, slot, shared) == DS_OK) {
+                w->deletes++;
+            }
+            break;
+        default:
+            cskiplist_search(&list, slot, (int)((r >> 8) % (TEST_KEYS + TEST_SHARED)));
+            break;
+        }
+    }
+    cskiplist_unregister(&list, slot);
+    return NULL;
+}
+
+struct walk {
+    int last;
+    long count;
+    long owned;
+    int sorted;
+};
+
+static void visit(int val, void* ctx) {
+    struct walk* walk = (struct walk*)ctx;
+    if (walk->count > 0 && val <= walk->last) {
+        walk->sorted = 0;
+    }
+    walk->last = val;
+    walk->count++;
+    walk->owned += val < TEST_KEYS;
+}
+
+static long limbo_length(const struct ds_epoch* e) {
+    long length = 0;
+    int i;
+    for (i = 0; i < 3; i++) {
+        const struct cskiplist_node* node = (const struct cskiplist_node*)e->limbo[i];
+        for (; node != NULL; node = node->retired) {
+            length++;
+        }
+    }
+    return length;
+}
+
+int main(void) {
+    static struct worker workers[TEST_THREADS];
+    struct walk walk = {0, 0, 0, 1};
+    long deletes = 0, expected = 0;
+    int i, key, slot;
+
+    CHECK(cskiplist_init(&list) == DS_OK);
+    for (i = 0; i < TEST_THREADS; i++) {
+        workers[i].index = i;
+        pthread_create(&workers[i].thread, NULL, worker_run, &workers[i]);
+    }
+    for (i = 0; i < TEST_THREADS; i++) {
+        pthread_join(workers[i].thread, NULL);
+        deletes += workers[i].deletes;
+    }
+
+    slot = cskiplist_register(&list);
+    for (key = 0; key < TEST_KEYS; key++) {
+        int present = workers[key % TEST_THREADS].present[key];
+        CHECK(cskiplist_search(&list, slot, key) == present);
+        expected += present;
+    }
+    cskiplist_traverse(&list, slot, visit, &walk);
+    CHECK(walk.sorted);
+    CHECK(walk.owned == expected);
+    CHECK(walk.count == cskiplist_count(&list));
+
+    // A thread descheduled inside an operation holds the epoch back, so
+    // deleted nodes can still be waiting now; with nobody else left, each
+    // further deletion moves the epoch on and everything older is freed
+    for (i = 0; i < 3; i++) {
+        CHECK(cskiplist_insert(&list, slot, -1) == DS_OK);
+        CHECK(cskiplist_delete(&list, slot, -1) == DS_OK);
+    }
+    cskiplist_unregister(&list, slot);
+    CHECK(deletes > 10000);
+    CHECK(limbo_length(&list.reclaim) <= 3);
+    cskiplist_free(&list);
+    return test_done("test_cskiplist");
+}
@@ -0,0 +1,162 @@
+// Stress test for the concurrent tree: 3 readers search without locking while
+// 2 writers insert and delete. The even keys are inserted first and never
+// deleted, so every search for one must hit, including the ones that run while
+// a deletion moves that key up as the successor of a node with two children.
+// Writers churn the odd keys, each writer its own half of them so it knows
+// which it left in. At the end the tree must hold exactly those keys in order,
+// and every removed node must be freed once no reader is left.
+#include <pthread.h>
+#include "ds_ctree.h"
+
+#include "test.h"
+
+#define TEST_READERS 3
+#define TEST_WRITERS 2
+#define TEST_KEYS 8192
+#define TEST_WRITES 200000      // per writer
+
+static struct ctree tree;
+static int writers_done;
+
+struct writer {
+    pthread_t thread;
+    int index;
+    long deletes;
+    unsigned char present[TEST_KEYS];
+};
+
+struct reader {
+    pthread_t thread;
+    int index;
+    long searches;
+};
+
+// Writer w owns the odd keys k with (k / 2) % TEST_WRITERS == w
+static void* writer_run(void* arg) {
+    struct writer* w = (struct writer*)arg;
+    unsigned long long seed = 0x9E3779B97F4A7C15ULL * (unsigned long long)(w->index + 1);
+    long i;
+    for (i = 0; i < TEST_WRITES; i++) {
+        unsigned long long r = test_rand(&seed);
+        int key = (int)((r >> 8) % (TEST_KEYS / 2 / TEST_WRITERS)) * 2 * TEST_WRITERS + 2 * w->index + 1;
+        if (r % 2 == 0) {
+            CHECK(ctree_insert(&tree, key) == (w->present[key] ? DS_EXISTS : DS_OK));
+            w->present[key] = 1;
+        } else {
+            CHECK(ctree_delete(&tree, key) == (w->present[key] ? DS_OK : DS_NOT_FOUND));
+            w->deletes += w->present[key];
+            w->present[key] = 0;
+        }
+    }
+    __atomic_add_fetch(&writers_done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void* reader_run(void* arg) {
+    struct reader* rd = (struct reader*)arg;
+    unsigned long long seed = 0xD1B54A32D192ED03ULL * (unsigned long long)(rd->index + 1);
+    int slot = ctree_register(&tree);
+    CHECK(slot >= 0);
+    if (slot < 0) {
+        return NULL;
+    }
+    while (__atomic_load_n(&writers_done, __ATOMIC_ACQUIRE) < TEST_WRITERS) {
+        unsigned long long r = test_rand(&seed);
+        int key = (int)((r >> 8) % TEST_KEYS);
+        if (key % 2 == 0) {
+            CHECK(ctree_search(&tree, slot, key));
+        } else {
+            ctree_search(&tree, slot, key);
+        }
+        rd->searches++;
+    }
+    ctree_unregister(&tree, slot);
+    return NULL;
+}
+
+struct walk {
+    int last;
+    long count;
+    int sorted;
+};
+
+static void visit(int val, void* ctx) {
+    struct walk* walk = (struct walk*)ctx;
+    if (walk->count > 0 && val <= walk->last) {
+        walk->sorted = 0;
+    }
+    walk->last = val;
+    walk->count++;
+}
+
+static long limbo_length(const struct ds_epoch* e) {
+    long length = 0;
+    int i;
+    for (i = 0; i < 3; i++) {
+        const struct ctree_node* node = (const struct ctree_node*)e->limbo[i];
+        for (; node != NULL; node = node->retired) {
+            length++;
+        }
+    }
+    return length;
+}
+
+int main(void) {
+    static struct writer writers[TEST_WRITERS];
+    static struct reader readers[TEST_READERS];
+    struct walk walk = {0, 0, 1};
+    long deletes = 0, searches = 0, expected = TEST_KEYS / 2;
+    int i, key, slot;
+    unsigned long long seed = 42;
+
+    // Even keys in random order, so the tree is not a list
+    ctree_init(&tree);
+    for (i = 0; i < 4 * TEST_KEYS; i++) {
+        ctree_insert(&tree, (int)(test_rand(&seed) % (TEST_KEYS / 2)) * 2);
+    }
+    for (key = 0; key < TEST_KEYS; key += 2) {
+        ctree_insert(&tree, key);
+    }
+
+    for (i = 0; i < TEST_READERS; i++) {
+        readers[i].index = i;
+        pthread_create(&readers[i].thread, NULL, reader_run, &readers[i]);
+    }
+    for (i = 0; i < TEST_WRITERS; i++) {
+        writers[i].index = i;
+        pthread_create(&writers[i].thread, NULL, writer_run, &writers[i]);
+    }
+    for (i = 0; i < TEST_WRITERS; i++) {
+        pthread_join(writers[i].thread, NULL);
+        deletes += writers[i].deletes;
+    }
+    for (i = 0; i < TEST_READERS; i++) {
+        pthread_join(readers[i].thread, NULL);
+        searches += readers[i].searches;
+    }
+
+    slot = ctree_register(&tree);
+    for (key = 1; key < TEST_KEYS; key += 2) {
+        int present = writers[(key / 2) % TEST_WRITERS].present[key];
+        CHECK(ctree_search(&tree, slot, key) == present);
+        expected += present;
+    }
+    CHECK(ctree_inorder(&tree, slot, visit, &walk) == DS_OK);
+    CHECK(walk.sorted);
+    CHECK(walk.count == expected);
+    CHECK(ctree_count(&tree) == expected);
+    ctree_unregister(&tree, slot);
+
+    // A reader descheduled inside a search holds the epoch back, so removed
+    // nodes can still be waiting now; with no reader left, each further
+    // deletion moves the epoch on and everything older is freed
+    for (i = 0; i < 3; i++) {
+        CHECK(ctree_insert(&tree, TEST_KEYS + 1) == DS_OK);
+        CHECK(ctree_delete(&tree, TEST_KEYS + 1) == DS_OK);
+    }
+    CHECK(searches > 0);
+    CHECK(deletes > 10000);
+    CHECK(limbo_length(&tree.reclaim) <= 3);
+    ctree_free(&tree);
+    return test_done("test_ctree");
+}
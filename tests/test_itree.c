@@ -0,0 +1,127 @@
+// Model test for the interval tree: random inserts, deletes and overlap
+// queries are checked against a plain array of the intervals that should be
+// in the tree. Some candidate intervals share their start, so ties on start
+// are ordered by end. Every so often the whole tree is checked for the AVL
+// balance, the stored heights and the max_end of every subtree.
+#include "ds_itree.h"
+
+#include "test.h"
+
+#define TEST_INTERVALS 3000
+#define TEST_OPS 200000
+
+static int starts[TEST_INTERVALS];
+static int ends[TEST_INTERVALS];
+static unsigned char present[TEST_INTERVALS];
+
+struct walk {
+    long count;
+    int last_start;
+    int last_end;
+    int sorted;
+};
+
+static void visit(int start, int end, void* ctx) {
+    struct walk* walk = (struct walk*)ctx;
+    if (walk->count > 0 && (start < walk->last_start || (start == walk->last_start && end <= walk->last_end))) {
+        walk->sorted = 0;
+    }
+    walk->last_start = start;
+    walk->last_end = end;
+    walk->count++;
+}
+
+// Index of the present interval equal to candidate i, -1 if there is none
+static int find_present(int i) {
+    int j;
+    for (j = 0; j < TEST_INTERVALS; j++) {
+        if (present[j] && starts[j] == starts[i] && ends[j] == ends[i]) {
+            return j;
+        }
+    }
+    return -1;
+}
+
+// Returns the height of the subtree, or -1 if an invariant is broken in it
+static int check_node(const struct itree_node* node) {
+    int left, right, max_end;
+    if (node == NULL) {
+        return 0;
+    }
+    left = check_node(node->left);
+    right = check_node(node->right);
+    if (left < 0 || right < 0 || left - right > 1 || right - left > 1) {
+        return -1;
+    }
+    max_end = node->end;
+    if (node->left != NULL && node->left->max_end > max_end) {
+        max_end = node->left->max_end;
+    }
+    if (node->right != NULL && node->right->max_end > max_end) {
+        max_end = node->right->max_end;
+    }
+    if (node->max_end != max_end || node->height != 1 + (left > right ? left : right)) {
+        return -1;
+    }
+    return node->height;
+}
+
+int main(void) {
+    struct itree tree;
+    unsigned long long seed = 42;
+    long expected = 0, i;
+    int k;
+
+    for (k = 0; k < TEST_INTERVALS; k++) {
+        starts[k] = k % 7 == 0 && k > 0 ? starts[k - 7] : (int)(test_rand(&seed) % 2000) - 1000;
+        ends[k] = starts[k] + (int)(test_rand(&seed) % 100);
+    }
+
+    itree_init(&tree);
+    for (i = 0; i < TEST_OPS; i++) {
+        unsigned long long r = test_rand(&seed);
+        int c = (int)((r >> 8) % TEST_INTERVALS);
+        int j = find_present(c);
+        switch (r % 4) {
+        case 0:
+        case 1:
+            CHECK(itree_insert(&tree, starts[c], ends[c]) == (j >= 0 ? DS_EXISTS : DS_OK));
+            if (j < 0) {
+                present[c] = 1;
+                expected++;
+            }
+            break;
+        case 2:
+            CHECK(itree_delete(&tree, starts[c], ends[c]) == (j >= 0 ? DS_OK : DS_NOT_FOUND));
+            if (j >= 0) {
+                present[j] = 0;
+                expected--;
+            }
+            break;
+        default: {
+            // Mostly stabbing queries, sometimes a range
+            int lo = (int)((r >> 24) % 2200) - 1100;
+            int hi = lo + ((r >> 40) % 3 != 0 ? 0 : (int)((r >> 44) % 200));
+            struct walk walk = {0, 0, 0, 1};
+            long overlapping = 0;
+            for (k = 0; k < TEST_INTERVALS; k++) {
+                overlapping += present[k] && starts[k] <= hi && ends[k] >= lo;
+            }
+            CHECK(itree_overlap(&tree, lo, hi, visit, &walk) == overlapping);
+            CHECK(walk.count == overlapping);
+            CHECK(walk.sorted);
+            break;
+        }
+        }
+        CHECK(itree_count(&tree) == expected);
+        if (i % 1000 == 0) {
+            CHECK(check_node(tree.root) >= 0);
+        }
+    }
+
+    CHECK(check_node(tree.root) >= 0);
+    CHECK(itree_insert(&tree, 5, 4) == DS_BAD_POSITION);
+    itree_free(&tree);
+    CHECK(itree_count(&tree) == 0);
+    return test_done("test_itree");
+}
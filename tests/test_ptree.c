@@ -0,0 +1,194 @@
+// Model test for the persistent tree: a set of versions is kept, each with
+// the count of every value it should hold, and new versions are built from
+// random ones by inserts and deletes, duplicates included. Every version must
+// stay exactly as it was built while newer ones share its nodes and older
+// ones are released. Chains of sorted inserts, much deeper than the walk
+// stack kept inline, must be walked and released without recursion. Then
+// threads publish versions of one shared tree while readers check that their
+// snapshots do not change under them.
+#include <pthread.h>
+#include <string.h>
+#include "ds_ptree.h"
+
+#include "test.h"
+
+#define TEST_VALUES 300
+#define TEST_VERSIONS 16
+#define TEST_OPS 20000
+#define TEST_CHAIN 5000
+#define TEST_WRITERS 2
+#define TEST_READERS 2
+#define TEST_THREAD_OPS 20000
+
+static struct ptree_node* versions[TEST_VERSIONS];
+static int counts[TEST_VERSIONS][TEST_VALUES];
+
+struct walk {
+    int last;
+    long count;
+    int sorted;
+};
+
+static void visit(int val, void* ctx) {
+    struct walk* walk = (struct walk*)ctx;
+    if (walk->count > 0 && val < walk->last) {
+        walk->sorted = 0;
+    }
+    walk->last = val;
+    walk->count++;
+}
+
+// Sorted walk of a version, returns the number of values or -1 if out of order
+static long walk_version(const struct ptree_node* version) {
+    struct walk walk = {0, 0, 1};
+    CHECK(ptree_inorder(version, visit, &walk) == DS_OK);
+    return walk.sorted ? walk.count : -1;
+}
+
+// Version v must hold exactly counts[v][x] copies of every value x
+static void check_version(int v) {
+    long expected = 0;
+    int x;
+    for (x = 0; x < TEST_VALUES; x++) {
+        CHECK(ptree_search(versions[v], x) == (counts[v][x] > 0));
+        expected += counts[v][x];
+    }
+    CHECK(walk_version(versions[v]) == expected);
+    CHECK(ptree_count_nodes(versions[v]) == expected);
+}
+
+// Chain of count values inserted in ascending or descending order
+static struct ptree_node* chain(int count, int descending) {
+    struct ptree_node *version = NULL, *next = NULL;
+    int i;
+    for (i = 0; i < count; i++) {
+        CHECK(ptree_insert(version, descending ? count - 1 - i : i, &next) == DS_OK);
+        ptree_release(version);
+        version = next;
+    }
+    return version;
+}
+
+static struct ptree shared;
+static int writers_done;
+
+struct worker {
+    pthread_t thread;
+    int index;
+    unsigned char present[TEST_VALUES];
+};
+
+// Each writer owns the values equal to its index modulo TEST_WRITERS
+static void* writer_run(void* arg) {
+    struct worker* w = (struct worker*)arg;
+    unsigned long long seed = 0x9E3779B97F4A7C15ULL * (unsigned long long)(w->index + 1);
+    int i;
+    for (i = 0; i < TEST_THREAD_OPS; i++) {
+        unsigned long long r = test_rand(&seed);
+        int x = (int)((r >> 8) % (TEST_VALUES / TEST_WRITERS)) * TEST_WRITERS + w->index;
+        if (r % 2 == 0) {
+            if (!w->present[x]) {
+                CHECK(ptree_add(&shared, x) == DS_OK);
+                w->present[x] = 1;
+            }
+        } else {
+            CHECK(ptree_remove(&shared, x) == (w->present[x] ? DS_OK : DS_NOT_FOUND));
+            w->present[x] = 0;
+        }
+    }
+    return NULL;
+}
+
+static void* reader_run(void* arg) {
+    (void)arg;
+    while (!__atomic_load_n(&writers_done, __ATOMIC_ACQUIRE)) {
+        struct ptree_node* snapshot = ptree_snapshot(&shared);
+        long count = walk_version(snapshot);
+        CHECK(count >= 0);
+        CHECK(ptree_count_nodes(snapshot) == count);
+        CHECK(walk_version(snapshot) == count);
+        ptree_release(snapshot);
+    }
+    return NULL;
+}
+
+int main(void) {
+    struct worker writers[TEST_WRITERS], readers[TEST_READERS];
+    struct ptree_node *version, *next = NULL;
+    unsigned long long seed = 42;
+    long i;
+    int v, x;
+
+    for (i = 0; i < TEST_OPS; i++) {
+        unsigned long long r = test_rand(&seed);
+        int from = (int)((r >> 8) % TEST_VERSIONS);
+        int to = (int)((r >> 16) % TEST_VERSIONS);
+        x = (int)((r >> 24) % TEST_VALUES);
+        if (r % 3 != 0) {
+            CHECK(ptree_insert(versions[from], x, &next) == DS_OK);
+        } else {
+            int status = ptree_delete(versions[from], x, &next);
+            CHECK(status == (counts[from][x] > 0 ? DS_OK : DS_NOT_FOUND));
+            if (status != DS_OK) {
+                continue;
+            }
+        }
+        // The new version replaces one that may be the one it was built from
+        if (to != from) {
+            memcpy(counts[to], counts[from], sizeof(counts[to]));
+        }
+        counts[to][x] += r % 3 != 0 ? 1 : -1;
+        ptree_release(versions[to]);
+        versions[to] = next;
+        if (i % 500 == 0) {
+            for (v = 0; v < TEST_VERSIONS; v++) {
+                check_version(v);
+            }
+        }
+    }
+    for (v = 0; v < TEST_VERSIONS; v++) {
+        check_version(v);
+        ptree_release(versions[v]);
+    }
+
+    // Deep chains: ascending ones lean right, descending ones left
+    version = chain(TEST_CHAIN, 0);
+    CHECK(walk_version(version) == TEST_CHAIN);
+    CHECK(ptree_count_nodes(version) == TEST_CHAIN);
+    CHECK(ptree_search(version, TEST_CHAIN - 1));
+    ptree_release(version);
+    version = chain(TEST_CHAIN, 1);
+    CHECK(walk_version(version) == TEST_CHAIN);
+    CHECK(ptree_count_nodes(version) == TEST_CHAIN);
+    CHECK(ptree_delete(version, 0, &next) == DS_OK);
+    CHECK(walk_version(next) == TEST_CHAIN - 1);
+    CHECK(walk_version(version) == TEST_CHAIN);
+    ptree_release(version);
+    CHECK(ptree_count_nodes(next) == TEST_CHAIN - 1);
+    ptree_release(next);
+
+    ptree_init(&shared);
+    for (i = 0; i < TEST_WRITERS; i++) {
+        writers[i].index = (int)i;
+        memset(writers[i].present, 0, sizeof(writers[i].present));
+        pthread_create(&writers[i].thread, NULL, writer_run, &writers[i]);
+    }
+    for (i = 0; i < TEST_READERS; i++) {
+        pthread_create(&readers[i].thread, NULL, reader_run, &readers[i]);
+    }
+    for (i = 0; i < TEST_WRITERS; i++) {
+        pthread_join(writers[i].thread, NULL);
+    }
+    __atomic_store_n(&writers_done, 1, __ATOMIC_RELEASE);
+    for (i = 0; i < TEST_READERS; i++) {
+        pthread_join(readers[i].thread, NULL);
+    }
+    // The last version holds what every writer left in
+    version = ptree_snapshot(&shared);
+    for (x = 0; x < TEST_VALUES; x++) {
+        CHECK(ptree_search(version, x) == writers[x % TEST_WRITERS].present[x]);
+    }
+    ptree_release(version);
+    ptree_destroy(&shared);
+    return test_done("test_ptree");
+}
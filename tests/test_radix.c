@@ -0,0 +1,189 @@
+// Model test for the radix tree: random inserts, deletes, searches and
+// ordered queries are checked against a sorted array of candidate keys with
+// a flag for the ones that should be in the tree. The candidates are shaped
+// so that one node has 256 children, one about 40 and the root more than 16,
+// plus random keys and the extremes of int, so every node type is grown into
+// and shrunk back out of. A walk over the nodes checks which types are used.
+#include <limits.h>
+#include "ds_radix.h"
+
+#include "test.h"
+
+#define TEST_RANDOM_KEYS 2000
+#define TEST_MAX_KEYS 4096
+#define TEST_OPS 200000
+
+static int keys[TEST_MAX_KEYS];
+static unsigned char present[TEST_MAX_KEYS];
+static int key_count;
+
+static int compare_int(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+// Index of the first candidate >= key, key_count if there is none
+static int first_at_least(int key) {
+    int lo = 0, hi = key_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (keys[mid] < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// The present candidate at or after index i, -1 if there is none
+static int next_present(int i) {
+    for (; i < key_count; i++) {
+        if (present[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Largest node type in use below node at the given level (3 is the leaves)
+static int largest_type(const void* node, int level) {
+    const struct radix_node* inner = (const struct radix_node*)node;
+    int largest, b;
+    if (node == NULL || level == 3) {
+        return -1;
+    }
+    largest = inner->type;
+    for (b = 0; b < 256; b++) {
+        const void* child = NULL;
+        if (inner->type == RADIX_NODE4 && b < inner->count) {
+            child = ((const struct radix_node4*)node)->child[b];
+        } else if (inner->type == RADIX_NODE16 && b < inner->count) {
+            child = ((const struct radix_node16*)node)->child[b];
+        } else if (inner->type == RADIX_NODE48 && ((const struct radix_node48*)node)->index[b] != 0) {
+            child = ((const struct radix_node48*)node)->child[((const struct radix_node48*)node)->index[b] - 1];
+        } else if (inner->type == RADIX_NODE256) {
+            child = ((const struct radix_node256*)node)->child[b];
+        }
+        if (child != NULL) {
+            int type = largest_type(child, level + 1);
+            largest = type > largest ? type : largest;
+        }
+    }
+    return largest;
+}
+
+struct walk {
+    int last;
+    long count;
+    int sorted;
+};
+
+static void visit(int val, void* ctx) {
+    struct walk* walk = (struct walk*)ctx;
+    if (walk->count > 0 && val <= walk->last) {
+        walk->sorted = 0;
+    }
+    walk->last = val;
+    walk->count++;
+}
+
+static void check_order(const struct radix_tree* tree, long expected) {
+    struct walk walk = {0, 0, 1};
+    radix_inorder(tree, visit, &walk);
+    CHECK(walk.sorted);
+    CHECK(walk.count == expected);
+}
+
+int main(void) {
+    struct radix_tree tree;
+    unsigned long long seed = 42;
+    long expected = 0, i;
+    int k, n = 0, out = 0, j;
+
+    for (k = 0; k < 300; k++) {
+        keys[n++] = k << 8;                 // 256 children below one node, and then some
+    }
+    for (k = 0; k < 40; k++) {
+        keys[n++] = (k << 16) + 7;          // about 40 below one node
+    }
+    for (k = -10; k < 10; k++) {
+        keys[n++] = k * (1 << 24) + 5;      // 20 below the root, across the sign
+    }
+    for (k = 0; k < TEST_RANDOM_KEYS; k++) {
+        keys[n++] = (int)(unsigned)test_rand(&seed);
+    }
+    keys[n++] = INT_MIN;
+    keys[n++] = INT_MAX;
+    keys[n++] = -1;
+    keys[n++] = 0;
+    qsort(keys, (size_t)n, sizeof(int), compare_int);
+    for (k = 1; k < n; k++) {
+        if (keys[k] != keys[key_count]) {
+            keys[++key_count] = keys[k];
+        }
+    }
+    key_count++;
+
+    radix_init(&tree);
+    for (i = 0; i < TEST_OPS; i++) {
+        unsigned long long r = test_rand(&seed);
+        int c = (int)((r >> 8) % (unsigned)key_count);
+        // Around the candidates as well, so queries also start between them
+        long long near = (long long)keys[c] + (long long)((r >> 40) % 3) - 1;
+        int probe = near < INT_MIN ? INT_MIN : near > INT_MAX ? INT_MAX : (int)near;
+        switch (r % 5) {
+        case 0:
+        case 1:
+            CHECK(radix_insert(&tree, keys[c]) == (present[c] ? DS_EXISTS : DS_OK));
+            expected += !present[c];
+            present[c] = 1;
+            break;
+        case 2:
+            CHECK(radix_delete(&tree, keys[c]) == (present[c] ? DS_OK : DS_NOT_FOUND));
+            expected -= present[c];
+            present[c] = 0;
+            break;
+        case 3:
+            j = first_at_least(probe);
+            CHECK(radix_search(&tree, probe) == (j < key_count && keys[j] == probe && present[j]));
+            j = next_present(j);
+            CHECK(radix_lower_bound(&tree, probe, &out) == (j >= 0 ? DS_OK : DS_NOT_FOUND));
+            CHECK(j < 0 || out == keys[j]);
+            break;
+        default:
+            j = probe == INT_MAX ? -1 : next_present(first_at_least(probe + 1));
+            CHECK(radix_successor(&tree, probe, &out) == (j >= 0 ? DS_OK : DS_NOT_FOUND));
+            CHECK(j < 0 || out == keys[j]);
+            break;
+        }
+        CHECK(radix_count(&tree) == expected);
+        if (i % 10000 == 0) {
+            check_order(&tree, expected);
+        }
+    }
+
+    // Every candidate in: the 256-child node must exist
+    for (k = 0; k < key_count; k++) {
+        radix_insert(&tree, keys[k]);
+        present[k] = 1;
+    }
+    CHECK(radix_count(&tree) == key_count);
+    CHECK(largest_type(tree.root, 0) == RADIX_NODE256);
+    check_order(&tree, key_count);
+
+    // Down to the 3 smallest keys: every node must have shrunk back to 4
+    for (k = key_count - 1; k >= 3; k--) {
+        CHECK(radix_delete(&tree, keys[k]) == DS_OK);
+    }
+    CHECK(radix_count(&tree) == 3);
+    CHECK(largest_type(tree.root, 0) == RADIX_NODE4);
+    check_order(&tree, 3);
+    for (k = 0; k < 3; k++) {
+        CHECK(radix_delete(&tree, keys[k]) == DS_OK);
+    }
+    CHECK(tree.root == NULL);
+
+    radix_free(&tree);
+    return test_done("test_radix");
+}
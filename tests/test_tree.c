@@ -0,0 +1,127 @@
+// Model test for the binary search tree: random inserts and deletes, with
+// and without an arena, are checked against a count of every value, and the
+// tree then goes through a snapshot. The snapshot is loaded into an arena
+// that is in use, so the nodes its newest chunk had not handed out must be
+// recycled, and a truncated snapshot must fail without leaking.
+#include <stdio.h>
+#include "ds_tree.h"
+
+#include "test.h"
+
+#define TEST_VALUES 500
+#define TEST_OPS 100000
+#define TEST_SNAPSHOT "test_tree.bin"
+
+static int counts[TEST_VALUES];
+
+struct walk {
+    int last;
+    long count;
+    int sorted;
+};
+
+static void visit(int val, void* ctx) {
+    struct walk* walk = (struct walk*)ctx;
+    if (walk->count > 0 && val < walk->last) {
+        walk->sorted = 0;
+    }
+    walk->last = val;
+    walk->count++;
+}
+
+// The tree must hold exactly counts[v] copies of every value v, in order
+static void check_tree(struct tree_node* root) {
+    struct walk walk = {0, 0, 1};
+    long expected = 0;
+    int val;
+    for (val = 0; val < TEST_VALUES; val++) {
+        CHECK(tree_search(root, val) == (counts[val] > 0));
+        expected += counts[val];
+    }
+    tree_inorder(root, visit, &walk);
+    CHECK(walk.sorted);
+    CHECK(walk.count == expected);
+    CHECK(tree_count_nodes(root) == (uint32_t)expected);
+}
+
+static long free_list_length(const struct tree_arena* arena) {
+    const struct tree_node* node;
+    long length = 0;
+    for (node = arena->free_list; node != NULL; node = node->right) {
+        length++;
+    }
+    return length;
+}
+
+// Inserts and deletes through the arena, or through malloc when arena is NULL
+static struct tree_node* churn(struct tree_node* root, struct tree_arena* arena, unsigned long long* seed) {
+    long i;
+    for (i = 0; i < TEST_OPS; i++) {
+        unsigned long long r = test_rand(seed);
+        int val = (int)((r >> 8) % TEST_VALUES);
+        if (r % 2 == 0) {
+            root = arena != NULL ? tree_arena_insert(root, arena, val) : tree_insert(root, val);
+            counts[val]++;
+        } else {
+            CHECK(tree_delete(&root, arena, val) == (counts[val] > 0 ? DS_OK : DS_NOT_FOUND));
+            counts[val] -= counts[val] > 0;
+        }
+        if (i % 5000 == 0) {
+            check_tree(root);
+        }
+    }
+    check_tree(root);
+    return root;
+}
+
+int main(void) {
+    struct tree_arena arena, target;
+    struct tree_node *root = NULL, *loaded = NULL;
+    unsigned long long seed = 42;
+    long recycled;
+    int i, val;
+    FILE* fp;
+
+    root = churn(NULL, NULL, &seed);
+    tree_free(root);
+
+    for (val = 0; val < TEST_VALUES; val++) {
+        counts[val] = 0;
+    }
+    tree_arena_init(&arena);
+    root = churn(NULL, &arena, &seed);
+    CHECK(tree_save(root, TEST_SNAPSHOT) == 0);
+
+    // The target arena's first chunk is barely used when the snapshot arrives
+    tree_arena_init(&target);
+    loaded = tree_arena_insert(NULL, &target, 0);
+    CHECK(tree_arena_load(TEST_SNAPSHOT, &target, &loaded) == 0);
+    recycled = free_list_length(&target);
+    CHECK(recycled > 0);
+    check_tree(loaded);
+    for (i = 0; i < 1000; i++) {
+        val = (int)(test_rand(&seed) % TEST_VALUES);
+        loaded = tree_arena_insert(loaded, &target, val);
+        counts[val]++;
+    }
+    check_tree(loaded);
+    CHECK(free_list_length(&target) == 0);
+    tree_arena_destroy(&target);
+    tree_arena_destroy(&arena);
+
+    // A snapshot cut short fails to load and leaves nothing behind: it
+    // announces 1000 values and holds none
+    fp = fopen(TEST_SNAPSHOT, "wb");
+    CHECK(fp != NULL);
+    if (fp != NULL) {
+        uint32_t count = 1000;
+        fwrite("BST1", 1, 4, fp);
+        fwrite(&count, sizeof(count), 1, fp);
+        fclose(fp);
+    }
+    tree_arena_init(&target);
+    CHECK(tree_arena_load(TEST_SNAPSHOT, &target, &loaded) != 0);
+    tree_arena_destroy(&target);
+    remove(TEST_SNAPSHOT);
+    return test_done("test_tree");
+}
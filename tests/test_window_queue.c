@@ -0,0 +1,92 @@
+// Model test for the window queue: random insertions, supressions and
+// expiries are checked against a plain array of every value pushed, where the
+// window is the slice from the oldest value still in it. Count windows, time
+// windows, both bounds at once and no bound at all are run, with runs of
+// equal values and of rising and falling values so the deques fill up, and
+// enough values at once that the rings must grow.
+#include "ds_queue.h"
+
+#include "test.h"
+
+#define TEST_OPS 100000
+
+static int values[TEST_OPS];
+static long stamps[TEST_OPS];
+
+// Check count, minimum and maximum against the slice [first, next)
+static void check_window(const struct window_queue* w, long first, long next) {
+    int min, max, x;
+    long i;
+    CHECK(window_queue_count(w) == next - first);
+    if (first == next) {
+        CHECK(window_queue_min(w, &x) == DS_EMPTY);
+        CHECK(window_queue_max(w, &x) == DS_EMPTY);
+        return;
+    }
+    min = max = values[first];
+    for (i = first + 1; i < next; i++) {
+        min = values[i] < min ? values[i] : min;
+        max = values[i] > max ? values[i] : max;
+    }
+    CHECK(window_queue_min(w, &x) == DS_OK && x == min);
+    CHECK(window_queue_max(w, &x) == DS_OK && x == max);
+}
+
+static void run(long limit, long span, unsigned long long* seed) {
+    struct window_queue w;
+    long first = 0, next = 0, stamp = 0, i;
+    int x = 0;
+
+    CHECK(window_queue_init(&w, limit, span) == DS_OK);
+    for (i = 0; i < TEST_OPS; i++) {
+        unsigned long long r = test_rand(seed);
+        if (r % 8 == 0) {
+            // Out of the front, in the order pushed
+            CHECK(window_queue_supression(&w, &x) == (first < next ? DS_OK : DS_EMPTY));
+            if (first < next) {
+                CHECK(x == values[first]);
+                first++;
+            }
+        } else if (r % 8 == 1 && span > 0) {
+            long now = stamp + (long)((r >> 8) % (unsigned long long)span);
+            long expired = 0;
+            while (first < next && stamps[first] <= now - span) {
+                first++;
+                expired++;
+            }
+            CHECK(window_queue_expire(&w, now) == expired);
+            stamp = now;
+        } else {
+            // Mostly a small step from the last value, so runs rise, fall and repeat
+            x = (r >> 16) % 4 == 0 ? (int)((r >> 20) % 1000) - 500 : x + (int)((r >> 24) % 5) - 2;
+            stamp += (long)((r >> 32) % 3);
+            values[next] = x;
+            stamps[next] = stamp;
+            next++;
+            if (limit > 0 && next - first > limit) {
+                first = next - limit;
+            }
+            while (span > 0 && stamps[first] <= stamp - span) {
+                first++;
+            }
+            CHECK(window_queue_insertion(&w, x, stamp) == DS_OK);
+        }
+        // The scan is as long as the window, so long windows are checked less often
+        if (next - first <= 1000 || i % 1000 == 0) {
+            check_window(&w, first, next);
+        }
+    }
+
+    window_queue_free(&w);
+    CHECK(window_queue_count(&w) == 0);
+}
+
+int main(void) {
+    unsigned long long seed = 42;
+    run(50, 0, &seed);      // count window
+    run(0, 100, &seed);     // time window, about 70 values
+    run(30, 40, &seed);     // both, whichever is tighter
+    run(0, 0, &seed);       // no bound: only supressions take values out
+    run(1, 0, &seed);       // a single value
+    return test_done("test_window_queue");
+}
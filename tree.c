@@ -1,108 +1,283 @@
-#include <stdio.h>
-#include <stdlib.h>
-
-// Define a structure for a tree node
-struct Node {
-    int data;
-    struct Node* left;
-    struct Node* right;
-};
-
-// Preorder traversal function NLR
-void preorder(struct Node* root) {
-    if (root != NULL) {
-        printf("%d ", root->data);  // Visit the root
-        preorder(root->left);      // Traverse the left subtree
-        preorder(root->right);     // Traverse the right subtree
-    }
-}
-
-// Inorder traversal function LNR
-void inorder(struct Node* root) {
-    if (root != NULL) {
-        inorder(root->left);      // Traverse the left subtree
-        printf("%d ", root->data);  // Visit the root
-        inorder(root->right);     // Traverse the right subtree
-    }
-} 
-// Postorder traversal function LRN
-void postorder(struct Node* root) {
-    if (root != NULL) {
-        postorder(root->left);      // Traverse the left subtree
-        postorder(root->right);     // Traverse the right subtree
-        printf("%d ", root->data);  // Visit the root
-    }
-}
-// Function to search for a value in a binary search tree
-void search(struct Node* root, int val) {
-    if (root == NULL) {
-        printf("Value not found\n");
-        return;
-    }
-    if (root->data == val) {
-        printf("%d Value found\n", val);
-        return;
-    }
-    else if (val < root->data) {
-        search(root->left, val);  // Continue searching in the left subtree
-    }
-    else {
-        search(root->right, val);  // Continue searching in the right subtree
-    }
-}
-
-// Function to insert a value in a binary search tree
-struct Node* insert(struct Node* root, int val) {
-    if (root == NULL) {
-        root = (struct Node*)malloc(sizeof(struct Node));
-        root->data = val;
-        root->left = NULL;
-        root->right = NULL;
-        return root;
-    }
-    if (val < root->data) {
-        root->left = insert(root->left, val);  // Update left child
-    } else {
-        root->right = insert(root->right, val);  // Update right child
-    }
-    return root;
-}
-
-int main() {
-    struct Node* root = NULL;
-    int choice, val;
-    while (1) {
-        printf("\n*1. Insert\n*2. Search\n*3. Preorder\n*4. Inorder\n*5. Postorder\n*6. Exit\n");
-        printf("Enter your choice: ");
-        scanf("%d", &choice);
-        switch (choice) {
-            case 1:
-                printf("Enter the value to insert: ");
-                scanf("%d", &val);
-                root = insert(root, val);
-                break;
-            case 2:
-                printf("Enter the value to search: ");
-                scanf("%d", &val);
-                search(root, val);
-                break;
-            case 3:
-                printf("Preorder traversal: ");
-                preorder(root);
-                break;
-            case 4:
-                printf("Inorder traversal: ");
-                inorder(root);
-                break;
-            case 5:
-                printf("Postorder traversal: ");
-                postorder(root);
-                break;
-            case 6:
-                exit(0);
-            default:
-                printf("Invalid choice\n");
-        }
-    }
-    return 0;
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ds_tree.h"
+#include "ds_mapped_tree.h"
+#include "batch_io.h"
+
+static void print_value(int val, void* ctx) {
+    (void)ctx;
+    printf("%d ", val);
+}
+
+// Function to read count values and search for all of them in one batch
+// Prints one line per value, in the order given; returns 0, or 1 on bad input
+static int search_many(struct tree_node* root, struct batch_in* in, int count, int verbose) {
+    int* keys;
+    uint8_t* found;
+    int i;
+    if (count < 0) {
+        return 1;
+    }
+    // + 1: a count of 0 is not an error; calloc, so no key is ever read uninitialised
+    keys = (int*)calloc((size_t)count + 1, sizeof(int));
+    found = (uint8_t*)malloc((size_t)count + 1);
+    if (keys == NULL || found == NULL) {
+        free(keys);
+        free(found);
+        return 1;
+    }
+    for (i = 0; i < count; i++) {
+        if ((in != NULL ? batch_next_int(in, &keys[i]) : scanf("%d", &keys[i])) != 1) {
+            free(keys);
+            free(found);
+            return 1;
+        }
+    }
+    tree_search_batch(root, keys, count, found);
+    for (i = 0; i < count; i++) {
+        if (verbose && found[i])
+            printf("%d Value found\n", keys[i]);
+        else if (verbose)
+            printf("%d Value not found\n", keys[i]);
+        else
+            fputs(found[i] ? "found\n" : "not found\n", stdout);
+    }
+    free(keys);
+    free(found);
+    return 0;
+}
+
+// Run an operation log without prompts, options use the menu numbers
+// Exit keeps the number it had when logs were introduced and new options come
+// after it, so existing logs keep meaning the same thing
+// Searches go through a filter sized for false-positive rate fpr, 0 for none
+int run_batch(const char* log, double fpr) {
+    struct batch_in in;
+    struct ds_bloom filter;
+    struct tree_arena arena, loaded;
+    struct tree_node* root = NULL;
+    struct tree_node* loaded_root;
+    struct mapped_tree mapped = {NULL, 0, NULL, 0, 0};
+    int choice, val, found, status = 0;
+    int filtered = fpr > 0.0 && ds_bloom_init(&filter, 1024, fpr) == DS_OK;
+    long n = 0;
+    char path[256];
+
+    if (batch_open(&in, log) != 0) {
+        fprintf(stderr, "Cannot open %s\n", log);
+        if (filtered)
+            ds_bloom_free(&filter);
+        return 1;
+    }
+    tree_arena_init(&arena);
+    while (status == 0 && batch_next_int(&in, &choice) == 1 && choice != 12) {
+        n++;
+        switch (choice) {
+            case 1:
+            case 2:
+            case 10:
+            case 14:
+                if (batch_next_int(&in, &val) != 1) {
+                    status = 1;
+                } else if (choice == 1) {
+                    root = filtered ? tree_insert_filtered(root, &arena, &filter, val) : tree_arena_insert(root, &arena, val);
+                } else if (choice == 14) {
+                    // Every value in the tree was added to the filter, so it can be removed
+                    if (tree_delete(&root, &arena, val) == DS_OK && filtered)
+                        ds_bloom_remove(&filter, val);
+                } else if (choice == 2) {
+                    found = filtered ? tree_search_filtered(root, &filter, val) : tree_search(root, val);
+                    fputs(found ? "found\n" : "not found\n", stdout);
+                } else {
+                    found = mapped_tree_search(&mapped, val);
+                    fputs(found ? "found\n" : "not found\n", stdout);
+                }
+                break;
+            case 3:
+                tree_preorder(root, print_value, NULL);
+                putchar('\n');
+                break;
+            case 4:
+                tree_inorder(root, print_value, NULL);
+                putchar('\n');
+                break;
+            case 5:
+                tree_postorder(root, print_value, NULL);
+                putchar('\n');
+                break;
+            case 6:
+            case 7:
+            case 8:
+            case 9:
+                if (batch_next_word(&in, path, sizeof(path)) != 1) {
+                    status = 1;
+                } else if (choice == 6) {
+                    if (tree_save(root, path) != 0)
+                        fprintf(stderr, "File error: %s\n", path);
+                } else if (choice == 7) {
+                    tree_arena_init(&loaded);
+                    if (tree_arena_load(path, &loaded, &loaded_root) == 0) {
+                        tree_arena_destroy(&arena);
+                        arena = loaded;
+                        root = loaded_root;
+                        if (filtered)
+                            tree_fill_filter(root, &filter);
+                    } else {
+                        tree_arena_destroy(&loaded);  // Whatever was read before the error
+                        fprintf(stderr, "File error: %s\n", path);
+                    }
+                } else if (choice == 8) {
+                    if (mapped_tree_write(root, path) != 0)
+                        fprintf(stderr, "File error: %s\n", path);
+                } else {
+                    mapped_tree_close(&mapped);
+                    if (mapped_tree_open(&mapped, path) != 0)
+                        fprintf(stderr, "File error: %s\n", path);
+                }
+                break;
+            case 11:
+                mapped_tree_inorder(&mapped, print_value, NULL);
+                putchar('\n');
+                break;
+            case 13:
+                if (batch_next_int(&in, &val) != 1 || search_many(root, &in, val, 0) != 0)
+                    status = 1;
+                break;
+            default:
+                status = 1;
+        }
+    }
+    if (status != 0)
+        fprintf(stderr, "Invalid operation %ld\n", n);
+    mapped_tree_close(&mapped);
+    tree_arena_destroy(&arena);
+    batch_close(&in);
+    DS_EXPORT(tree_stats);
+    if (filtered) {
+        fprintf(stderr, "filter: %llu queries, %llu rejected, %llu false positives\n",
+                (unsigned long long)filter.queries, (unsigned long long)filter.rejected,
+                (unsigned long long)filter.false_positives);
+        ds_bloom_free(&filter);
+    }
+    return status;
+}
+
+int main(int argc, char* argv[]) {
+    struct tree_arena arena, loaded;
+    struct tree_node* root = NULL;
+    struct tree_node* loaded_root;
+    struct mapped_tree mapped = {NULL, 0, NULL, 0, 0};
+    int choice, val;
+    char path[256];
+
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0) {
+        return run_batch(argc > 2 ? argv[2] : NULL, argc > 3 ? atof(argv[3]) : 0.0);
+    }
+    tree_arena_init(&arena);
+    while (1) {
+        printf("\n*1. Insert\n*2. Search\n*3. Preorder\n*4. Inorder\n*5. Postorder\n*6. Save\n*7. Load\n*8. Export mapped file\n*9. Open mapped file\n*10. Search mapped file\n*11. Inorder mapped file\n*12. Exit\n*13. Search several values\n*14. Delete\n");
+        printf("Enter your choice: ");
+        scanf("%d", &choice);
+        switch (choice) {
+            case 1:
+                printf("Enter the value to insert: ");
+                scanf("%d", &val);
+                root = tree_arena_insert(root, &arena, val);
+                break;
+            case 2:
+                printf("Enter the value to search: ");
+                scanf("%d", &val);
+                if (tree_search(root, val))
+                    printf("%d Value found\n", val);
+                else
+                    printf("Value not found\n");
+                break;
+            case 3:
+                printf("Preorder traversal: ");
+                tree_preorder(root, print_value, NULL);
+                break;
+            case 4:
+                printf("Inorder traversal: ");
+                tree_inorder(root, print_value, NULL);
+                break;
+            case 5:
+                printf("Postorder traversal: ");
+                tree_postorder(root, print_value, NULL);
+                break;
+            case 6:
+                printf("Enter the file name: ");
+                scanf("%255s", path);
+                if (tree_save(root, path) == 0)
+                    printf("Tree saved to %s\n", path);
+                else
+                    printf("Could not save the tree\n");
+                break;
+            case 7:
+                printf("Enter the file name: ");
+                scanf("%255s", path);
+                tree_arena_init(&loaded);
+                if (tree_arena_load(path, &loaded, &loaded_root) == 0) {
+                    tree_arena_destroy(&arena);  // The old tree goes in one free per chunk
+                    arena = loaded;
+                    root = loaded_root;
+                    printf("Tree loaded from %s\n", path);
+                } else {
+                    tree_arena_destroy(&loaded);  // Whatever was read before the error
+                    printf("Could not load the tree\n");
+                }
+                break;
+            case 8:
+                printf("Enter the file name: ");
+                scanf("%255s", path);
+                if (mapped_tree_write(root, path) == 0)
+                    printf("Mapped tree written to %s\n", path);
+                else
+                    printf("Could not write the mapped tree\n");
+                break;
+            case 9:
+                printf("Enter the file name: ");
+                scanf("%255s", path);
+                mapped_tree_close(&mapped);
+                if (mapped_tree_open(&mapped, path) == 0)
+                    printf("Mapped %u nodes from %s\n", mapped.count, path);
+                else
+                    printf("Could not map %s\n", path);
+                break;
+            case 10:
+                printf("Enter the value to search: ");
+                scanf("%d", &val);
+                if (mapped_tree_search(&mapped, val))
+                    printf("%d Value found\n", val);
+                else
+                    printf("Value not found\n");
+                break;
+            case 11:
+                printf("Mapped inorder traversal: ");
+                if (mapped_tree_inorder(&mapped, print_value, NULL) != 0)
+                    printf("\nMapped file is corrupt\n");
+                break;
+            case 13:
+                printf("Enter how many values, then the values: ");
+                if (scanf("%d", &val) != 1 || search_many(root, NULL, val, 1) != 0)
+                    printf("Invalid values\n");
+                break;
+            case 14:
+                printf("Enter the value to delete: ");
+                scanf("%d", &val);
+                if (tree_delete(&root, &arena, val) == DS_OK)
+                    printf("%d Value deleted\n", val);
+                else
+                    printf("Value not found\n");
+                break;
+            case 12:
+                mapped_tree_close(&mapped);
+                tree_arena_destroy(&arena);
+                DS_EXPORT(tree_stats);
+                exit(0);
+            default:
+                printf("Invalid choice\n");
+        }
+    }
+    return 0;
 }
\ No newline at end of file